@@ -4,5 +4,23 @@
 #include <dtz/chrono.hpp>
 #include <dtz/traits.hpp>
 #include <dtz/format.hpp>
+#include <dtz/fan_out.hpp>
+#include <dtz/zones.hpp>
+#include <dtz/compact_zoned.hpp>
 #include <dtz/parse.hpp>
+#include <dtz/parse_sys.hpp>
+#include <dtz/parse_epoch.hpp>
+#include <dtz/iso_duration.hpp>
+#include <dtz/adaptive_parser.hpp>
+#include <dtz/binary.hpp>
+#include <dtz/bucketer.hpp>
+#include <dtz/views.hpp>
+#include <dtz/recurrence.hpp>
+#include <dtz/business_calendar.hpp>
+#include <dtz/timer_wheel.hpp>
+#include <dtz/histogram.hpp>
+#include <dtz/trace.hpp>
+#include <dtz/timestamp_column.hpp>
+#include <dtz/interval_set.hpp>
+#include <dtz/windowing.hpp>
 // clang-format on
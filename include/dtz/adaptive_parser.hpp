@@ -0,0 +1,275 @@
+#pragma once
+#include "chrono.hpp"
+#include "error.hpp"
+#include "parse.hpp"
+#include "parse_epoch.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace dtz {
+
+enum class timestamp_layout {
+  unknown,
+  date_time,           // Every layout of parse<sys_time>, like "2021-06-01 12:30:00.000".
+  iso_8601,            // "2021-06-01T12:30:00[.fff[fff[fff]]][Z]"
+  epoch_seconds,       // Up to 10 integer digits and an optional fraction like parse_epoch.
+  epoch_milliseconds,  // 11 to 13 integer digits.
+  epoch_microseconds,  // 14 to 16 integer digits.
+  epoch_nanoseconds,   // 17 to 19 integer digits.
+};
+
+namespace internal {
+
+// Parses two digits at p.
+inline constexpr bool parse_pair(const char* p, int& value) noexcept
+{
+  const auto hi = static_cast<unsigned>(p[0] - '0');
+  const auto lo = static_cast<unsigned>(p[1] - '0');
+  value = static_cast<int>(hi * 10 + lo);
+  return hi < 10 && lo < 10;
+}
+
+// Parses "YYYY-MM-DD?HH:MM:SS" with Digits fraction digits and an optional 'Z' at fixed positions.
+template <Duration Duration, char Separator, std::size_t Digits, bool Utc>
+inline constexpr errc parse_fixed(std::string_view str, sys_time<Duration>& result) noexcept
+{
+  constexpr auto size = 19 + (Digits ? Digits + 1 : 0) + (Utc ? 1 : 0);
+  if (str.size() != size) {
+    return errc::invalid_format;
+  }
+  const char* const p = str.data();
+  int yh = 0;
+  int yl = 0;
+  int m = 0;
+  int d = 0;
+  int hv = 0;
+  int mv = 0;
+  int sv = 0;
+  if (!parse_pair(p, yh) || !parse_pair(p + 2, yl) || p[4] != '-') {
+    return errc::invalid_year_format;
+  }
+  if (!parse_pair(p + 5, m) || p[7] != '-') {
+    return errc::invalid_month_format;
+  }
+  if (!parse_pair(p + 8, d) || p[10] != Separator) {
+    return errc::invalid_day_format;
+  }
+  const auto ymd = year{ yh * 100 + yl } / month{ static_cast<unsigned>(m) } / day{ static_cast<unsigned>(d) };
+  if (!ymd.ok()) {
+    return errc::invalid_day_format;
+  }
+  if (!parse_pair(p + 11, hv) || p[13] != ':' || hv > 23) {
+    return errc::invalid_hours_format;
+  }
+  if (!parse_pair(p + 14, mv) || p[16] != ':' || mv > 59) {
+    return errc::invalid_minutes_format;
+  }
+  if (!parse_pair(p + 17, sv) || sv > 60) {
+    return errc::invalid_seconds_format;
+  }
+  auto tp = cast<Duration>(sys_days{ ymd }) + cast<Duration>(hours{ hv } + minutes{ mv } + seconds{ sv });
+  if constexpr (Digits != 0) {
+    if (p[19] != '.') {
+      return errc::invalid_format;
+    }
+    using Fraction = std::conditional_t<Digits == 3, milliseconds, std::conditional_t<Digits == 6, microseconds, nanoseconds>>;
+    typename Fraction::rep fraction = 0;
+    for (std::size_t i = 20; i < 20 + Digits; i++) {
+      const auto digit = static_cast<unsigned>(p[i] - '0');
+      if (digit > 9) {
+        return errc::invalid_subseconds_format;
+      }
+      fraction = fraction * 10 + static_cast<typename Fraction::rep>(digit);
+    }
+    tp += cast<Duration>(Fraction{ fraction });
+  }
+  if constexpr (Utc) {
+    if (p[size - 1] != 'Z') {
+      return errc::invalid_format;
+    }
+  }
+  result = tp;
+  return {};
+}
+
+// Parses the date_time layout with parse<sys_time>.
+template <Duration Duration>
+inline constexpr errc parse_date_time(std::string_view str, sys_time<Duration>& result) noexcept
+{
+  return parse(str, result);
+}
+
+// Parses an epoch number of Unit with MinDigits to MaxDigits integer digits.
+template <Duration Duration, typename Unit, std::size_t MinDigits, std::size_t MaxDigits>
+inline constexpr errc parse_epoch_digits(std::string_view str, sys_time<Duration>& result) noexcept
+{
+  const auto digits = std::min(str.find('.'), str.size()) - (!str.empty() && str.front() == '-' ? 1 : 0);
+  if (digits < MinDigits || digits > MaxDigits) {
+    return errc::invalid_format;
+  }
+  return parse_epoch<Unit>(str, result);
+}
+
+}  // namespace internal
+
+// Parses timestamps of a stream whose layout is not known in advance.
+//
+// The layout is detected on the first value and a parser specialized for it is used for the following
+// values. Civil times with seconds are parsed at fixed positions for their length. A value that the
+// specialized parser rejects is detected again and switches the stream to its layout. Civil times are
+// read as UTC like parse<sys_time>.
+template <Duration Duration = nanoseconds>
+  requires std::ratio_less_equal_v<typename Duration::period, std::ratio<1>>
+class adaptive_parser
+{
+public:
+  using time_point = sys_time<Duration>;
+
+  [[nodiscard]] time_point parse(std::string_view str, std::error_code& ec) noexcept
+  {
+    time_point result{};
+    if (parser_ && parser_(str, result) == errc{}) {
+      hits_++;
+      return result;
+    }
+    misses_++;
+    if (const auto e = detect(str, result); e != errc{}) {
+      ec = std::make_error_code(e);
+      return {};
+    }
+    return result;
+  }
+
+  [[nodiscard]] time_point parse(std::string_view str)
+  {
+    std::error_code ec;
+    const auto result = parse(str, ec);
+    if (ec) {
+      throw std::system_error(ec, "time point parse error for \"" + std::string{ str } + "\"");
+    }
+    return result;
+  }
+
+  // Returns the layout of the last detected value.
+  [[nodiscard]] timestamp_layout layout() const noexcept
+  {
+    return layout_;
+  }
+
+  // Returns the number of values parsed by the specialized parser.
+  [[nodiscard]] std::uint64_t hits() const noexcept
+  {
+    return hits_;
+  }
+
+  // Returns the number of values that needed detection, including invalid values.
+  [[nodiscard]] std::uint64_t misses() const noexcept
+  {
+    return misses_;
+  }
+
+  [[nodiscard]] double hit_rate() const noexcept
+  {
+    const auto total = hits_ + misses_;
+    return total ? static_cast<double>(hits_) / static_cast<double>(total) : 0.0;
+  }
+
+  // Forgets the layout and the counters.
+  void reset() noexcept
+  {
+    *this = {};
+  }
+
+private:
+  using parser = errc (*)(std::string_view, time_point&) noexcept;
+
+  // Chooses the candidate layout by the shape of str and keeps it if str parses.
+  errc detect(std::string_view str, time_point& result) noexcept
+  {
+    auto layout = timestamp_layout::unknown;
+    parser candidate = nullptr;
+    if (str.size() > 10 && str[10] == 'T') {
+      layout = timestamp_layout::iso_8601;
+      candidate = iso_8601(str);
+    } else if (str.size() >= 10 && str[4] == '-') {
+      layout = timestamp_layout::date_time;
+      candidate = date_time(str);
+    } else if (const auto digits = std::min(str.find('.'), str.size()) - (!str.empty() && str.front() == '-' ? 1 : 0); digits > 0) {
+      if (digits <= 10) {
+        layout = timestamp_layout::epoch_seconds;
+        candidate = internal::parse_epoch_digits<Duration, seconds, 1, 10>;
+      } else if (digits <= 13) {
+        layout = timestamp_layout::epoch_milliseconds;
+        candidate = internal::parse_epoch_digits<Duration, milliseconds, 11, 13>;
+      } else if (digits <= 16) {
+        layout = timestamp_layout::epoch_microseconds;
+        candidate = internal::parse_epoch_digits<Duration, microseconds, 14, 16>;
+      } else if (digits <= 19) {
+        layout = timestamp_layout::epoch_nanoseconds;
+        candidate = internal::parse_epoch_digits<Duration, nanoseconds, 17, 19>;
+      }
+    }
+    if (!candidate) {
+      return errc::invalid_format;
+    }
+    if (const auto e = candidate(str, result); e != errc{}) {
+      return e;
+    }
+    layout_ = layout;
+    parser_ = candidate;
+    return {};
+  }
+
+  [[nodiscard]] static parser date_time(std::string_view str) noexcept
+  {
+    switch (str.size()) {
+    case 19:
+      return internal::parse_fixed<Duration, ' ', 0, false>;
+    case 23:
+      return internal::parse_fixed<Duration, ' ', 3, false>;
+    case 26:
+      return internal::parse_fixed<Duration, ' ', 6, false>;
+    case 29:
+      return internal::parse_fixed<Duration, ' ', 9, false>;
+    default:
+      return internal::parse_date_time<Duration>;
+    }
+  }
+
+  [[nodiscard]] static parser iso_8601(std::string_view str) noexcept
+  {
+    switch (str.size()) {
+    case 19:
+      return internal::parse_fixed<Duration, 'T', 0, false>;
+    case 20:
+      return internal::parse_fixed<Duration, 'T', 0, true>;
+    case 23:
+      return internal::parse_fixed<Duration, 'T', 3, false>;
+    case 24:
+      return internal::parse_fixed<Duration, 'T', 3, true>;
+    case 26:
+      return internal::parse_fixed<Duration, 'T', 6, false>;
+    case 27:
+      return internal::parse_fixed<Duration, 'T', 6, true>;
+    case 29:
+      return internal::parse_fixed<Duration, 'T', 9, false>;
+    case 30:
+      return internal::parse_fixed<Duration, 'T', 9, true>;
+    default:
+      return nullptr;
+    }
+  }
+
+  parser parser_ = nullptr;
+  timestamp_layout layout_ = timestamp_layout::unknown;
+  std::uint64_t hits_ = 0;
+  std::uint64_t misses_ = 0;
+};
+
+}  // namespace dtz
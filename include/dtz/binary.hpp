@@ -0,0 +1,491 @@
+#pragma once
+#include "chrono.hpp"
+#include "error.hpp"
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+namespace dtz {
+
+// Durations, time points and local times with an integral representation. They are encoded as the
+// count of their duration, so values round-trip exactly when they are decoded as the same type.
+template <typename T>
+concept BinaryTime = (Duration<T> || TimePointOrLocalTime<T>) && std::integral<typename T::rep>;
+
+namespace internal {
+
+template <BinaryTime T>
+[[nodiscard]] inline constexpr std::uint64_t binary_count(const T& value) noexcept
+{
+  if constexpr (Duration<T>) {
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(value.count()));
+  } else {
+    return static_cast<std::uint64_t>(static_cast<std::int64_t>(value.time_since_epoch().count()));
+  }
+}
+
+template <BinaryTime T>
+[[nodiscard]] inline constexpr T binary_value(std::uint64_t count) noexcept
+{
+  const auto rep = static_cast<typename T::rep>(static_cast<std::int64_t>(count));
+  if constexpr (Duration<T>) {
+    return T{ rep };
+  } else {
+    return T{ typename T::duration{ rep } };
+  }
+}
+
+template <std::unsigned_integral Unsigned>
+inline void store_le(std::byte* out, Unsigned value) noexcept
+{
+  if constexpr (std::endian::native != std::endian::little) {
+    for (std::size_t i = 0; i < sizeof(Unsigned); i++) {
+      out[i] = static_cast<std::byte>(value >> (i * 8));
+    }
+  } else {
+    std::memcpy(out, &value, sizeof(Unsigned));
+  }
+}
+
+template <std::unsigned_integral Unsigned>
+[[nodiscard]] inline Unsigned load_le(const std::byte* in) noexcept
+{
+  Unsigned value = 0;
+  if constexpr (std::endian::native != std::endian::little) {
+    for (std::size_t i = 0; i < sizeof(Unsigned); i++) {
+      value |= static_cast<Unsigned>(static_cast<Unsigned>(in[i]) << (i * 8));
+    }
+  } else {
+    std::memcpy(&value, in, sizeof(Unsigned));
+  }
+  return value;
+}
+
+[[nodiscard]] inline constexpr std::uint64_t zigzag(std::uint64_t value) noexcept
+{
+  return (value << 1) ^ (0 - (value >> 63));
+}
+
+[[nodiscard]] inline constexpr std::uint64_t unzigzag(std::uint64_t value) noexcept
+{
+  return (value >> 1) ^ (0 - (value & 1));
+}
+
+// Writes a LEB128 varint of at most 10 bytes.
+inline std::byte* write_varint(std::byte* out, std::uint64_t value) noexcept
+{
+  while (value >= 0x80) {
+    *out++ = static_cast<std::byte>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<std::byte>(value);
+  return out;
+}
+
+// Reads a LEB128 varint. Returns nullptr if the input ends early or the varint has more than 64 bits.
+[[nodiscard]] inline const std::byte* read_varint(const std::byte* in, const std::byte* end, std::uint64_t& value) noexcept
+{
+  value = 0;
+  for (int shift = 0; in != end && shift < 64; shift += 7) {
+    const auto byte = static_cast<std::uint64_t>(*in++);
+    value |= (byte & 0x7F) << shift;
+    if (byte < 0x80) {
+      return shift == 63 && byte > 1 ? nullptr : in;
+    }
+  }
+  return nullptr;
+}
+
+inline void write_varint(std::vector<std::byte>& out, std::uint64_t value)
+{
+  std::byte buffer[10];
+  out.insert(out.end(), buffer, write_varint(buffer, value));
+}
+
+// Appends the delta-of-delta column of n counts returned by count(i).
+template <typename Count>
+inline void encode_counts(std::size_t n, Count count, std::vector<std::byte>& out)
+{
+  const auto offset = out.size();
+  out.resize(offset + 10 + n * 10);
+  auto cur = write_varint(out.data() + offset, n);
+  if (n == 0) {
+    out.resize(static_cast<std::size_t>(cur - out.data()));
+    return;
+  }
+  std::uint64_t last = count(0);
+  std::uint64_t delta = 0;
+  cur = write_varint(cur, zigzag(last));
+  for (std::size_t i = 1; i < n; i++) {
+    const auto value = count(i);
+    const auto d = value - last;
+    cur = write_varint(cur, zigzag(d - delta));
+    last = value;
+    delta = d;
+  }
+  out.resize(static_cast<std::size_t>(cur - out.data()));
+}
+
+// Decodes a delta-of-delta column and passes every count to set(i, count) after resize(n).
+template <typename Resize, typename Set>
+[[nodiscard]] inline const std::byte* decode_counts(const std::byte* cur, const std::byte* end, Resize resize, Set set)
+{
+  std::uint64_t n = 0;
+  if (cur = read_varint(cur, end, n); !cur || n > static_cast<std::uint64_t>(end - cur)) {
+    return nullptr;
+  }
+  resize(static_cast<std::size_t>(n));
+  if (n == 0) {
+    return cur;
+  }
+  std::uint64_t last = 0;
+  if (cur = read_varint(cur, end, last); !cur) {
+    return nullptr;
+  }
+  last = unzigzag(last);
+  set(0, last);
+  std::uint64_t delta = 0;
+  for (std::size_t i = 1; i < n; i++) {
+    std::uint64_t dod = 0;
+    if (end - cur >= 10) [[likely]] {
+      // Regular series encode most values in one byte.
+      if (const auto byte = static_cast<std::uint64_t>(*cur); byte < 0x80) {
+        dod = byte;
+        cur++;
+      } else {
+        cur = read_varint(cur, end, dod);
+      }
+    } else {
+      cur = read_varint(cur, end, dod);
+    }
+    if (!cur) {
+      return nullptr;
+    }
+    delta += unzigzag(dod);
+    last += delta;
+    set(i, last);
+  }
+  return cur;
+}
+
+}  // namespace internal
+
+// ====================================================================================================================
+// Zone table
+// ====================================================================================================================
+
+// Maps time zones to 16 bit indices in order of first use. Encoded as the number of zones followed by
+// their names, so indices stay valid between processes with different time zone databases.
+class zone_table
+{
+public:
+  // Returns the index of the zone and adds it if it is new. Throws std::length_error for more than
+  // 65536 zones.
+  std::uint16_t add(const time_zone* zone)
+  {
+    if (const auto it = indices_.find(zone); it != indices_.end()) {
+      return it->second;
+    }
+    if (zones_.size() > std::numeric_limits<std::uint16_t>::max()) {
+      throw std::length_error("too many zones in zone table");
+    }
+    const auto index = static_cast<std::uint16_t>(zones_.size());
+    zones_.push_back(zone);
+    indices_.emplace(zone, index);
+    return index;
+  }
+
+  // Returns the zone at index or nullptr if there is none.
+  [[nodiscard]] const time_zone* operator[](std::size_t index) const noexcept
+  {
+    return index < zones_.size() ? zones_[index] : nullptr;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return zones_.size();
+  }
+
+  [[nodiscard]] const std::vector<const time_zone*>& zones() const noexcept
+  {
+    return zones_;
+  }
+
+  void encode(std::vector<std::byte>& out) const
+  {
+    internal::write_varint(out, zones_.size());
+    for (const auto zone : zones_) {
+      const auto name = zone->name();
+      internal::write_varint(out, name.size());
+      const auto data = reinterpret_cast<const std::byte*>(name.data());
+      out.insert(out.end(), data, data + name.size());
+    }
+  }
+
+  // Replaces the table with an encoded one and returns the number of bytes read.
+  std::size_t decode(std::span<const std::byte> in, std::error_code& ec)
+  {
+    ec.clear();
+    zones_.clear();
+    indices_.clear();
+    const auto end = in.data() + in.size();
+    std::uint64_t n = 0;
+    auto cur = internal::read_varint(in.data(), end, n);
+    if (!cur || n > static_cast<std::uint64_t>(std::numeric_limits<std::uint16_t>::max()) + 1) {
+      ec = std::make_error_code(errc::invalid_binary_format);
+      return 0;
+    }
+    for (std::uint64_t i = 0; i < n; i++) {
+      std::uint64_t size = 0;
+      if (cur = internal::read_varint(cur, end, size); !cur || size > static_cast<std::uint64_t>(end - cur)) {
+        ec = std::make_error_code(errc::invalid_binary_format);
+        return 0;
+      }
+      const auto zone = locate_zone(std::string_view{ reinterpret_cast<const char*>(cur), static_cast<std::size_t>(size) }, ec);
+      if (ec) {
+        return 0;
+      }
+      cur += size;
+      add(zone);
+    }
+    return static_cast<std::size_t>(cur - in.data());
+  }
+
+  std::size_t decode(std::span<const std::byte> in)
+  {
+    std::error_code ec;
+    const auto size = decode(in, ec);
+    if (ec) {
+      throw std::system_error(ec, "zone table decode error");
+    }
+    return size;
+  }
+
+private:
+  std::vector<const time_zone*> zones_;
+  std::unordered_map<const time_zone*, std::uint16_t> indices_;
+};
+
+// ====================================================================================================================
+// Fixed width
+// ====================================================================================================================
+
+// Values are encoded as 64 bit little-endian counts, so the value at index i starts at byte i * 8.
+// Zoned times add the 16 bit little-endian index of their zone in a zone table and take 10 bytes.
+
+template <typename T>
+  requires BinaryTime<T> || TzdbZonedTime<T>
+inline constexpr std::size_t binary_size = TzdbZonedTime<T> ? 10 : 8;
+
+template <BinaryTime T>
+inline std::byte* encode_fixed(const T& value, std::byte* out) noexcept
+{
+  internal::store_le(out, internal::binary_count(value));
+  return out + 8;
+}
+
+template <BinaryTime T>
+[[nodiscard]] inline T decode_fixed(const std::byte* in, std::size_t index = 0) noexcept
+{
+  return internal::binary_value<T>(internal::load_le<std::uint64_t>(in + index * 8));
+}
+
+template <TzdbZonedTime T>
+inline std::byte* encode_fixed(const T& value, zone_table& zones, std::byte* out)
+{
+  internal::store_le(out, internal::binary_count(value.get_sys_time()));
+  internal::store_le(out + 8, zones.add(value.get_time_zone()));
+  return out + 10;
+}
+
+// Returns the zoned time at index. The zone is nullptr if the zone table has no zone with its index.
+template <TzdbZonedTime T>
+[[nodiscard]] inline T decode_fixed(const std::byte* in, const zone_table& zones, std::size_t index = 0)
+{
+  using sys_time = dtz::sys_time<typename is_zoned_time<T>::duration>;
+  in += index * 10;
+  const auto tp = internal::binary_value<sys_time>(internal::load_le<std::uint64_t>(in));
+  return T{ zones[internal::load_le<std::uint16_t>(in + 8)], tp };
+}
+
+// Writes values.size() * 8 bytes and returns the end of the output.
+template <std::ranges::contiguous_range Range>
+  requires BinaryTime<std::ranges::range_value_t<Range>>
+inline std::byte* encode_fixed(const Range& values, std::byte* out) noexcept
+{
+  using T = std::ranges::range_value_t<Range>;
+  const auto size = std::ranges::size(values);
+  if constexpr (std::endian::native == std::endian::little && sizeof(T) == 8 && std::is_same_v<typename T::rep, std::int64_t>) {
+    std::memcpy(out, std::ranges::data(values), size * 8);
+    return out + size * 8;
+  } else {
+    for (const auto& value : values) {
+      out = encode_fixed(value, out);
+    }
+    return out;
+  }
+}
+
+// Reads out.size() * 8 bytes.
+template <BinaryTime T>
+inline void decode_fixed(const std::byte* in, std::span<T> out) noexcept
+{
+  if constexpr (std::endian::native == std::endian::little && sizeof(T) == 8 && std::is_same_v<typename T::rep, std::int64_t>) {
+    std::memcpy(out.data(), in, out.size() * 8);
+  } else {
+    for (std::size_t i = 0; i < out.size(); i++) {
+      out[i] = decode_fixed<T>(in, i);
+    }
+  }
+}
+
+// ====================================================================================================================
+// Columnar
+// ====================================================================================================================
+
+// Columns are encoded as a varint count followed by the delta of delta of every value to the previous
+// two as a zig-zag varint, so regular series need one byte per value. Zoned columns start with their
+// zone table and runs of zone indices as varint (index, length) pairs, followed by the column of their
+// sys times. Columns are appended to out.
+
+template <std::ranges::sized_range Range>
+  requires BinaryTime<std::ranges::range_value_t<Range>>
+inline void encode_column(const Range& values, std::vector<std::byte>& out)
+{
+  const auto begin = std::ranges::begin(values);
+  internal::encode_counts(std::ranges::size(values), [&](std::size_t i) {
+    return internal::binary_count(begin[static_cast<std::ranges::range_difference_t<Range>>(i)]);
+  }, out);
+}
+
+template <std::ranges::sized_range Range>
+  requires TzdbZonedTime<std::ranges::range_value_t<Range>>
+inline void encode_column(const Range& values, std::vector<std::byte>& out)
+{
+  const auto begin = std::ranges::begin(values);
+  const auto size = std::ranges::size(values);
+  const auto at = [&](std::size_t i) -> const auto& {
+    return begin[static_cast<std::ranges::range_difference_t<Range>>(i)];
+  };
+  zone_table zones;
+  std::vector<std::uint64_t> runs;
+  for (std::size_t i = 0; i < size;) {
+    const auto zone = at(i).get_time_zone();
+    std::size_t n = 1;
+    while (i + n < size && at(i + n).get_time_zone() == zone) {
+      n++;
+    }
+    runs.push_back(zones.add(zone));
+    runs.push_back(n);
+    i += n;
+  }
+  zones.encode(out);
+  internal::write_varint(out, runs.size() / 2);
+  for (const auto value : runs) {
+    internal::write_varint(out, value);
+  }
+  internal::encode_counts(size, [&](std::size_t i) {
+    return internal::binary_count(at(i).get_sys_time());
+  }, out);
+}
+
+// Appends the values of a column to out and returns the number of bytes read.
+template <BinaryTime T>
+inline std::size_t decode_column(std::span<const std::byte> in, std::vector<T>& out, std::error_code& ec)
+{
+  ec.clear();
+  const auto offset = out.size();
+  const auto end = internal::decode_counts(in.data(), in.data() + in.size(), [&](std::size_t n) {
+    out.resize(offset + n);
+  }, [&](std::size_t i, std::uint64_t count) {
+    out[offset + i] = internal::binary_value<T>(count);
+  });
+  if (!end) {
+    out.resize(offset);
+    ec = std::make_error_code(errc::invalid_binary_format);
+    return 0;
+  }
+  return static_cast<std::size_t>(end - in.data());
+}
+
+template <TzdbZonedTime T>
+inline std::size_t decode_column(std::span<const std::byte> in, std::vector<T>& out, std::error_code& ec)
+{
+  using sys_time = dtz::sys_time<typename is_zoned_time<T>::duration>;
+  zone_table zones;
+  auto cur = in.data() + zones.decode(in, ec);
+  if (ec) {
+    return 0;
+  }
+  const auto end = in.data() + in.size();
+  const auto fail = [&]() -> std::size_t {
+    ec = std::make_error_code(errc::invalid_binary_format);
+    return 0;
+  };
+  std::uint64_t count = 0;
+  if (cur = internal::read_varint(cur, end, count); !cur || count > static_cast<std::uint64_t>(end - cur)) {
+    return fail();
+  }
+  std::vector<std::pair<const time_zone*, std::uint64_t>> runs;
+  runs.reserve(static_cast<std::size_t>(count));
+  for (std::uint64_t i = 0; i < count; i++) {
+    std::uint64_t index = 0;
+    std::uint64_t n = 0;
+    if (cur = internal::read_varint(cur, end, index); !cur || !zones[index]) {
+      return fail();
+    }
+    if (cur = internal::read_varint(cur, end, n); !cur) {
+      return fail();
+    }
+    runs.emplace_back(zones[index], n);
+  }
+  std::vector<sys_time> tps;
+  const auto size = decode_column(std::span{ cur, end }, tps, ec);
+  if (ec) {
+    return 0;
+  }
+  // Runs are validated against the number of values left so that their sum cannot wrap around.
+  auto remaining = static_cast<std::uint64_t>(tps.size());
+  for (const auto& run : runs) {
+    if (run.second == 0 || run.second > remaining) {
+      return fail();
+    }
+    remaining -= run.second;
+  }
+  if (remaining != 0) {
+    return fail();
+  }
+  out.reserve(out.size() + tps.size());
+  auto tp = tps.begin();
+  for (const auto& [zone, n] : runs) {
+    for (std::uint64_t i = 0; i < n; i++) {
+      out.emplace_back(zone, *tp++);
+    }
+  }
+  return static_cast<std::size_t>(cur - in.data()) + size;
+}
+
+template <typename T>
+  requires BinaryTime<T> || TzdbZonedTime<T>
+inline std::size_t decode_column(std::span<const std::byte> in, std::vector<T>& out)
+{
+  std::error_code ec;
+  const auto size = decode_column(in, out, ec);
+  if (ec) {
+    throw std::system_error(ec, "column decode error");
+  }
+  return size;
+}
+
+}  // namespace dtz
@@ -0,0 +1,196 @@
+#pragma once
+#include "chrono.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace dtz {
+
+enum class bucket_unit {
+  hour,
+  day,
+  week,
+  month,
+  quarter,
+  year,
+};
+
+// Maps sys_time values to local calendar buckets in a time zone.
+//
+// Bucket ids are ordinals of the local calendar unit: hours and days since 1970-01-01, ISO weeks
+// (starting on Monday) since 1969-12-29, months and quarters since year 0 and years. A bucket holds
+// every instant whose local time falls into the unit, so DST days last 23 or 25 hours, a repeated
+// local hour lasts two hours and a skipped local hour is empty.
+//
+// Bucket boundaries between begin and end are precomputed. Lookups in that range cost one shift,
+// one table load and usually a single comparison. Lookups outside of it convert the time point.
+class bucketer
+{
+public:
+  bucketer(const time_zone* zone, bucket_unit unit, sys_time<seconds> begin, sys_time<seconds> end) :
+    zone_(zone), unit_(unit), shift_(unit == bucket_unit::hour ? 11 : 15)
+  {
+    first_ = local_id(zone_->to_local(begin));
+    const auto last = end > begin ? local_id(zone_->to_local(end - seconds{ 1 })) : first_;
+    boundaries_.reserve(static_cast<std::size_t>(last - first_ + 2));
+    for (auto i = first_; i <= last + 1; i++) {
+      boundaries_.push_back(start(i));
+    }
+    const auto origin = boundaries_.front();
+    const auto buckets = boundaries_.size() - 1;
+    hints_.resize(static_cast<std::size_t>((boundaries_.back() - origin).count() >> shift_) + 1);
+    std::size_t i = 0;
+    for (std::size_t slot = 0; slot < hints_.size(); slot++) {
+      const auto tp = origin + seconds{ static_cast<std::int64_t>(slot) << shift_ };
+      while (i + 1 < buckets && tp >= boundaries_[i + 1]) {
+        i++;
+      }
+      hints_[slot] = static_cast<std::uint32_t>(i);
+    }
+  }
+
+  [[nodiscard]] const time_zone* zone() const noexcept
+  {
+    return zone_;
+  }
+
+  [[nodiscard]] bucket_unit unit() const noexcept
+  {
+    return unit_;
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] std::int64_t id(const sys_time<Duration>& tp) const noexcept
+  {
+    const auto s = dtz::floor<seconds>(tp);
+    if (s < boundaries_.front() || s >= boundaries_.back()) {
+      return local_id(zone_->to_local(s));
+    }
+    return first_ + static_cast<std::int64_t>(index(s));
+  }
+
+  // Returns the first instant of the bucket or the DST transition when the local start does not exist.
+  [[nodiscard]] sys_time<seconds> start(std::int64_t id) const noexcept
+  {
+    if (id >= first_ && id - first_ < static_cast<std::int64_t>(boundaries_.size())) {
+      return boundaries_[static_cast<std::size_t>(id - first_)];
+    }
+    return zone_->to_sys(local_start(id), choose::earliest);
+  }
+
+  [[nodiscard]] sys_time<seconds> end(std::int64_t id) const noexcept
+  {
+    return start(id + 1);
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] sys_time<seconds> floor(const sys_time<Duration>& tp) const noexcept
+  {
+    return start(id(tp));
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] sys_time<seconds> ceil(const sys_time<Duration>& tp) const noexcept
+  {
+    const auto i = id(tp);
+    const auto s = start(i);
+    return s == tp ? s : start(i + 1);
+  }
+
+  // Writes the bucket id of every time point in tps to ids. The spans must have the same size.
+  template <Duration Duration>
+  void ids(std::span<const sys_time<Duration>> tps, std::span<std::int64_t> out) const noexcept
+  {
+    for (std::size_t i = 0; i < tps.size(); i++) {
+      out[i] = id(tps[i]);
+    }
+  }
+
+  // Writes the bucket start of every time point in tps to out. The spans must have the same size.
+  template <Duration Duration>
+  void starts(std::span<const sys_time<Duration>> tps, std::span<sys_time<seconds>> out) const noexcept
+  {
+    for (std::size_t i = 0; i < tps.size(); i++) {
+      const auto s = dtz::floor<seconds>(tps[i]);
+      if (s < boundaries_.front() || s >= boundaries_.back()) {
+        out[i] = start(local_id(zone_->to_local(s)));
+      } else {
+        out[i] = boundaries_[index(s)];
+      }
+    }
+  }
+
+private:
+  // Days between 1969-12-29 (Monday) and 1970-01-01 (Thursday).
+  static constexpr days week_offset{ 3 };
+
+  [[nodiscard]] std::size_t index(sys_time<seconds> s) const noexcept
+  {
+    std::size_t i = hints_[static_cast<std::size_t>((s - boundaries_.front()).count() >> shift_)];
+    while (s >= boundaries_[i + 1]) {
+      i++;
+    }
+    return i;
+  }
+
+  [[nodiscard]] std::int64_t local_id(local_time<seconds> lt) const noexcept
+  {
+    switch (unit_) {
+    case bucket_unit::hour:
+      return dtz::floor<hours>(lt).time_since_epoch().count();
+    case bucket_unit::day:
+      return dtz::floor<days>(lt).time_since_epoch().count();
+    case bucket_unit::week:
+      return dtz::floor<weeks>(dtz::floor<days>(lt).time_since_epoch() + week_offset).count();
+    default:
+      break;
+    }
+    const auto ymd = year_month_day{ dtz::floor<days>(lt) };
+    const auto y = static_cast<std::int64_t>(static_cast<int>(ymd.year()));
+    const auto m = static_cast<std::int64_t>(static_cast<unsigned>(ymd.month())) - 1;
+    switch (unit_) {
+    case bucket_unit::month:
+      return y * 12 + m;
+    case bucket_unit::quarter:
+      return y * 4 + m / 3;
+    default:
+      return y;
+    }
+  }
+
+  [[nodiscard]] local_time<seconds> local_start(std::int64_t id) const noexcept
+  {
+    const auto floor_div = [](std::int64_t a, std::int64_t b) {
+      return a / b - (a % b < 0 ? 1 : 0);
+    };
+    const auto ym = [&](std::int64_t months) {
+      const auto y = floor_div(months, 12);
+      return local_days{ year{ static_cast<int>(y) } / month{ static_cast<unsigned>(months - y * 12 + 1) } / 1 };
+    };
+    switch (unit_) {
+    case bucket_unit::hour:
+      return local_time<seconds>{ hours{ id } };
+    case bucket_unit::day:
+      return local_days{ days{ id } };
+    case bucket_unit::week:
+      return local_days{ weeks{ id } - week_offset };
+    case bucket_unit::month:
+      return ym(id);
+    case bucket_unit::quarter:
+      return ym(id * 3);
+    case bucket_unit::year:
+      return ym(id * 12);
+    }
+    return {};
+  }
+
+  const time_zone* zone_ = nullptr;
+  bucket_unit unit_ = bucket_unit::day;
+  int shift_ = 15;
+  std::int64_t first_ = 0;
+  std::vector<sys_time<seconds>> boundaries_;
+  std::vector<std::uint32_t> hints_;
+};
+
+}  // namespace dtz
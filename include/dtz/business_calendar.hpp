@@ -0,0 +1,146 @@
+#pragma once
+#include "chrono.hpp"
+#include "error.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace dtz {
+
+// Business days between first/1/1 and last/12/31 stored as a bitset with one bit per day and the
+// number of business days before every 64 bit word, so rank and select queries cost a popcount.
+//
+// Text format (see parse): one entry per line, '#' starts a comment.
+//
+//   years 2000 2050      # covered years (required)
+//   weekend sat sun      # weekend days (default: sat sun)
+//   2024-12-25 Christmas # holiday, text after the date is ignored
+//   +2024-12-28          # business day on a weekend
+//
+// Queries outside of the covered years throw std::out_of_range.
+class business_calendar
+{
+public:
+  business_calendar() = default;
+
+  business_calendar(year first, year last, std::initializer_list<weekday> weekend = { sat, sun }) :
+    business_calendar(first, last, std::span{ weekend.begin(), weekend.size() }, {})
+  {}
+
+  business_calendar(year first, year last, std::span<const weekday> weekend, std::span<const year_month_day> holidays,
+    std::span<const year_month_day> business_days = {});
+
+  static business_calendar parse(std::string_view text, std::error_code& ec);
+  static business_calendar parse(std::string_view text);
+
+  static business_calendar load(const std::filesystem::path& path, std::error_code& ec);
+  static business_calendar load(const std::filesystem::path& path);
+
+  [[nodiscard]] year first() const noexcept
+  {
+    return year_month_day{ begin_ }.year();
+  }
+
+  [[nodiscard]] year last() const noexcept
+  {
+    return year_month_day{ begin_ + days{ static_cast<std::int64_t>(size_) - 1 } }.year();
+  }
+
+  [[nodiscard]] bool is_business_day(const year_month_day& ymd) const
+  {
+    const auto i = index(ymd);
+    return bits_[i >> 6] >> (i & 63) & 1;
+  }
+
+  // Returns the first business day after ymd.
+  [[nodiscard]] year_month_day next(const year_month_day& ymd) const
+  {
+    const auto i = index(ymd);
+    return select(rank(i) + (bits_[i >> 6] >> (i & 63) & 1));
+  }
+
+  // Returns the last business day before ymd.
+  [[nodiscard]] year_month_day prev(const year_month_day& ymd) const
+  {
+    const auto r = rank(index(ymd));
+    if (r == 0) {
+      throw std::out_of_range("business day out of range");
+    }
+    return select(r - 1);
+  }
+
+  // Returns the nth business day after ymd (n > 0), before ymd (n < 0) or ymd itself (n = 0).
+  [[nodiscard]] year_month_day add_business_days(const year_month_day& ymd, std::int64_t n) const
+  {
+    const auto i = index(ymd);
+    if (n == 0) {
+      return ymd;
+    }
+    const auto r = static_cast<std::int64_t>(rank(i));
+    const auto k = n > 0 ? r + static_cast<std::int64_t>(bits_[i >> 6] >> (i & 63) & 1) + n - 1 : r + n;
+    if (k < 0) {
+      throw std::out_of_range("business day out of range");
+    }
+    return select(static_cast<std::size_t>(k));
+  }
+
+  // Returns the number of business days in [from, to) or the negated number in [to, from).
+  [[nodiscard]] std::int64_t business_days_between(const year_month_day& from, const year_month_day& to) const
+  {
+    return static_cast<std::int64_t>(rank(index(to))) - static_cast<std::int64_t>(rank(index(from)));
+  }
+
+private:
+  [[nodiscard]] std::size_t index(const year_month_day& ymd) const
+  {
+    const auto i = (sys_days{ ymd } - begin_).count();
+    if (i < 0 || static_cast<std::size_t>(i) >= size_) {
+      throw std::out_of_range("date out of business calendar range");
+    }
+    return static_cast<std::size_t>(i);
+  }
+
+  // Number of business days before day i.
+  [[nodiscard]] std::size_t rank(std::size_t i) const noexcept
+  {
+    const auto mask = (std::uint64_t{ 1 } << (i & 63)) - 1;
+    return ranks_[i >> 6] + static_cast<std::size_t>(std::popcount(bits_[i >> 6] & mask));
+  }
+
+  // Day of the business day with rank k.
+  [[nodiscard]] year_month_day select(std::size_t k) const
+  {
+    if (k >= count_) {
+      throw std::out_of_range("business day out of range");
+    }
+    // Business days are spread evenly enough for the proportional guess to be off by a few words.
+    auto w = std::min(k * bits_.size() / count_, bits_.size() - 1);
+    while (ranks_[w] > k) {
+      w--;
+    }
+    while (w + 1 < bits_.size() && ranks_[w + 1] <= k) {
+      w++;
+    }
+    auto word = bits_[w];
+    for (auto r = k - ranks_[w]; r; r--) {
+      word &= word - 1;
+    }
+    return year_month_day{ begin_ + days{ static_cast<std::int64_t>(w * 64 + std::countr_zero(word)) } };
+  }
+
+  sys_days begin_{};
+  std::size_t size_ = 0;
+  std::size_t count_ = 0;
+  std::vector<std::uint64_t> bits_;
+  std::vector<std::size_t> ranks_;
+};
+
+}  // namespace dtz
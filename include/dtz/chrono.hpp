@@ -1,9 +1,13 @@
 #pragma once
+#include "error.hpp"
 #include <date/date.h>
 #include <date/tz.h>
 #include <chrono>
+#include <cstddef>
 #include <filesystem>
+#include <span>
 #include <string_view>
+#include <system_error>
 #include <type_traits>
 
 namespace dtz {
@@ -235,7 +239,17 @@ inline const tzdb& reload_tzdb() {
 #endif
 
 using date::locate_zone;
-using date::current_zone;
+
+// Returns the zone named by the TZ environment variable or else the system zone. The zone is resolved once and then
+// read from a cache. On Linux, the cache is dropped when /etc/localtime or /etc/timezone changes.
+const time_zone* current_zone();
+
+// Drops the cached current zone, e.g. after changing the TZ environment variable.
+void reset_current_zone() noexcept;
+
+// Non-throwing lookups. Set ec to errc::zone_not_found or errc::tzdata_load_error and return nullptr on failure.
+const time_zone* locate_zone(std::string_view name, std::error_code& ec) noexcept;
+const time_zone* current_zone(std::error_code& ec) noexcept;
 
 using date::sys_info;
 using date::local_info;
@@ -261,6 +275,7 @@ struct is_zoned_time : std::false_type {};
 template <Duration Duration, TimeZonePtr TimeZonePtr>
 struct is_zoned_time<zoned_time<Duration, TimeZonePtr>> {
   using duration = Duration;
+  using time_zone_ptr = TimeZonePtr;
   static constexpr bool value = std::ratio_less_v<typename duration::period, days::period>;
 };
 
@@ -270,6 +285,10 @@ inline constexpr bool is_zoned_time_v = is_zoned_time<T>::value;
 template <typename T>
 concept ZonedTime = is_zoned_time_v<T>;
 
+// Zoned times with a tzdb time_zone, as opposed to custom zones like fixed_zone and posix_zone.
+template <typename T>
+concept TzdbZonedTime = ZonedTime<T> && std::is_same_v<typename is_zoned_time<T>::time_zone_ptr, const time_zone*>;
+
 
 template <typename T>
 concept SafeZonedLocalTime = (LocalTime<T> &&
@@ -324,6 +343,61 @@ template <Clock FromClock, ValidZonedTimeDuration FromValidZonedTimeDuration>
   return dtz::make_zoned(locate_zone(zone), tp);
 }
 
+// Non-throwing overloads. On failure, ec is set and the result holds the sys_time epoch in the given zone,
+// or a null zone when the zone name could not be found.
+
+template <SafeZonedLocalTime FromSafeZonedLocalTime>
+[[nodiscard]] inline auto make_zoned(std::string_view zone, const FromSafeZonedLocalTime& lt, std::error_code& ec) noexcept {
+  using Duration = typename FromSafeZonedLocalTime::duration;
+  if (const auto tz = locate_zone(zone, ec)) {
+    return dtz::make_zoned(tz, lt);
+  }
+  return zoned_time<Duration>{ static_cast<const time_zone*>(nullptr), sys_time<Duration>{} };
+}
+
+template <UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+[[nodiscard]] inline auto make_zoned(std::string_view zone, const FromUnsafeZonedLocalTime& lt, choose choose, std::error_code& ec) noexcept {
+  using Duration = typename FromUnsafeZonedLocalTime::duration;
+  if (const auto tz = locate_zone(zone, ec)) {
+    return dtz::make_zoned(tz, lt, choose);
+  }
+  return zoned_time<Duration>{ static_cast<const time_zone*>(nullptr), sys_time<Duration>{} };
+}
+
+template <UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+[[nodiscard]] inline auto make_zoned(const time_zone* zone, const FromUnsafeZonedLocalTime& lt, std::error_code& ec) noexcept {
+  using Duration = typename FromUnsafeZonedLocalTime::duration;
+  ec.clear();
+  const auto info = zone->get_info(lt);
+  if (info.result == local_info::unique) {
+    if constexpr (std::is_same_v<Duration, typename zoned_time<Duration>::duration>) {
+      return zoned_time<Duration>{ zone, sys_time<Duration>{ lt.time_since_epoch() - info.first.offset } };
+    } else {
+      return zoned_time<Duration>{ zone, lt, choose::earliest };
+    }
+  }
+  if (info.result == local_info::ambiguous) {
+    ec = std::make_error_code(errc::ambiguous_local_time);
+  } else {
+    ec = std::make_error_code(errc::nonexistent_local_time);
+  }
+  return zoned_time<Duration>{ zone, sys_time<Duration>{} };
+}
+
+template <UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+[[nodiscard]] inline auto make_zoned(std::string_view zone, const FromUnsafeZonedLocalTime& lt, std::error_code& ec) noexcept {
+  using Duration = typename FromUnsafeZonedLocalTime::duration;
+  if (const auto tz = locate_zone(zone, ec)) {
+    return dtz::make_zoned(tz, lt, ec);
+  }
+  return zoned_time<Duration>{ static_cast<const time_zone*>(nullptr), sys_time<Duration>{} };
+}
+
+template <Clock FromClock, ValidZonedTimeDuration FromValidZonedTimeDuration>
+[[nodiscard]] inline auto make_zoned(std::string_view zone, const time_point<FromClock, FromValidZonedTimeDuration>& tp, std::error_code& ec) noexcept {
+  return dtz::make_zoned(locate_zone(zone, ec), tp);
+}
+
 
 // ====================================================================================================================
 // HHMMSS
@@ -428,7 +502,8 @@ template <Duration ToDuration, TimePointOrLocalTime FromTimePointOrLocalTime>
 
 template <ValidZonedTimeDuration ToValidZonedTimeDuration, ZonedTime FromZonedTime>
 [[nodiscard]] inline constexpr auto cast(const FromZonedTime& zt) {
-  return zoned_time<ToValidZonedTimeDuration>{ zt.get_time_zone(), cast<ToValidZonedTimeDuration>(zt.get_sys_time()) };
+  using TimeZonePtr = typename is_zoned_time<FromZonedTime>::time_zone_ptr;
+  return zoned_time<ToValidZonedTimeDuration, TimeZonePtr>{ zt.get_time_zone(), cast<ToValidZonedTimeDuration>(zt.get_sys_time()) };
 }
 
 template <ClockOrLocal ToClockOrLocal, TimePointOrLocalTime FromTimePointOrLocalTime>
@@ -510,6 +585,10 @@ template <Clock Clock>
   return date::make_zoned(locate_zone(zone), now());
 }
 
+[[nodiscard]] inline auto now(std::string_view zone, std::error_code& ec) noexcept {
+  return date::make_zoned(locate_zone(zone, ec), now());
+}
+
 // clang-format on
 
 // ====================================================================================================================
@@ -522,6 +601,29 @@ void initialize(const std::filesystem::path& tzdata);
 void initialize(std::error_code& ec) noexcept;
 void initialize();
 
+// Durations of the warm_up phases.
+struct warm_up_timings
+{
+  // Loading the time zone database.
+  nanoseconds database{};
+
+  // Loading the transitions of the zones.
+  nanoseconds zones{};
+
+  // Number of zones loaded.
+  std::size_t zone_count = 0;
+};
+
+// Loads the time zone database and the transitions of the named zones on up to threads threads (the hardware
+// concurrency if 0), so that the first lookups and conversions in other threads do not stall. Sets ec to
+// errc::zone_not_found or errc::tzdata_load_error on failure, after loading every zone that was found.
+warm_up_timings warm_up(std::span<const std::string_view> zones, std::error_code& ec, unsigned threads = 0) noexcept;
+warm_up_timings warm_up(std::span<const std::string_view> zones, unsigned threads = 0);
+
+// Loads the time zone database and the transitions of every zone in it.
+warm_up_timings warm_up(std::error_code& ec, unsigned threads = 0) noexcept;
+warm_up_timings warm_up(unsigned threads = 0);
+
 namespace literals {
 
 using namespace std::chrono_literals;
@@ -0,0 +1,156 @@
+#pragma once
+#include "chrono.hpp"
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <ratio>
+#include <stdexcept>
+
+namespace dtz {
+namespace internal {
+
+// Returns the id of the zone and registers it if it is new. Throws std::invalid_argument for nullptr
+// and std::length_error when all 65536 ids are in use.
+std::uint16_t register_zone(const time_zone* zone);
+
+// Returns the zone with the id or nullptr if the id is not in use.
+const time_zone* registered_zone(std::uint16_t id) noexcept;
+
+// Returns the number of registered zones.
+std::size_t registered_zones() noexcept;
+
+}  // namespace internal
+
+// Dense 16-bit id of a time zone. Ids are assigned by a process-wide registry when a zone is first
+// used and stay valid for the lifetime of the process. Id 0 is UTC.
+class zone_id
+{
+public:
+  constexpr zone_id() noexcept = default;
+
+  explicit zone_id(const time_zone* zone) : value_(internal::register_zone(zone))
+  {}
+
+  // Returns the id with the value without checking that it is in use.
+  [[nodiscard]] static constexpr zone_id from_value(std::uint16_t value) noexcept
+  {
+    zone_id id;
+    id.value_ = value;
+    return id;
+  }
+
+  [[nodiscard]] constexpr std::uint16_t value() const noexcept
+  {
+    return value_;
+  }
+
+  // Returns the zone or nullptr if the id is not in use.
+  [[nodiscard]] const time_zone* zone() const noexcept
+  {
+    return internal::registered_zone(value_);
+  }
+
+  // Returns the number of ids in use.
+  [[nodiscard]] static std::size_t size() noexcept
+  {
+    return internal::registered_zones();
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(zone_id lhs, zone_id rhs) noexcept = default;
+  [[nodiscard]] friend constexpr auto operator<=>(zone_id lhs, zone_id rhs) noexcept = default;
+
+private:
+  std::uint16_t value_ = 0;
+};
+
+// Zoned time in 8 bytes: a 48-bit sys_time count and a 16-bit zone_id.
+//
+// The count covers about 4462 years around 1970 for milliseconds, so finer durations are not
+// supported. Values compare by sys_time and then by zone id and satisfy ZonedTime, so they can be
+// formatted and cast like zoned_time.
+template <Duration Duration = milliseconds>
+  requires std::integral<typename Duration::rep> && std::ratio_greater_equal_v<typename Duration::period, std::milli>
+class compact_zoned
+{
+public:
+  using duration = Duration;
+
+  static constexpr std::int64_t max_count = (std::int64_t{ 1 } << 47) - 1;
+  static constexpr std::int64_t min_count = -(std::int64_t{ 1 } << 47);
+
+  // The sys_time epoch in UTC.
+  constexpr compact_zoned() noexcept = default;
+
+  // Throws std::out_of_range if tp does not fit in 48 bits.
+  constexpr compact_zoned(zone_id id, sys_time<Duration> tp) : bits_(pack(id, tp))
+  {}
+
+  compact_zoned(const time_zone* zone, sys_time<Duration> tp) : compact_zoned(zone_id{ zone }, tp)
+  {}
+
+  explicit compact_zoned(const zoned_time<Duration>& zt) : compact_zoned(zt.get_time_zone(), floor<Duration>(zt.get_sys_time()))
+  {}
+
+  [[nodiscard]] constexpr zone_id get_zone_id() const noexcept
+  {
+    return zone_id::from_value(static_cast<std::uint16_t>(bits_ & 0xFFFF));
+  }
+
+  [[nodiscard]] const time_zone* get_time_zone() const noexcept
+  {
+    return get_zone_id().zone();
+  }
+
+  [[nodiscard]] constexpr sys_time<Duration> get_sys_time() const noexcept
+  {
+    // Arithmetic shift of the signed count.
+    return sys_time<Duration>{ Duration{ static_cast<typename Duration::rep>(bits_ >> 16) } };
+  }
+
+  [[nodiscard]] auto get_local_time() const
+  {
+    return get_time_zone()->to_local(get_sys_time());
+  }
+
+  [[nodiscard]] sys_info get_info() const
+  {
+    return get_time_zone()->get_info(get_sys_time());
+  }
+
+  [[nodiscard]] zoned_time<Duration> get_zoned_time() const
+  {
+    return { get_time_zone(), get_sys_time() };
+  }
+
+  explicit operator zoned_time<Duration>() const
+  {
+    return get_zoned_time();
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const compact_zoned& lhs, const compact_zoned& rhs) noexcept = default;
+  [[nodiscard]] friend constexpr auto operator<=>(const compact_zoned& lhs, const compact_zoned& rhs) noexcept = default;
+
+private:
+  [[nodiscard]] static constexpr std::int64_t pack(zone_id id, sys_time<Duration> tp)
+  {
+    const auto count = static_cast<std::int64_t>(tp.time_since_epoch().count());
+    if (count < min_count || count > max_count) {
+      throw std::out_of_range("time point out of compact_zoned range");
+    }
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(count) << 16 | id.value());
+  }
+
+  // The count in the upper 48 bits and the zone id in the lower 16 bits, so the value orders by
+  // sys_time and then by zone id.
+  std::int64_t bits_ = 0;
+};
+
+template <Duration Duration>
+struct is_zoned_time<compact_zoned<Duration>>
+{
+  using duration = Duration;
+  using time_zone_ptr = const time_zone*;
+  static constexpr bool value = true;
+};
+
+}  // namespace dtz
@@ -14,6 +14,11 @@ enum class errc {
   invalid_seconds_format,
   invalid_subseconds_format,
   tzdata_load_error,
+  zone_not_found,
+  ambiguous_local_time,
+  nonexistent_local_time,
+  invalid_binary_format,
+  invalid_time_zone_format,
 };
 
 class error : public std::error_category
@@ -0,0 +1,146 @@
+#pragma once
+#include "chrono.hpp"
+#include "format.hpp"
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace dtz {
+
+// Offsets of a list of time zones, each cached with the interval of sys_time where it is valid.
+// Instants in the same interval reuse the offset without looking up the zone transitions.
+class zone_offsets
+{
+public:
+  zone_offsets() = default;
+
+  explicit zone_offsets(std::span<const time_zone* const> zones)
+  {
+    entries_.reserve(zones.size());
+    for (const auto zone : zones) {
+      entries_.push_back({ zone });
+    }
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return entries_.size();
+  }
+
+  [[nodiscard]] const time_zone* zone(std::size_t i) const noexcept
+  {
+    return entries_[i].zone;
+  }
+
+  // Returns the offset of zone i at tp.
+  [[nodiscard]] seconds offset(std::size_t i, sys_time<seconds> tp)
+  {
+    auto& e = entries_[i];
+    if (tp < e.begin || !(tp < e.end)) {
+      const auto info = e.zone->get_info(tp);
+      e.begin = info.begin;
+      e.end = info.end;
+      e.offset = info.offset;
+    }
+    return e.offset;
+  }
+
+private:
+  struct entry
+  {
+    const time_zone* zone = nullptr;
+    sys_time<seconds> begin = sys_time<seconds>::max();
+    sys_time<seconds> end = sys_time<seconds>::min();
+    seconds offset{};
+  };
+
+  std::vector<entry> entries_;
+};
+
+namespace internal {
+
+// Writes a value from 0 to 99 as two digits.
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt write_pair(OutputIt out, int value) noexcept
+{
+  const auto i = static_cast<std::size_t>(value) * 2;
+  *out++ = digit_pairs[i];
+  *out++ = digit_pairs[i + 1];
+  return out;
+}
+
+// Formats tp in every zone like format_to(make_zoned(zone, tp)). The dates and the sub-second part
+// are formatted once. Each zone only adds its offset to the UTC time of day in seconds.
+template <std::output_iterator<char> OutputIt, Duration Duration, typename Offset>
+inline OutputIt fan_out(sys_time<Duration> tp, std::size_t size, Offset offset, OutputIt out)
+{
+  using Period = typename Duration::period;
+  using Rep = typename Duration::rep;
+  constexpr auto day_seconds = 86'400;
+  const auto s = floor<seconds>(tp);
+  const auto day = floor<days>(s);
+  const auto tod = static_cast<int>((s - day).count());
+
+  // The sub-second part is the same in every zone and follows "00:00:00".
+  char fraction[buffer_size];  // NOLINT: Only the written part is copied.
+  auto fraction_end = fraction;
+  if constexpr (std::is_integral_v<Rep> && std::ratio_less_equal_v<Period, seconds::period>) {
+    fraction_end = write_time(fraction, tp - s);
+  }
+
+  // The UTC date and the dates before and after it, formatted when they are first used. Offsets are
+  // less than a day, so local times are at most one day apart from UTC.
+  char dates[3][buffer_size];  // NOLINT: Only the written part is copied.
+  char* date_ends[3] = {};
+
+  for (std::size_t i = 0; i < size; i++) {
+    auto local = tod + static_cast<int>(offset(i, s).count());
+    auto d = 1;
+    if (local < 0) {
+      local += day_seconds;
+      d = 0;
+    } else if (local >= day_seconds) {
+      local -= day_seconds;
+      d = 2;
+    }
+    if (!date_ends[d]) {
+      date_ends[d] = dtz::format_to(dates[d], local_days{ day.time_since_epoch() + days{ d - 1 } });
+    }
+    out = std::copy(dates[d], date_ends[d], out);
+    *out++ = ' ';
+    if constexpr (std::is_integral_v<Rep> && std::ratio_less_equal_v<Period, seconds::period>) {
+      out = write_pair(out, local / 3600);
+      *out++ = ':';
+      out = write_pair(out, local / 60 % 60);
+      *out++ = ':';
+      out = write_pair(out, local % 60);
+      out = std::copy(fraction + 8, fraction_end, out);
+    } else {
+      out = write_time(out, duration_cast<Duration>(seconds{ local } + (tp - s)));
+    }
+  }
+  return out;
+}
+
+}  // namespace internal
+
+// Formats tp in every zone back to back like format_to(make_zoned(zone, tp)) for each zone in order.
+// Every result has traits<zoned_time<Duration>>::buffer_size characters for years 0000 to 9999.
+template <std::output_iterator<char> OutputIt, Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+inline OutputIt fan_out(sys_time<Duration> tp, std::span<const time_zone* const> zones, OutputIt out)
+{
+  return internal::fan_out(tp, zones.size(), [&](std::size_t i, sys_time<seconds> s) { return zones[i]->get_info(s).offset; }, out);
+}
+
+// Formats tp in every zone of offsets and keeps the offsets for the following calls.
+template <std::output_iterator<char> OutputIt, Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+inline OutputIt fan_out(sys_time<Duration> tp, zone_offsets& zones, OutputIt out)
+{
+  return internal::fan_out(tp, zones.size(), [&](std::size_t i, sys_time<seconds> s) { return zones.offset(i, s); }, out);
+}
+
+}  // namespace dtz
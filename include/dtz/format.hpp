@@ -1,264 +1,356 @@
 #pragma once
 #include "traits.hpp"
 #include <fmt/format.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+#if __has_include(<format>)
+#  include <format>
+#endif
 
 namespace dtz {
+namespace internal {
+
+// Upper bound for every formatted value, including out of range hours and negative years.
+inline constexpr std::size_t buffer_size = 64;
+
+// clang-format off
+inline constexpr char digit_pairs[] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+// clang-format on
+
+// Writes an integer zero padded to at least WIDTH characters (sign included) like "{:0WIDTH}".
+template <std::size_t WIDTH, std::output_iterator<char> OutputIt, std::integral Integral>
+inline constexpr OutputIt write(OutputIt out, Integral value) noexcept
+{
+  auto negative = false;
+  auto u = static_cast<std::uint64_t>(value);
+  if constexpr (std::is_signed_v<Integral>) {
+    if (value < 0) {
+      negative = true;
+      u = 0 - u;
+    }
+  }
+  char buffer[20];  // NOLINT: Only the written part is copied.
+  auto it = std::end(buffer);
+  while (u >= 100) {
+    const auto i = static_cast<std::size_t>(u % 100) * 2;
+    u /= 100;
+    *--it = digit_pairs[i + 1];
+    *--it = digit_pairs[i];
+  }
+  if (u >= 10) {
+    const auto i = static_cast<std::size_t>(u) * 2;
+    *--it = digit_pairs[i + 1];
+    *--it = digit_pairs[i];
+  } else {
+    *--it = static_cast<char>('0' + u);
+  }
+  if (negative) {
+    *out++ = '-';
+  }
+  const auto size = static_cast<std::size_t>(std::end(buffer) - it) + (negative ? 1 : 0);
+  for (auto i = size; i < WIDTH; i++) {
+    *out++ = '0';
+  }
+  return std::copy(it, std::end(buffer), out);
+}
+
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt write(OutputIt out, std::string_view str) noexcept
+{
+  return std::copy(str.begin(), str.end(), out);
+}
 
-template <std::size_t SIZE, Duration Duration>
-inline auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const Duration& duration)
+// Writes a non-negative duration as "HH:MM", "HH:MM:SS" or "HH:MM:SS.fff" depending on precision.
+template <std::output_iterator<char> OutputIt, Duration Duration>
+inline constexpr OutputIt write_time(OutputIt out, const Duration& d) noexcept
 {
   using Period = typename Duration::period;
   using Rep = typename Duration::rep;
-  if (duration < Duration{ 0 }) {
-    out.push_back('-');
-  }
-  const auto d = abs(duration);
-  const auto h = cast<hours>(d);
+  const auto h = duration_cast<hours>(d);
+  out = write<2>(out, h.count());
   if constexpr (FormatDuration<Rep, Period, hours::period>) {
     const auto m = duration_cast<minutes>(d - h);
+    *out++ = ':';
+    out = write<2>(out, m.count());
     if constexpr (FormatDuration<Rep, Period, minutes::period>) {
       const auto s = duration_cast<seconds>(d - h - m);
+      *out++ = ':';
+      out = write<2>(out, s.count());
       if constexpr (FormatDuration<Rep, Period, microseconds::period>) {
-        const auto ns = duration_cast<nanoseconds>(d - h - m - s);
-        return fmt::format_to(
-          out, "{:02}:{:02}:{:02}.{:09}", h.count(), m.count(), s.count(), ns.count());
+        *out++ = '.';
+        out = write<9>(out, duration_cast<nanoseconds>(d - h - m - s).count());
       } else if constexpr (FormatDuration<Rep, Period, milliseconds::period>) {
-        const auto us = duration_cast<microseconds>(d - h - m - s);
-        return fmt::format_to(
-          out, "{:02}:{:02}:{:02}.{:06}", h.count(), m.count(), s.count(), us.count());
+        *out++ = '.';
+        out = write<6>(out, duration_cast<microseconds>(d - h - m - s).count());
       } else if constexpr (FormatDuration<Rep, Period, seconds::period>) {
-        const auto ms = duration_cast<milliseconds>(d - h - m - s);
-        return fmt::format_to(
-          out, "{:02}:{:02}:{:02}.{:03}", h.count(), m.count(), s.count(), ms.count());
-      } else {
-        return fmt::format_to(out, "{:02}:{:02}:{:02}", h.count(), m.count(), s.count());
+        *out++ = '.';
+        out = write<3>(out, duration_cast<milliseconds>(d - h - m - s).count());
       }
-    } else {
-      return fmt::format_to(out, "{:02}:{:02}", h.count(), m.count());
     }
   } else {
-    return fmt::format_to(out, "{:02}:00", h.count());
+    out = write(out, ":00");
+  }
+  return out;
+}
+
+}  // namespace internal
+
+// ====================================================================================================================
+// Output Iterator
+// ====================================================================================================================
+
+template <std::output_iterator<char> OutputIt, Duration Duration>
+inline constexpr OutputIt format_to(OutputIt out, const Duration& duration)
+{
+  if (duration < Duration{ 0 }) {
+    *out++ = '-';
   }
+  return internal::write_time(out, abs(duration));
 }
 
-template <std::size_t SIZE, LocalTime LocalTime>
-inline auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const LocalTime& tp)
+template <std::output_iterator<char> OutputIt, LocalTime LocalTime>
+inline constexpr OutputIt format_to(OutputIt out, const LocalTime& tp)
 {
   using Duration = typename LocalTime::duration;
   using Period = typename Duration::period;
   using Rep = typename Duration::rep;
   const auto tpd = floor<days>(tp);
   const auto ymd = year_month_day{ tpd };
-  const auto iy = std::abs(static_cast<int>(ymd.year()));
-  if (static_cast<int>(ymd.year()) < 0) {
-    out.push_back('-');
+  const auto iy = static_cast<int>(ymd.year());
+  if (iy < 0) {
+    *out++ = '-';
   }
+  out = internal::write<4>(out, std::abs(iy));
   if constexpr (std::ratio_less_v<Period, years::period> || std::is_floating_point_v<Rep>) {
-    const auto um = static_cast<unsigned int>(ymd.month());
-    if constexpr (std::ratio_less_v<Period, years::period> || std::is_floating_point_v<Rep>) {
-      const auto ud = static_cast<unsigned int>(ymd.day());
-      if constexpr (FormatDuration<Rep, Period, days::period>) {
-        const auto d = abs(tp - tpd);
-        const auto h = duration_cast<hours>(d);
-        if constexpr (FormatDuration<Rep, Period, hours::period>) {
-          const auto m = duration_cast<minutes>(d - h);
-          if constexpr (FormatDuration<Rep, Period, minutes::period>) {
-            const auto s = duration_cast<seconds>(d - h - m);
-            if constexpr (FormatDuration<Rep, Period, microseconds::period>) {
-              const auto ns = duration_cast<nanoseconds>(d - h - m - s);
-              constexpr auto format = "{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:09}";
-              return fmt::format_to(
-                out, format, iy, um, ud, h.count(), m.count(), s.count(), ns.count());
-            } else if constexpr (FormatDuration<Rep, Period, milliseconds::period>) {
-              const auto us = duration_cast<microseconds>(d - h - m - s);
-              constexpr auto format = "{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:06}";
-              return fmt::format_to(
-                out, format, iy, um, ud, h.count(), m.count(), s.count(), us.count());
-            } else if constexpr (FormatDuration<Rep, Period, seconds::period>) {
-              const auto ms = duration_cast<milliseconds>(d - h - m - s);
-              constexpr auto format = "{:04}-{:02}-{:02} {:02}:{:02}:{:02}.{:03}";
-              return fmt::format_to(
-                out, format, iy, um, ud, h.count(), m.count(), s.count(), ms.count());
-            } else {
-              constexpr auto format = "{:04}-{:02}-{:02} {:02}:{:02}:{:02}";
-              return fmt::format_to(out, format, iy, um, ud, h.count(), m.count(), s.count());
-            }
-          } else {
-            return fmt::format_to(
-              out, "{:04}-{:02}-{:02} {:02}:{:02}", iy, um, ud, h.count(), m.count());
-          }
-        } else {
-          return fmt::format_to(out, "{:04}-{:02}-{:02} {:02}:00", iy, um, ud, h.count());
-        }
-      } else {
-        return fmt::format_to(out, "{:04}-{:02}-{:02}", iy, um, ud);
-      }
-    } else {
-      return fmt::format_to(out, "{:04}-{:02}", iy, um);
+    *out++ = '-';
+    out = internal::write<2>(out, static_cast<unsigned>(ymd.month()));
+    *out++ = '-';
+    out = internal::write<2>(out, static_cast<unsigned>(ymd.day()));
+    if constexpr (FormatDuration<Rep, Period, days::period>) {
+      *out++ = ' ';
+      out = internal::write_time(out, abs(tp - tpd));
     }
-  } else {
-    return fmt::format_to(out, "{:04}", iy);
   }
+  return out;
 }
 
-template <std::size_t SIZE, TimePoint TimePoint>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const TimePoint& tp)
+template <std::output_iterator<char> OutputIt, TimePoint TimePoint>
+inline constexpr OutputIt format_to(OutputIt out, const TimePoint& tp)
 {
-  return format_to(out, cast<local_t>(tp));
+  return dtz::format_to(out, cast<local_t>(tp));
 }
 
-template <std::size_t SIZE, ZonedTime ZonedTime>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const ZonedTime& tp)
+template <std::output_iterator<char> OutputIt, ZonedTime ZonedTime>
+inline constexpr OutputIt format_to(OutputIt out, const ZonedTime& tp)
 {
-  return format_to(out, cast<local_t>(tp));
+  return dtz::format_to(out, cast<local_t>(tp));
 }
 
-template <std::size_t SIZE, Duration Duration>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const hh_mm_ss<Duration>& hms)
+template <std::output_iterator<char> OutputIt, Duration Duration>
+inline constexpr OutputIt format_to(OutputIt out, const hh_mm_ss<Duration>& hms)
 {
-  return format_to(out, cast<Duration>(hms));
+  return dtz::format_to(out, cast<Duration>(hms));
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const day& d)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const day& d)
 {
-  return fmt::format_to(out, "{:02}", static_cast<unsigned>(d));
+  return internal::write<2>(out, static_cast<unsigned>(d));
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const month& m)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const month& m)
 {
   const auto s = traits<month>::names[static_cast<unsigned>(m) - 1];
-  out.append(s, s + traits<month>::buffer_size);
-  return out.end();
+  return std::copy(s, s + traits<month>::buffer_size, out);
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const year& y)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const year& y)
 {
-  return fmt::format_to(out, "{}", static_cast<int>(y));
+  return internal::write<0>(out, static_cast<int>(y));
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const weekday& wd)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const weekday& wd)
 {
   const auto s = traits<weekday>::names[wd.c_encoding()];
-  out.append(s, s + traits<weekday>::buffer_size);
-  return out.end();
+  return std::copy(s, s + traits<weekday>::buffer_size, out);
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const weekday_indexed& wdi)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const weekday_indexed& wdi)
 {
-  format_to(out, wdi.weekday());
-  return fmt::format_to(out, "[{}]", wdi.index());
+  out = dtz::format_to(out, wdi.weekday());
+  *out++ = '[';
+  out = internal::write<0>(out, wdi.index());
+  *out++ = ']';
+  return out;
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const weekday_last& wdl)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const weekday_last& wdl)
 {
-  constexpr const char* s = "[last]";
-  format_to(out, wdl.weekday());
-  out.append(s, s + 6);
-  return out.end();
+  out = dtz::format_to(out, wdl.weekday());
+  return internal::write(out, "[last]");
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const month_day& md)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const month_day& md)
 {
-  format_to(out, md.month());
-  return fmt::format_to(out, "/{:02}", static_cast<unsigned>(md.day()));
+  out = dtz::format_to(out, md.month());
+  *out++ = '/';
+  return internal::write<2>(out, static_cast<unsigned>(md.day()));
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const month_day_last& mdl)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const month_day_last& mdl)
 {
-  constexpr const char* s = "/last";
-  format_to(out, mdl.month());
-  out.append(s, s + 5);
-  return out.end();
+  out = dtz::format_to(out, mdl.month());
+  return internal::write(out, "/last");
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const month_weekday& mwd)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const month_weekday& mwd)
 {
-  format_to(out, mwd.month());
-  out.push_back('/');
-  return format_to(out, mwd.weekday_indexed());
+  out = dtz::format_to(out, mwd.month());
+  *out++ = '/';
+  return dtz::format_to(out, mwd.weekday_indexed());
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const month_weekday_last& mwdl)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const month_weekday_last& mwdl)
 {
-  format_to(out, mwdl.month());
-  out.push_back('/');
-  return format_to(out, mwdl.weekday_last());
+  out = dtz::format_to(out, mwdl.month());
+  *out++ = '/';
+  return dtz::format_to(out, mwdl.weekday_last());
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const year_month& ym)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const year_month& ym)
 {
-  const auto iy = static_cast<int>(ym.year());
-  const auto um = static_cast<unsigned int>(ym.month());
-  return fmt::format_to(out, "{}-{:02}", iy, um);
+  out = internal::write<0>(out, static_cast<int>(ym.year()));
+  *out++ = '-';
+  return internal::write<2>(out, static_cast<unsigned>(ym.month()));
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const year_month_day& ymd)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const year_month_day& ymd)
 {
-  const auto iy = static_cast<int>(ymd.year());
-  const auto um = static_cast<unsigned int>(ymd.month());
-  const auto ud = static_cast<unsigned int>(ymd.day());
-  return fmt::format_to(out, "{}-{:02}-{:02}", iy, um, ud);
+  out = dtz::format_to(out, ymd.year() / ymd.month());
+  *out++ = '-';
+  return internal::write<2>(out, static_cast<unsigned>(ymd.day()));
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const year_month_day_last& ymdl)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const year_month_day_last& ymdl)
 {
-  constexpr const char* s = "/last";
-  format_to(out, ymdl.year() / ymdl.month());
-  out.append(s, s + 5);
-  return out.end();
+  out = dtz::format_to(out, ymdl.year() / ymdl.month());
+  return internal::write(out, "/last");
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const year_month_weekday& ymwd)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const year_month_weekday& ymwd)
 {
-  format_to(out, ymwd.year() / ymwd.month());
-  out.push_back('/');
-  format_to(out, ymwd.weekday_indexed());
-  return out.end();
+  out = dtz::format_to(out, ymwd.year() / ymwd.month());
+  *out++ = '/';
+  return dtz::format_to(out, ymwd.weekday_indexed());
 }
 
-template <std::size_t SIZE>
-inline constexpr auto format_to(
-  fmt::basic_memory_buffer<char, SIZE>& out,
-  const year_month_weekday_last& ymwdl)
+template <std::output_iterator<char> OutputIt>
+inline constexpr OutputIt format_to(OutputIt out, const year_month_weekday_last& ymwdl)
 {
-  format_to(out, ymwdl.year() / ymwdl.month());
-  out.push_back('/');
-  format_to(out, ymwdl.weekday_last());
+  out = dtz::format_to(out, ymwdl.year() / ymwdl.month());
+  *out++ = '/';
+  return dtz::format_to(out, ymwdl.weekday_last());
+}
+
+// ====================================================================================================================
+// Memory Buffer
+// ====================================================================================================================
+
+template <std::size_t SIZE, Format Format>
+inline auto format_to(fmt::basic_memory_buffer<char, SIZE>& out, const Format& value)
+{
+  char buffer[internal::buffer_size];  // NOLINT: Only the written part is used.
+  out.append(buffer, dtz::format_to(buffer, value));
   return out.end();
 }
 
-template <dtz::Format Format>
+template <Format Format>
 inline std::string format(const Format& value)
 {
-  fmt::basic_memory_buffer<char, dtz::traits<Format>::buffer_size> out;
-  dtz::format_to(out, value);
-  return { out.data(), out.size() };
+  char buffer[internal::buffer_size];  // NOLINT: Only the written part is used.
+  return { buffer, dtz::format_to(buffer, value) };
 }
 
-}  // namespace dtz
+// ====================================================================================================================
+// Formatter
+// ====================================================================================================================
 
-template <dtz::Format Format>
-struct fmt::formatter<Format> : fmt::formatter<std::string_view>
+// Formats the value into a stack buffer with the shared writer and lets the string_view formatter
+// apply format specs like "{:>32}" and copy the result to the context output iterator in one step.
+// format is const because std::format calls it on a const formatter (LWG 3636).
+template <Format Format, typename Base>
+struct formatter : Base
 {
   template <typename FormatContext>
-  auto format(const Format& value, FormatContext& context)
+  auto format(const Format& value, FormatContext& context) const
   {
-    fmt::basic_memory_buffer<char, dtz::traits<Format>::buffer_size> out;
-    dtz::format_to(out, value);
-    return fmt::formatter<std::string_view>::format({ out.data(), out.size() }, context);
+    char buffer[internal::buffer_size];  // NOLINT: Only the written part is used.
+    const auto end = dtz::format_to(buffer, value);
+    return Base::format(std::string_view{ buffer, static_cast<std::size_t>(end - buffer) }, context);
   }
 };
+
+#ifdef __cpp_lib_format
+
+template <typename T>
+struct is_std_chrono : std::false_type
+{};
+
+template <typename Rep, typename Period>
+struct is_std_chrono<duration<Rep, Period>> : std::true_type
+{};
+
+template <Duration Duration>
+struct is_std_chrono<time_point<system_clock, Duration>> : std::true_type
+{};
+
+template <Duration Duration>
+struct is_std_chrono<time_point<steady_clock, Duration>> : std::true_type
+{};
+
+// Durations and time points of std clocks are standard library types with their own std::formatter.
+template <typename T>
+concept StdFormat = Format<T> && !is_std_chrono<T>::value;
+
+#endif
+
+}  // namespace dtz
+
+template <dtz::Format Format>
+struct fmt::formatter<Format> : dtz::formatter<Format, fmt::formatter<std::string_view>>
+{};
+
+#ifdef __cpp_lib_format
+
+template <dtz::StdFormat StdFormat>
+struct std::formatter<StdFormat, char> : dtz::formatter<StdFormat, std::formatter<std::string_view, char>>
+{};
+
+#endif
@@ -0,0 +1,380 @@
+#pragma once
+#include "chrono.hpp"
+#include "format.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dtz {
+namespace internal {
+
+// Hands out the smallest free thread index and takes back the indices of threads that exit, so the
+// indices stay below the largest number of threads that used them at the same time.
+class thread_slots
+{
+public:
+  [[nodiscard]] std::size_t acquire()
+  {
+    std::lock_guard lock{ mutex_ };
+    if (free_.empty()) {
+      return next_++;
+    }
+    std::pop_heap(free_.begin(), free_.end(), std::greater<>{});
+    const auto index = free_.back();
+    free_.pop_back();
+    return index;
+  }
+
+  void release(std::size_t index) noexcept
+  {
+    std::lock_guard lock{ mutex_ };
+    try {
+      free_.push_back(index);
+      std::push_heap(free_.begin(), free_.end(), std::greater<>{});
+    } catch (...) {
+      // The index is lost and later threads get new ones.
+    }
+  }
+
+  // Never destroyed because threads may exit after static destructors ran.
+  [[nodiscard]] static thread_slots& instance()
+  {
+    static auto* slots = new thread_slots;
+    return *slots;
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<std::size_t> free_;
+  std::size_t next_ = 0;
+};
+
+// Returns a small number that identifies the calling thread. The number is given back when the thread
+// exits and reused by the next thread. The exit of the previous owner happens before the mutex hands the
+// number to the next one, so data indexed by it keeps a single writer at a time.
+[[nodiscard]] inline std::size_t thread_index() noexcept
+{
+  struct slot
+  {
+    std::size_t index = thread_slots::instance().acquire();
+
+    ~slot()
+    {
+      thread_slots::instance().release(index);
+    }
+  };
+  thread_local const slot slot;
+  return slot.index;
+}
+
+// HDR bucket layout with 2^precision linear buckets for small values followed by 2^(precision - 1)
+// buckets for every power of two, so the width of a bucket is at most 2^(1 - precision) of its values.
+
+[[nodiscard]] inline constexpr std::size_t histogram_buckets(int precision) noexcept
+{
+  return static_cast<std::size_t>(66 - precision) << (precision - 1);
+}
+
+[[nodiscard]] inline constexpr std::size_t histogram_index(std::uint64_t value, int precision) noexcept
+{
+  const auto e = std::max(static_cast<int>(std::bit_width(value)), precision) - precision;
+  return (static_cast<std::size_t>(e) << (precision - 1)) + static_cast<std::size_t>(value >> e);
+}
+
+[[nodiscard]] inline constexpr std::uint64_t histogram_lower(std::size_t index, int precision) noexcept
+{
+  const auto half = std::size_t{ 1 } << (precision - 1);
+  if (index < 2 * half) {
+    return index;
+  }
+  const auto e = index / half - 1;
+  return static_cast<std::uint64_t>(index - e * half) << e;
+}
+
+[[nodiscard]] inline constexpr std::uint64_t histogram_upper(std::size_t index, int precision) noexcept
+{
+  return index + 1 < histogram_buckets(precision) ? histogram_lower(index + 1, precision) - 1 : std::numeric_limits<std::uint64_t>::max();
+}
+
+}  // namespace internal
+
+// Merged counts of a histogram at one point in time.
+template <Duration Duration>
+class histogram_snapshot
+{
+public:
+  using rep = typename Duration::rep;
+
+  histogram_snapshot() = default;
+
+  explicit histogram_snapshot(int precision) : precision_(precision), counts_(internal::histogram_buckets(precision))
+  {}
+
+  [[nodiscard]] int precision() const noexcept
+  {
+    return precision_;
+  }
+
+  [[nodiscard]] std::uint64_t count() const noexcept
+  {
+    return count_;
+  }
+
+  [[nodiscard]] Duration min() const noexcept
+  {
+    return count_ ? Duration{ static_cast<rep>(min_) } : Duration::zero();
+  }
+
+  [[nodiscard]] Duration max() const noexcept
+  {
+    return Duration{ static_cast<rep>(max_) };
+  }
+
+  [[nodiscard]] Duration mean() const noexcept
+  {
+    return count_ ? Duration{ static_cast<rep>(sum_ / count_) } : Duration::zero();
+  }
+
+  // Returns the highest value equivalent to the value at percentile p in [0, 100], clamped to [min(), max()].
+  [[nodiscard]] Duration percentile(double p) const noexcept
+  {
+    if (count_ == 0) {
+      return Duration::zero();
+    }
+    const auto rank = std::max<std::uint64_t>(static_cast<std::uint64_t>(std::ceil(std::clamp(p, 0.0, 100.0) / 100.0 * static_cast<double>(count_))), 1);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < counts_.size(); i++) {
+      seen += counts_[i];
+      if (seen >= rank) {
+        return Duration{ static_cast<rep>(std::clamp(internal::histogram_upper(i, precision_), min_, max_)) };
+      }
+    }
+    return max();
+  }
+
+  // Bucket counts indexed like the histogram. The bucket of a value is returned by bucket.
+  [[nodiscard]] const std::vector<std::uint64_t>& counts() const noexcept
+  {
+    return counts_;
+  }
+
+  [[nodiscard]] std::size_t bucket(Duration d) const noexcept
+  {
+    return internal::histogram_index(d > Duration::zero() ? static_cast<std::uint64_t>(d.count()) : 0, precision_);
+  }
+
+  // Adds the counts of another snapshot with the same precision.
+  histogram_snapshot& operator+=(const histogram_snapshot& other) noexcept
+  {
+    for (std::size_t i = 0; i < counts_.size() && i < other.counts_.size(); i++) {
+      counts_[i] += other.counts_[i];
+    }
+    if (other.count_) {
+      min_ = count_ ? std::min(min_, other.min_) : other.min_;
+      max_ = std::max(max_, other.max_);
+    }
+    count_ += other.count_;
+    sum_ += other.sum_;
+    return *this;
+  }
+
+private:
+  template <dtz::Duration D>
+    requires std::integral<typename D::rep>
+  friend class histogram;
+
+  int precision_ = 0;
+  std::uint64_t count_ = 0;
+  std::uint64_t sum_ = 0;
+  std::uint64_t min_ = 0;
+  std::uint64_t max_ = 0;
+  std::vector<std::uint64_t> counts_;
+};
+
+// Concurrent latency histogram with HDR buckets.
+//
+// The first threads that record get their own shard of counters, allocated on their first record.
+// Only the owning thread writes a shard, so record is a few relaxed loads and stores without locks or
+// read-modify-write instructions. Shards belong to thread indices, which exiting threads give back, so
+// thread pools and short-lived threads reuse them. Threads beyond the configured number of concurrent
+// threads share one shard that is updated with atomic increments and counted by shared_count. Reads
+// merge all shards. Negative durations are recorded as zero.
+template <Duration Duration>
+  requires std::integral<typename Duration::rep>
+class histogram
+{
+public:
+  // The precision is the number of significant bits of a recorded value (2 to 16). The default of 7
+  // bits limits the error of percentiles to 1/64 of their value with about 29 KiB of counters per shard.
+  explicit histogram(int precision = 7, std::size_t threads = 256) :
+    precision_(std::clamp(precision, 2, 16)), buckets_(internal::histogram_buckets(precision_)), threads_(threads),
+    shards_(std::make_unique<shard[]>(threads + 1))
+  {
+    allocate(shards_[threads_]);
+  }
+
+  histogram(const histogram& other) = delete;
+  histogram& operator=(const histogram& other) = delete;
+
+  ~histogram()
+  {
+    for (std::size_t i = 0; i <= threads_; i++) {
+      delete[] shards_[i].counts.load(std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] int precision() const noexcept
+  {
+    return precision_;
+  }
+
+  void record(Duration d, std::uint64_t count = 1)
+  {
+    const auto value = d > Duration::zero() ? static_cast<std::uint64_t>(d.count()) : 0;
+    const auto index = internal::histogram_index(value, precision_);
+    const auto thread = internal::thread_index();
+    if (thread < threads_) {
+      auto& s = shards_[thread];
+      auto counts = s.counts.load(std::memory_order_relaxed);
+      if (!counts) {
+        counts = allocate(s);
+      }
+      counts[index].store(counts[index].load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+      s.sum.store(s.sum.load(std::memory_order_relaxed) + value * count, std::memory_order_relaxed);
+      if (value > s.max.load(std::memory_order_relaxed)) {
+        s.max.store(value, std::memory_order_relaxed);
+      }
+      if (value < s.min.load(std::memory_order_relaxed)) {
+        s.min.store(value, std::memory_order_relaxed);
+      }
+      return;
+    }
+    auto& s = shards_[threads_];
+    s.counts.load(std::memory_order_relaxed)[index].fetch_add(count, std::memory_order_relaxed);
+    s.sum.fetch_add(value * count, std::memory_order_relaxed);
+    for (auto max = s.max.load(std::memory_order_relaxed); value > max;) {
+      s.max.compare_exchange_weak(max, value, std::memory_order_relaxed);
+    }
+    for (auto min = s.min.load(std::memory_order_relaxed); value < min;) {
+      s.min.compare_exchange_weak(min, value, std::memory_order_relaxed);
+    }
+  }
+
+  // Returns the number of values recorded on the shared shard by threads without their own shard. A
+  // growing count means that more threads record at the same time than the histogram has shards for.
+  [[nodiscard]] std::uint64_t shared_count() const noexcept
+  {
+    const auto counts = shards_[threads_].counts.load(std::memory_order_relaxed);
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < buckets_; i++) {
+      result += counts[i].load(std::memory_order_relaxed);
+    }
+    return result;
+  }
+
+  // Merges all shards. Values recorded concurrently may or may not be included.
+  [[nodiscard]] histogram_snapshot<Duration> read() const
+  {
+    histogram_snapshot<Duration> result{ precision_ };
+    result.min_ = std::numeric_limits<std::uint64_t>::max();
+    for (std::size_t i = 0; i <= threads_; i++) {
+      const auto& s = shards_[i];
+      const auto counts = s.counts.load(std::memory_order_acquire);
+      if (!counts) {
+        continue;
+      }
+      for (std::size_t j = 0; j < buckets_; j++) {
+        const auto n = counts[j].load(std::memory_order_relaxed);
+        result.counts_[j] += n;
+        result.count_ += n;
+      }
+      result.sum_ += s.sum.load(std::memory_order_relaxed);
+      result.min_ = std::min(result.min_, s.min.load(std::memory_order_relaxed));
+      result.max_ = std::max(result.max_, s.max.load(std::memory_order_relaxed));
+    }
+    if (result.count_ == 0) {
+      result.min_ = 0;
+    }
+    return result;
+  }
+
+  // Clears all counters. Must not be called while other threads record.
+  void reset() noexcept
+  {
+    for (std::size_t i = 0; i <= threads_; i++) {
+      auto& s = shards_[i];
+      if (const auto counts = s.counts.load(std::memory_order_relaxed)) {
+        for (std::size_t j = 0; j < buckets_; j++) {
+          counts[j].store(0, std::memory_order_relaxed);
+        }
+      }
+      s.sum.store(0, std::memory_order_relaxed);
+      s.min.store(std::numeric_limits<std::uint64_t>::max(), std::memory_order_relaxed);
+      s.max.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  struct alignas(64) shard
+  {
+    std::atomic<std::atomic<std::uint64_t>*> counts{ nullptr };
+    std::atomic<std::uint64_t> sum{ 0 };
+    std::atomic<std::uint64_t> min{ std::numeric_limits<std::uint64_t>::max() };
+    std::atomic<std::uint64_t> max{ 0 };
+  };
+
+  std::atomic<std::uint64_t>* allocate(shard& s)
+  {
+    const auto counts = new std::atomic<std::uint64_t>[buckets_]{};
+    s.counts.store(counts, std::memory_order_release);
+    return counts;
+  }
+
+  int precision_ = 7;
+  std::size_t buckets_ = 0;
+  std::size_t threads_ = 0;
+  std::unique_ptr<shard[]> shards_;
+};
+
+// Writes "count=N min=D mean=D p50=D p90=D p99=D p99.9=D max=D" with durations formatted like format_to.
+template <std::output_iterator<char> OutputIt, Duration Duration>
+inline OutputIt format_to(OutputIt out, const histogram_snapshot<Duration>& snapshot)
+{
+  out = internal::write(out, "count=");
+  out = internal::write<1>(out, snapshot.count());
+  out = internal::write(out, " min=");
+  out = dtz::format_to(out, snapshot.min());
+  out = internal::write(out, " mean=");
+  out = dtz::format_to(out, snapshot.mean());
+  out = internal::write(out, " p50=");
+  out = dtz::format_to(out, snapshot.percentile(50.0));
+  out = internal::write(out, " p90=");
+  out = dtz::format_to(out, snapshot.percentile(90.0));
+  out = internal::write(out, " p99=");
+  out = dtz::format_to(out, snapshot.percentile(99.0));
+  out = internal::write(out, " p99.9=");
+  out = dtz::format_to(out, snapshot.percentile(99.9));
+  out = internal::write(out, " max=");
+  return dtz::format_to(out, snapshot.max());
+}
+
+template <Duration Duration>
+inline std::string format(const histogram_snapshot<Duration>& snapshot)
+{
+  std::string result;
+  dtz::format_to(std::back_inserter(result), snapshot);
+  return result;
+}
+
+}  // namespace dtz
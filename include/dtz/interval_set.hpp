@@ -0,0 +1,428 @@
+#pragma once
+#include "chrono.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+namespace dtz {
+
+// Half-open interval [begin, end) of time points or local times.
+template <TimePointOrLocalTime TimePointOrLocalTime>
+struct interval
+{
+  using time_point = TimePointOrLocalTime;
+  using duration = typename TimePointOrLocalTime::duration;
+
+  time_point begin{};
+  time_point end{};
+
+  [[nodiscard]] constexpr bool empty() const noexcept
+  {
+    return !(begin < end);
+  }
+
+  [[nodiscard]] constexpr duration length() const noexcept
+  {
+    return empty() ? duration::zero() : end - begin;
+  }
+
+  [[nodiscard]] constexpr bool contains(time_point tp) const noexcept
+  {
+    return begin <= tp && tp < end;
+  }
+
+  // Returns true if both intervals contain a common time point.
+  [[nodiscard]] constexpr bool overlaps(const interval& other) const noexcept
+  {
+    return begin < other.end && other.begin < end && !empty() && !other.empty();
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const interval& lhs, const interval& rhs) noexcept = default;
+};
+
+// Set of time points stored as sorted, disjoint and non-adjacent intervals in a vector. Inserted
+// intervals are coalesced with the intervals they overlap or touch.
+template <TimePointOrLocalTime TimePointOrLocalTime>
+class interval_set
+{
+public:
+  using time_point = TimePointOrLocalTime;
+  using duration = typename TimePointOrLocalTime::duration;
+  using value_type = interval<TimePointOrLocalTime>;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+  using iterator = const_iterator;
+
+  interval_set() noexcept = default;
+
+  interval_set(std::initializer_list<value_type> intervals)
+  {
+    for (const auto& i : intervals) {
+      insert(i);
+    }
+  }
+
+  // Adds every time point of the interval.
+  void insert(const value_type& i)
+  {
+    if (i.empty()) {
+      return;
+    }
+    // Intervals that overlap or touch i are [first, last).
+    const auto first = std::lower_bound(intervals_.begin(), intervals_.end(), i.begin, [](const value_type& v, time_point tp) {
+      return v.end < tp;
+    });
+    const auto last = std::upper_bound(first, intervals_.end(), i.end, [](time_point tp, const value_type& v) {
+      return tp < v.begin;
+    });
+    if (first == last) {
+      intervals_.insert(first, i);
+      return;
+    }
+    first->begin = std::min(first->begin, i.begin);
+    first->end = std::max((last - 1)->end, i.end);
+    intervals_.erase(first + 1, last);
+  }
+
+  // Removes every time point of the interval.
+  void erase(const value_type& i)
+  {
+    if (i.empty()) {
+      return;
+    }
+    // Intervals that overlap i are [first, last).
+    auto first = std::upper_bound(intervals_.begin(), intervals_.end(), i.begin, [](time_point tp, const value_type& v) {
+      return tp < v.end;
+    });
+    const auto last = std::lower_bound(first, intervals_.end(), i.end, [](const value_type& v, time_point tp) {
+      return v.begin < tp;
+    });
+    if (first == last) {
+      return;
+    }
+    const auto head = value_type{ first->begin, i.begin };
+    const auto tail = value_type{ i.end, (last - 1)->end };
+    first = intervals_.erase(first, last);
+    if (!tail.empty()) {
+      first = intervals_.insert(first, tail);
+    }
+    if (!head.empty()) {
+      intervals_.insert(first, head);
+    }
+  }
+
+  void clear() noexcept
+  {
+    intervals_.clear();
+  }
+
+  // Returns the interval that contains tp or end().
+  [[nodiscard]] const_iterator find(time_point tp) const noexcept
+  {
+    const auto it = std::upper_bound(intervals_.begin(), intervals_.end(), tp, [](time_point tp, const value_type& v) {
+      return tp < v.end;
+    });
+    return it != intervals_.end() && it->begin <= tp ? it : intervals_.end();
+  }
+
+  [[nodiscard]] bool contains(time_point tp) const noexcept
+  {
+    return find(tp) != intervals_.end();
+  }
+
+  // Returns true if every time point of the interval is in the set.
+  [[nodiscard]] bool contains(const value_type& i) const noexcept
+  {
+    if (i.empty()) {
+      return true;
+    }
+    const auto it = find(i.begin);
+    return it != intervals_.end() && i.end <= it->end;
+  }
+
+  [[nodiscard]] bool overlaps(const value_type& i) const noexcept
+  {
+    const auto it = std::upper_bound(intervals_.begin(), intervals_.end(), i.begin, [](time_point tp, const value_type& v) {
+      return tp < v.end;
+    });
+    return !i.empty() && it != intervals_.end() && it->begin < i.end;
+  }
+
+  // Returns the sum of the interval lengths.
+  [[nodiscard]] duration length() const noexcept
+  {
+    auto result = duration::zero();
+    for (const auto& i : intervals_) {
+      result += i.length();
+    }
+    return result;
+  }
+
+  [[nodiscard]] const_iterator begin() const noexcept
+  {
+    return intervals_.begin();
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept
+  {
+    return intervals_.end();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return intervals_.size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return intervals_.empty();
+  }
+
+  [[nodiscard]] const value_type& operator[](std::size_t index) const noexcept
+  {
+    return intervals_[index];
+  }
+
+  // Union, intersection and difference in one pass over both sets.
+
+  [[nodiscard]] friend interval_set operator|(const interval_set& lhs, const interval_set& rhs)
+  {
+    interval_set result;
+    result.intervals_.reserve(lhs.size() + rhs.size());
+    auto l = lhs.begin();
+    auto r = rhs.begin();
+    while (l != lhs.end() || r != rhs.end()) {
+      const auto& i = r == rhs.end() || (l != lhs.end() && l->begin < r->begin) ? *l++ : *r++;
+      if (!result.intervals_.empty() && !(result.intervals_.back().end < i.begin)) {
+        result.intervals_.back().end = std::max(result.intervals_.back().end, i.end);
+      } else {
+        result.intervals_.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend interval_set operator&(const interval_set& lhs, const interval_set& rhs)
+  {
+    interval_set result;
+    auto l = lhs.begin();
+    auto r = rhs.begin();
+    while (l != lhs.end() && r != rhs.end()) {
+      const auto i = value_type{ std::max(l->begin, r->begin), std::min(l->end, r->end) };
+      if (!i.empty()) {
+        result.intervals_.push_back(i);
+      }
+      if (l->end < r->end) {
+        ++l;
+      } else {
+        ++r;
+      }
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend interval_set operator-(const interval_set& lhs, const interval_set& rhs)
+  {
+    interval_set result;
+    auto r = rhs.begin();
+    for (auto i : lhs) {
+      while (r != rhs.end() && !(i.begin < r->end)) {
+        ++r;
+      }
+      for (auto s = r; s != rhs.end() && s->begin < i.end; ++s) {
+        if (i.begin < s->begin) {
+          result.intervals_.push_back({ i.begin, s->begin });
+        }
+        i.begin = s->end;
+      }
+      if (!i.empty()) {
+        result.intervals_.push_back(i);
+      }
+    }
+    return result;
+  }
+
+  interval_set& operator|=(const interval_set& other)
+  {
+    return *this = *this | other;
+  }
+
+  interval_set& operator&=(const interval_set& other)
+  {
+    return *this = *this & other;
+  }
+
+  interval_set& operator-=(const interval_set& other)
+  {
+    return *this = *this - other;
+  }
+
+  [[nodiscard]] friend bool operator==(const interval_set& lhs, const interval_set& rhs) noexcept = default;
+
+private:
+  std::vector<value_type> intervals_;
+};
+
+// Static index of possibly overlapping intervals with a value each, for stabbing and overlap queries
+// in O(log n + k) for k results.
+//
+// Entries are sorted by begin in one vector that is also an implicit binary search tree: the node at
+// index i has level l for l trailing one bits and its children at i -/+ 2^(l - 1). Each node keeps the
+// maximum end of its subtree, so queries skip subtrees that end before the query. There are no node
+// allocations and small subtrees are scanned linearly.
+template <TimePointOrLocalTime TimePointOrLocalTime, typename T = std::size_t>
+class interval_index
+{
+public:
+  using time_point = TimePointOrLocalTime;
+  using interval = dtz::interval<TimePointOrLocalTime>;
+
+  struct entry
+  {
+    interval range;
+    T value{};
+  };
+
+  interval_index() = default;
+
+  // Builds the index. Empty intervals are left out since no query matches them.
+  explicit interval_index(std::vector<entry> entries) : entries_(std::move(entries))
+  {
+    std::erase_if(entries_, [](const entry& e) { return e.range.empty(); });
+    std::sort(entries_.begin(), entries_.end(), [](const entry& lhs, const entry& rhs) {
+      return lhs.range.begin < rhs.range.begin;
+    });
+    build();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return entries_.size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return entries_.empty();
+  }
+
+  // Entries in order of their begin.
+  [[nodiscard]] const std::vector<entry>& entries() const noexcept
+  {
+    return entries_;
+  }
+
+  // Calls f(entry) for every entry that contains tp, in order of their begin.
+  template <typename F>
+  void stab(time_point tp, F f) const
+  {
+    query(tp, [&](time_point begin) { return begin <= tp; }, f);
+  }
+
+  // Calls f(entry) for every entry that overlaps i, in order of their begin.
+  template <typename F>
+  void overlap(const interval& i, F f) const
+  {
+    if (!i.empty()) {
+      query(i.begin, [&](time_point begin) { return begin < i.end; }, f);
+    }
+  }
+
+  [[nodiscard]] std::vector<entry> stab(time_point tp) const
+  {
+    std::vector<entry> result;
+    stab(tp, [&](const entry& e) { result.push_back(e); });
+    return result;
+  }
+
+  [[nodiscard]] std::vector<entry> overlap(const interval& i) const
+  {
+    std::vector<entry> result;
+    overlap(i, [&](const entry& e) { result.push_back(e); });
+    return result;
+  }
+
+private:
+  // Subtrees up to this level are scanned linearly.
+  static constexpr int scan_level = 3;
+
+  void build()
+  {
+    const auto n = entries_.size();
+    max_.resize(n);
+    if (n == 0) {
+      return;
+    }
+    std::size_t last_i = 0;
+    time_point last{};
+    for (std::size_t i = 0; i < n; i += 2) {
+      last_i = i;
+      last = max_[i] = entries_[i].range.end;
+    }
+    int k = 1;
+    for (; (std::size_t{ 1 } << k) <= n; k++) {
+      const auto x = std::size_t{ 1 } << (k - 1);
+      for (auto i = (x << 1) - 1; i < n; i += x << 2) {
+        const auto left = max_[i - x];
+        const auto right = i + x < n ? max_[i + x] : last;
+        max_[i] = std::max({ entries_[i].range.end, left, right });
+      }
+      last_i = (last_i >> k & 1) ? last_i - x : last_i + x;
+      if (last_i < n && max_[last_i] > last) {
+        last = max_[last_i];
+      }
+    }
+    level_ = k - 1;
+  }
+
+  // Visits entries with end > low and begin matching the predicate. Entries are ordered by begin, so
+  // the predicate holds for a prefix of every subtree.
+  template <typename Begin, typename F>
+  void query(time_point low, Begin before, F& f) const
+  {
+    const auto n = entries_.size();
+    if (n == 0) {
+      return;
+    }
+    struct node
+    {
+      std::size_t x;
+      int k;
+      bool right;
+    };
+    node stack[64];
+    int t = 0;
+    stack[t++] = { (std::size_t{ 1 } << level_) - 1, level_, false };
+    while (t) {
+      const auto z = stack[--t];
+      if (z.k <= scan_level) {
+        const auto first = z.x >> z.k << z.k;
+        const auto last = std::min(first + (std::size_t{ 1 } << (z.k + 1)) - 1, n);
+        for (auto i = first; i < last && before(entries_[i].range.begin); i++) {
+          if (low < entries_[i].range.end) {
+            f(entries_[i]);
+          }
+        }
+      } else if (!z.right) {
+        // Visit the node and its right subtree after the left subtree.
+        const auto y = z.x - (std::size_t{ 1 } << (z.k - 1));
+        stack[t++] = { z.x, z.k, true };
+        if (y >= n || low < max_[y]) {
+          stack[t++] = { y, z.k - 1, false };
+        }
+      } else if (z.x < n && before(entries_[z.x].range.begin)) {
+        if (low < entries_[z.x].range.end) {
+          f(entries_[z.x]);
+        }
+        stack[t++] = { z.x + (std::size_t{ 1 } << (z.k - 1)), z.k - 1, false };
+      }
+    }
+  }
+
+  std::vector<entry> entries_;
+  std::vector<time_point> max_;
+  int level_ = 0;
+};
+
+}  // namespace dtz
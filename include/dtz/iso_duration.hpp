@@ -0,0 +1,260 @@
+#pragma once
+#include "chrono.hpp"
+#include "error.hpp"
+#include "format.hpp"
+#include "parse.hpp"
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+namespace dtz {
+
+// Upper bound for every duration formatted by format_iso_duration_to.
+inline constexpr std::size_t iso_duration_buffer_size = 48;
+
+namespace internal {
+
+template <typename Period, typename Unit>
+inline constexpr bool is_multiple_of = std::ratio_divide<Period, Unit>::den == 1;
+
+// Writes a component like "12H" unless it is zero.
+template <std::output_iterator<char> OutputIt, std::integral Integral>
+inline constexpr OutputIt write_component(OutputIt out, Integral value, char designator) noexcept
+{
+  if (value != 0) {
+    out = write<1>(out, value);
+    *out++ = designator;
+  }
+  return out;
+}
+
+template <typename Period>
+using unsigned_duration = duration<std::uint64_t, Period>;
+
+// Returns the absolute value of a count, which is also defined for the minimum of its rep.
+template <std::integral Integral>
+inline constexpr std::uint64_t magnitude(Integral value) noexcept
+{
+  const auto u = static_cast<std::uint64_t>(value);
+  return value < 0 ? 0 - u : u;
+}
+
+// Adds a component in Unit to result, or subtracts it if negative. Returns false if the count or the
+// result does not fit in Duration. Negative results reach Duration::min(), which has no positive
+// counterpart.
+template <typename Unit, Duration Duration>
+inline constexpr bool add_component(Duration& result, std::uint64_t count, bool negative) noexcept
+{
+  // The count is converted with the rep of Duration because the rep of Unit may be as small as int.
+  using Rep = typename Duration::rep;
+  using Ratio = std::ratio_divide<typename Unit::period, typename Duration::period>;
+  constexpr auto max = static_cast<std::uint64_t>(std::numeric_limits<Rep>::max());
+  if (count > (negative ? max + 1 : max) / static_cast<std::uint64_t>(Ratio::num)) {
+    return false;
+  }
+  // Negating in unsigned arithmetic is defined for the magnitude of the minimum.
+  const auto value = cast<Duration>(duration<Rep, typename Unit::period>{ static_cast<Rep>(negative ? 0 - count : count) });
+  if (negative ? value < Duration::min() - result : value > Duration::max() - result) {
+    return false;
+  }
+  result += value;
+  return true;
+}
+
+// Parses "[-]P[nY][nM][nW][nD][T[nH][nM][n[.f]S]]". Years and months have the average lengths of the
+// years and months durations. Components are converted to Duration one by one and truncated. Only
+// durations with an integral rep are supported.
+template <Duration Duration>
+inline constexpr errc parse_iso_duration(std::string_view str, Duration& result) noexcept
+{
+  const char* cur = str.data();
+  const char* const end = cur + str.size();
+  const auto negative = cur != end && *cur == '-';
+  if (cur != end && (*cur == '-' || *cur == '+')) {
+    ++cur;
+  }
+  if (cur == end || *cur++ != 'P') {
+    return errc::invalid_format;
+  }
+
+  // Components must appear in this order and at most once: Y M W D T H M S.
+  Duration d{};
+  auto rank = 0;
+  while (cur != end) {
+    if (*cur == 'T') {
+      if (rank >= 5) {
+        return errc::invalid_format;
+      }
+      rank = 5;
+      ++cur;
+      continue;
+    }
+    // Up to 19 digits fit in 64 bits.
+    const char* const digits = cur;
+    std::uint64_t value = 0;
+    for (; cur != end && static_cast<unsigned>(*cur - '0') < 10; ++cur) {
+      value = value * 10 + static_cast<unsigned>(*cur - '0');
+    }
+    if (cur == digits || cur - digits > 19) {
+      return errc::invalid_format;
+    }
+    std::uint64_t fraction = 0;
+    const auto has_fraction = cur != end && (*cur == '.' || *cur == ',');
+    if (has_fraction) {
+      // Digits after nanoseconds are ignored.
+      const char* const first = ++cur;
+      for (; cur != end && static_cast<unsigned>(*cur - '0') < 10; ++cur) {
+        if (cur - first < 9) {
+          fraction = fraction * 10 + static_cast<unsigned>(*cur - '0');
+        }
+      }
+      if (cur == first) {
+        return errc::invalid_subseconds_format;
+      }
+      for (auto i = cur - first; i < 9; i++) {
+        fraction *= 10;
+      }
+    }
+    if (cur == end) {
+      return errc::invalid_format;
+    }
+    // Components are added before their order is checked because errors discard the result.
+    auto next = 0;
+    auto valid = true;
+    switch (*cur++) {
+    case 'Y':
+      next = 1;
+      valid = add_component<years>(d, value, negative);
+      break;
+    case 'M':
+      next = rank < 5 ? 2 : 7;
+      valid = rank < 5 ? add_component<months>(d, value, negative) : add_component<minutes>(d, value, negative);
+      break;
+    case 'W':
+      next = 3;
+      valid = add_component<weeks>(d, value, negative);
+      break;
+    case 'D':
+      next = 4;
+      valid = add_component<days>(d, value, negative);
+      break;
+    case 'H':
+      next = 6;
+      valid = add_component<hours>(d, value, negative);
+      break;
+    case 'S':
+      next = 8;
+      valid = add_component<seconds>(d, value, negative) && add_component<nanoseconds>(d, fraction, negative);
+      break;
+    }
+    if (!valid || next <= rank || (rank < 5) != (next < 5) || (has_fraction && next != 8)) {
+      return errc::invalid_format;
+    }
+    rank = next;
+  }
+  if (rank == 0 || rank == 5) {
+    return errc::invalid_format;
+  }
+  result = d;
+  return {};
+}
+
+}  // namespace internal
+
+// Writes a duration in the ISO 8601 format like "P1Y2M", "P3W", "P3DT4H30M" or "PT0.250S" with a leading
+// '-' for negative durations. Durations of whole months, weeks or days are written in these units. Other
+// durations are written in days and time of day with the fraction digits of write_time. Only durations
+// with an integral rep are supported.
+template <std::output_iterator<char> OutputIt, Duration Duration>
+  requires std::integral<typename Duration::rep>
+inline constexpr OutputIt format_iso_duration_to(OutputIt out, const Duration& duration)
+{
+  // Components are computed from the magnitude in unsigned 64-bit counts, which hold the magnitude of
+  // Duration::min() and do not overflow when the unit has a smaller rep like the int of date::years.
+  using Period = typename Duration::period;
+  using Rep = typename Duration::rep;
+  using internal::unsigned_duration;
+  if (duration < Duration{ 0 }) {
+    *out++ = '-';
+  }
+  *out++ = 'P';
+  const auto d = unsigned_duration<Period>{ internal::magnitude(duration.count()) };
+  if constexpr (internal::is_multiple_of<Period, months::period>) {
+    const auto y = cast<unsigned_duration<years::period>>(d);
+    const auto m = cast<unsigned_duration<months::period>>(d - y).count();
+    out = internal::write_component(out, y.count(), 'Y');
+    if (m != 0 || y.count() == 0) {
+      out = internal::write<1>(out, m);
+      *out++ = 'M';
+    }
+  } else if constexpr (internal::is_multiple_of<Period, weeks::period>) {
+    out = internal::write<1>(out, cast<unsigned_duration<weeks::period>>(d).count());
+    *out++ = 'W';
+  } else if constexpr (internal::is_multiple_of<Period, days::period>) {
+    out = internal::write<1>(out, cast<unsigned_duration<days::period>>(d).count());
+    *out++ = 'D';
+  } else {
+    const auto dd = cast<unsigned_duration<days::period>>(d);
+    const auto h = cast<unsigned_duration<hours::period>>(d - dd);
+    const auto m = cast<unsigned_duration<minutes::period>>(d - dd - h);
+    const auto s = cast<unsigned_duration<seconds::period>>(d - dd - h - m);
+    const auto f = (d - dd - h - m - s).count();
+    out = internal::write_component(out, dd.count(), 'D');
+    if (d == dd && dd.count() != 0) {
+      return out;
+    }
+    *out++ = 'T';
+    out = internal::write_component(out, h.count(), 'H');
+    out = internal::write_component(out, m.count(), 'M');
+    if (s.count() != 0 || f != 0 || d.count() == 0) {
+      out = internal::write<1>(out, s.count());
+      if constexpr (FormatDuration<Rep, Period, seconds::period>) {
+        if (f != 0) {
+          *out++ = '.';
+          const auto fraction = unsigned_duration<Period>{ f };
+          if constexpr (FormatDuration<Rep, Period, microseconds::period>) {
+            out = internal::write<9>(out, cast<unsigned_duration<nanoseconds::period>>(fraction).count());
+          } else if constexpr (FormatDuration<Rep, Period, milliseconds::period>) {
+            out = internal::write<6>(out, cast<unsigned_duration<microseconds::period>>(fraction).count());
+          } else {
+            out = internal::write<3>(out, cast<unsigned_duration<milliseconds::period>>(fraction).count());
+          }
+        }
+      }
+      *out++ = 'S';
+    }
+  }
+  return out;
+}
+
+template <Duration Duration>
+  requires std::integral<typename Duration::rep>
+[[nodiscard]] inline constexpr Duration parse_iso_duration(std::string_view str, std::error_code& ec) noexcept
+{
+  Duration result{};
+  if (const auto e = internal::parse_iso_duration(str, result); e != errc{}) {
+    ec = std::make_error_code(e);
+    return {};
+  }
+  return result;
+}
+
+template <Duration Duration>
+  requires std::integral<typename Duration::rep>
+[[nodiscard]] inline Duration parse_iso_duration(std::string_view str)
+{
+  std::error_code ec;
+  const auto result = parse_iso_duration<Duration>(str, ec);
+  if (ec) {
+    throw std::system_error(ec, "duration parse error for \"" + std::string{ str } + "\"");
+  }
+  return result;
+}
+
+}  // namespace dtz
@@ -1,14 +1,48 @@
 #pragma once
 #include "chrono.hpp"
 #include "error.hpp"
+#include <algorithm>
 #include <charconv>
+#include <concepts>
+#include <limits>
 #include <string>
 #include <system_error>
 
 namespace dtz {
+namespace internal {
+
+// Constexpr replacement for std::from_chars with base 10.
+template <std::integral Integral>
+inline constexpr std::from_chars_result from_chars(const char* beg, const char* end, Integral& value) noexcept
+{
+  const char* cur = beg;
+  bool negative = false;
+  if constexpr (std::is_signed_v<Integral>) {
+    if (cur != end && *cur == '-') {
+      negative = true;
+      ++cur;
+    }
+  }
+  const char* const digits = cur;
+  using Unsigned = std::make_unsigned_t<Integral>;
+  constexpr auto max = static_cast<Unsigned>(std::numeric_limits<Integral>::max());
+  Unsigned result = 0;
+  for (; cur != end && *cur >= '0' && *cur <= '9'; ++cur) {
+    const auto digit = static_cast<Unsigned>(*cur - '0');
+    if (result > (max - digit) / 10) {
+      return { cur, std::errc::result_out_of_range };
+    }
+    result = static_cast<Unsigned>(result * 10 + digit);
+  }
+  if (cur == digits) {
+    return { beg, std::errc::invalid_argument };
+  }
+  value = negative ? static_cast<Integral>(0 - result) : static_cast<Integral>(result);
+  return { cur, std::errc{} };
+}
 
 template <Duration Duration>
-[[nodiscard]] inline Duration parse(std::string_view str, std::error_code& ec) noexcept
+inline constexpr errc parse(std::string_view str, Duration& result) noexcept
 {
   using Period = typename Duration::period;
 
@@ -17,24 +51,23 @@ template <Duration Duration>
 
   // Parse negative sign.
   bool negative = false;
-  if (*beg == '-') {
+  if (beg != end && *beg == '-') {
     negative = true;
     ++beg;
   }
 
   // Parse hours.
-  hours::rep hv;  // NOLINT: Will be set by from_chars or not used on error.
-  if (const auto [cur, err] = std::from_chars(beg, end, hv);
-      err != std::errc{} || cur == end || *cur != ':')
+  hours::rep hv = 0;
+  if (const auto [cur, err] = from_chars(beg, end, hv);
+      err != std::errc{} || hv < 0 || cur == end || *cur != ':')
   {
-    ec = std::make_error_code(errc::invalid_hours_format);
-    return {};
+    return errc::invalid_hours_format;
   } else {
     beg = cur + 1;
   }
 
   // Use absolute hours to initialize result.
-  auto result = cast<Duration>(hours{ hv });
+  result = cast<Duration>(hours{ hv });
 
   // Get remaining string length.
   const auto size = end - beg;
@@ -42,20 +75,19 @@ template <Duration Duration>
   if constexpr (std::ratio_less_v<Period, hours::period>) {
     if (size > 1) {
       // Parse minutes.
-      minutes::rep mv;  // NOLINT: Will be set by from_chars or not used on error.
-      if (const auto [cur, err] = std::from_chars(beg, beg + 2, mv);
+      minutes::rep mv = 0;
+      if (const auto [cur, err] = from_chars(beg, beg + 2, mv);
           err != std::errc{} || cur != beg + 2 || mv < 0 || mv > 59)
       {
-        ec = std::make_error_code(errc::invalid_minutes_format);
-        return {};
+        return errc::invalid_minutes_format;
       } else {
         result += minutes{ mv };
         if (cur == end) {
-          return negative ? -result : result;
+          result = negative ? -result : result;
+          return {};
         }
         if (*cur != ':') {
-          ec = std::make_error_code(errc::invalid_format);
-          return {};
+          return errc::invalid_format;
         }
         beg = cur + 1;
       }
@@ -63,20 +95,19 @@ template <Duration Duration>
       if constexpr (std::ratio_less_v<Period, minutes::period>) {
         if (size > 4) {
           // Parse seconds.
-          seconds::rep sv;  // NOLINT: Will be set by from_chars or not used on error.
-          if (const auto [cur, err] = std::from_chars(beg, beg + 2, sv);
+          seconds::rep sv = 0;
+          if (const auto [cur, err] = from_chars(beg, beg + 2, sv);
               err != std::errc{} || cur != beg + 2 || sv < 0 || sv > 59)
           {
-            ec = std::make_error_code(errc::invalid_seconds_format);
-            return {};
+            return errc::invalid_seconds_format;
           } else {
             result += seconds{ sv };
             if (cur == end) {
-              return negative ? -result : result;
+              result = negative ? -result : result;
+              return {};
             }
             if (*cur != '.') {
-              ec = std::make_error_code(errc::invalid_format);
-              return {};
+              return errc::invalid_format;
             }
             beg = cur + 1;
           }
@@ -84,15 +115,11 @@ template <Duration Duration>
           if constexpr (std::ratio_less_v<Period, seconds::period>) {
             if (size > 6) {
               // Parse subseconds.
-              int subseconds;  // NOLINT: Will be set by from_chars or not used on error.
-              if (const auto [cur, err] = std::from_chars(beg, end, subseconds);
-                  err != std::errc{} || subseconds < 0)
+              int subseconds = 0;
+              if (const auto [cur, err] = from_chars(beg, end, subseconds);
+                  err != std::errc{} || subseconds < 0 || cur != end)
               {
-                ec = std::make_error_code(err);
-                return {};
-              } else if (cur != end) {
-                ec = std::make_error_code(errc::invalid_subseconds_format);
-                return {};
+                return errc::invalid_subseconds_format;
               }
               switch (size) {
               case 9:
@@ -105,8 +132,7 @@ template <Duration Duration>
                 result += cast<Duration>(nanoseconds{ subseconds });
                 break;
               default:
-                ec = std::make_error_code(errc::invalid_subseconds_format);
-                return {};
+                return errc::invalid_subseconds_format;
               }
             }
           }
@@ -115,24 +141,14 @@ template <Duration Duration>
     }
   }
 
-  return negative ? -result : result;
-}
-
-template <Duration Duration>
-[[nodiscard]] inline Duration parse(std::string_view str)
-{
-  std::error_code ec;
-  const auto result = parse<Duration>(str, ec);
-  if (ec) {
-    throw std::system_error(ec, "duration parse error for \"" + std::string{ str } + "\"");
-  }
-  return result;
+  result = negative ? -result : result;
+  return {};
 }
 
 template <TimePointOrLocalTime TimePointOrLocalTime>
-[[nodiscard]] inline TimePointOrLocalTime parse(std::string_view str, std::error_code& ec) noexcept
+inline constexpr errc parse(std::string_view str, TimePointOrLocalTime& result) noexcept
 {
-  // TODO: Allow 0000, 0000-00 and 0000-00-00 formats.
+  // TODO: Allow 0000 and 0000-00 formats.
   // TODO: Use time_of_day instead of duration.
   using Duration = typename TimePointOrLocalTime::duration;
   using Period = typename TimePointOrLocalTime::period;
@@ -141,12 +157,11 @@ template <TimePointOrLocalTime TimePointOrLocalTime>
   const char* const end = beg + str.size();
 
   // Parse year.
-  int iy;  // NOLINT: Will be set by from_chars or not used on error.
-  if (const auto [cur, err] = std::from_chars(beg, end, iy);
+  int iy = 0;
+  if (const auto [cur, err] = from_chars(beg, end, iy);
       err != std::errc{} || cur == end || *cur != '-')
   {
-    ec = std::make_error_code(errc::invalid_year_format);
-    return {};
+    return errc::invalid_year_format;
   } else {
     beg = cur + 1;
   }
@@ -154,44 +169,61 @@ template <TimePointOrLocalTime TimePointOrLocalTime>
   // Get remaining string length.
   const auto size = end - beg;
 
-  if (size < 11) {
-    ec = std::make_error_code(errc::invalid_format);
-    return {};
+  if (size != 5 && size < 11) {
+    return errc::invalid_format;
   }
 
   // Parse month.
-  unsigned um;  // NOLINT: Will be set by from_chars or not used on error.
-  if (const auto [cur, err] = std::from_chars(beg, beg + 2, um);
+  unsigned um = 0;
+  if (const auto [cur, err] = from_chars(beg, beg + 2, um);
       err != std::errc{} || cur != beg + 2 || *cur != '-' || um < 1 || um > 12)
   {
-    ec = std::make_error_code(errc::invalid_month_format);
-    return {};
+    return errc::invalid_month_format;
   } else {
     beg = cur + 1;
   }
 
   // Parse day.
-  unsigned ud;  // NOLINT: Will be set by from_chars or not used on error.
-  if (const auto [cur, err] = std::from_chars(beg, beg + 2, ud);
-      err != std::errc{} || cur != beg + 2 || *cur != ' ' || ud < 1 || ud > 31)
+  unsigned ud = 0;
+  if (const auto [cur, err] = from_chars(beg, beg + 2, ud);
+      err != std::errc{} || cur != beg + 2 || (cur != end && *cur != ' ') || ud < 1 || ud > 31)
   {
-    ec = std::make_error_code(errc::invalid_day_format);
-    return {};
+    return errc::invalid_day_format;
   } else {
     beg = cur + 1;
   }
 
   const auto ymd = year{ iy } / month{ um } / day{ ud };
+  if (!ymd.ok()) {
+    return errc::invalid_day_format;
+  }
+
   Duration duration{};
 
+  // Converts the parsed civil time to the requested clock.
+  const auto make_result = [&]() {
+    const auto tp = local_days{ ymd } + duration;
+    if constexpr (LocalTime<TimePointOrLocalTime>) {
+      result = cast<Duration>(tp);
+    } else if constexpr (std::is_same_v<typename TimePointOrLocalTime::clock, system_clock>) {
+      result = TimePointOrLocalTime{ cast<Duration>(tp.time_since_epoch()) };
+    } else {
+      result = cast<Duration>(cast<typename TimePointOrLocalTime::clock>(tp));
+    }
+    return errc{};
+  };
+
+  if (size == 5) {
+    return make_result();
+  }
+
   if constexpr (std::ratio_less_v<Period, days::period>) {
     // Parse hours.
-    hours::rep hv;  // NOLINT: Will be set by from_chars or not used on error.
-    if (const auto [cur, err] = std::from_chars(beg, beg + 2, hv);
+    hours::rep hv = 0;
+    if (const auto [cur, err] = from_chars(beg, beg + 2, hv);
         err != std::errc{} || cur != beg + 2 || *cur != ':' || hv < 0 || hv > 23)
     {
-      ec = std::make_error_code(errc::invalid_hours_format);
-      return {};
+      return errc::invalid_hours_format;
     } else {
       beg = cur + 1;
     }
@@ -200,20 +232,18 @@ template <TimePointOrLocalTime TimePointOrLocalTime>
 
   if constexpr (std::ratio_less_v<Period, hours::period>) {
     // Parse minutes.
-    minutes::rep mv;  // NOLINT: Will be set by from_chars or not used on error.
-    if (const auto [cur, err] = std::from_chars(beg, beg + 2, mv);
+    minutes::rep mv = 0;
+    if (const auto [cur, err] = from_chars(beg, beg + 2, mv);
         err != std::errc{} || cur != beg + 2 || mv < 0 || mv > 59)
     {
-      ec = std::make_error_code(errc::invalid_minutes_format);
-      return {};
+      return errc::invalid_minutes_format;
     } else {
       duration += minutes{ mv };
       if (cur == end) {
-        return cast<TimePointOrLocalTime>(local_days{ ymd }) + duration;
+        return make_result();
       }
       if (*cur != ':') {
-        ec = std::make_error_code(errc::invalid_format);
-        return {};
+        return errc::invalid_format;
       }
       beg = cur + 1;
     }
@@ -222,20 +252,18 @@ template <TimePointOrLocalTime TimePointOrLocalTime>
   if constexpr (std::ratio_less_v<Period, minutes::period>) {
     if (size > 11) {
       // Parse seconds.
-      seconds::rep sv;  // NOLINT: Will be set by from_chars or not used on error.
-      if (const auto [cur, err] = std::from_chars(beg, beg + 2, sv);
+      seconds::rep sv = 0;
+      if (const auto [cur, err] = from_chars(beg, beg + 2, sv);
           err != std::errc{} || cur != beg + 2 || sv < 0 || sv > 60)
       {
-        ec = std::make_error_code(errc::invalid_seconds_format);
-        return {};
+        return errc::invalid_seconds_format;
       } else {
         duration += seconds{ sv };
         if (cur == end) {
-          return cast<TimePointOrLocalTime>(local_days{ ymd }) + duration;
+          return make_result();
         }
         if (*cur != '.') {
-          ec = std::make_error_code(errc::invalid_format);
-          return {};
+          return errc::invalid_format;
         }
         beg = cur + 1;
       }
@@ -243,15 +271,11 @@ template <TimePointOrLocalTime TimePointOrLocalTime>
       if constexpr (std::ratio_less_v<Period, seconds::period>) {
         if (size > 14) {
           // Parse subseconds.
-          int subseconds;  // NOLINT: Will be set by from_chars or not used on error.
-          if (const auto [cur, err] = std::from_chars(beg, end, subseconds);
-              err != std::errc{} || subseconds < 0)
+          int subseconds = 0;
+          if (const auto [cur, err] = from_chars(beg, end, subseconds);
+              err != std::errc{} || subseconds < 0 || cur != end)
           {
-            ec = std::make_error_code(err);
-            return {};
-          } else if (cur != end) {
-            ec = std::make_error_code(errc::invalid_subseconds_format);
-            return {};
+            return errc::invalid_subseconds_format;
           }
           switch (size) {
           case 18:
@@ -264,15 +288,49 @@ template <TimePointOrLocalTime TimePointOrLocalTime>
             duration += cast<Duration>(nanoseconds{ subseconds });
             break;
           default:
-            ec = std::make_error_code(errc::invalid_subseconds_format);
-            return {};
+            return errc::invalid_subseconds_format;
           }
         }
       }
     }
   }
 
-  return cast<TimePointOrLocalTime>(local_days{ ymd }) + duration;
+  return make_result();
+}
+
+}  // namespace internal
+
+template <Duration Duration>
+[[nodiscard]] inline constexpr Duration parse(std::string_view str, std::error_code& ec) noexcept
+{
+  Duration result{};
+  if (const auto e = internal::parse(str, result); e != errc{}) {
+    ec = std::make_error_code(e);
+    return {};
+  }
+  return result;
+}
+
+template <Duration Duration>
+[[nodiscard]] inline Duration parse(std::string_view str)
+{
+  std::error_code ec;
+  const auto result = parse<Duration>(str, ec);
+  if (ec) {
+    throw std::system_error(ec, "duration parse error for \"" + std::string{ str } + "\"");
+  }
+  return result;
+}
+
+template <TimePointOrLocalTime TimePointOrLocalTime>
+[[nodiscard]] inline constexpr TimePointOrLocalTime parse(std::string_view str, std::error_code& ec) noexcept
+{
+  TimePointOrLocalTime result{};
+  if (const auto e = internal::parse(str, result); e != errc{}) {
+    ec = std::make_error_code(e);
+    return {};
+  }
+  return result;
 }
 
 template <TimePointOrLocalTime TimePointOrLocalTime>
@@ -286,20 +344,39 @@ template <TimePointOrLocalTime TimePointOrLocalTime>
   return result;
 }
 
-#if 0
-namespace literals {
+// ====================================================================================================================
+// Compile Time
+// ====================================================================================================================
+
 namespace internal {
 
 template <std::size_t SIZE>
-inline constexpr auto zero() {
-  if constexpr (SIZE == 4) {
-    return years{ 0 };
-  } else if constexpr (SIZE == 7) {
-    return months{ 0 };
-  } else if constexpr (SIZE == 10) {
+struct static_string
+{
+  static_assert(SIZE != 0);
+
+  consteval static_string(const char (&str)[SIZE]) noexcept  // NOLINT: Implicit conversion.
+  {
+    std::copy_n(str, SIZE, value);
+  }
+
+  [[nodiscard]] constexpr std::string_view view() const noexcept
+  {
+    return { value, SIZE - 1 };
+  }
+
+  char value[SIZE]{};
+};
+
+template <std::size_t SIZE>
+inline constexpr bool invalid_size = false;
+
+// Deduces the time point duration type from the literal length without the sign.
+template <std::size_t SIZE>
+inline constexpr auto time_point_zero()
+{
+  if constexpr (SIZE == 10) {
     return days{ 0 };
-  } else if constexpr (SIZE == 13) {
-    return hours{ 0 };
   } else if constexpr (SIZE == 16) {
     return minutes{ 0 };
   } else if constexpr (SIZE == 19) {
@@ -311,96 +388,154 @@ inline constexpr auto zero() {
   } else if constexpr (SIZE == 29) {
     return nanoseconds{ 0 };
   } else {
-    static_assert(false, "invalid time point length");
+    static_assert(invalid_size<SIZE>, "invalid time point length");
   }
 }
 
+// Deduces the duration type from the length of the ":MM[:SS[.fff]]" part in "HH:MM[:SS[.fff]]".
 template <std::size_t SIZE>
-struct parse_traits {
-  using type = decltype(zero<SIZE>());
-};
-
-}  // namespace internal
-
-inline auto operator""_h(const char* str, std::size_t size) {
-  return parse<hours>({ str, size });
-}
-
-inline auto operator""_min(const char* str, std::size_t size) {
-  return parse<minutes>({ str, size });
+inline constexpr auto duration_zero()
+{
+  if constexpr (SIZE == 3) {
+    return minutes{ 0 };
+  } else if constexpr (SIZE == 6) {
+    return seconds{ 0 };
+  } else if constexpr (SIZE == 10) {
+    return milliseconds{ 0 };
+  } else if constexpr (SIZE == 13) {
+    return microseconds{ 0 };
+  } else if constexpr (SIZE == 16) {
+    return nanoseconds{ 0 };
+  } else {
+    static_assert(invalid_size<SIZE>, "invalid duration length");
+  }
 }
 
-inline auto operator""_s(const char* str, std::size_t size) {
-  return parse<seconds>({ str, size });
+inline consteval std::size_t time_point_size(std::string_view str) noexcept
+{
+  return !str.empty() && str.front() == '-' ? str.size() - 1 : str.size();
 }
 
-inline auto operator""_ms(const char* str, std::size_t size) {
-  return parse<milliseconds>({ str, size });
+// Returns the length without the sign for a literal that is only known by its length. The valid lengths
+// are never one apart, so a length one past a valid length has a leading '-'.
+inline consteval std::size_t time_point_size(std::size_t size) noexcept
+{
+  switch (size) {
+  case 11:
+  case 17:
+  case 20:
+  case 24:
+  case 27:
+  case 30:
+    return size - 1;
+  default:
+    return size;
+  }
 }
 
-inline auto operator""_us(const char* str, std::size_t size) {
-  return parse<microseconds>({ str, size });
+inline consteval std::size_t duration_size(std::string_view str) noexcept
+{
+  return str.size() - std::min(str.find(':'), str.size());
 }
 
-inline auto operator""_ns(const char* str, std::size_t size) {
-  return parse<nanoseconds>({ str, size });
+template <typename T>
+inline consteval T parse_literal(std::string_view str)
+{
+  T result{};
+  if (parse(str, result) != errc{}) {
+    throw "invalid literal";  // Not a constant expression, reports the literal at compile time.
+  }
+  return result;
 }
 
-}  // namespace literals
-
 template <std::size_t SIZE>
-inline constexpr auto du(const char(&str)[SIZE]) {
-  return parse<seconds>(str);
-}
+struct parse_traits
+{
+  using type = decltype(time_point_zero<SIZE>());
+};
 
 template <std::size_t SIZE>
-inline constexpr auto lt(const char (&str)[SIZE]) {
-  return parse<local_time<internal::parse_traits<SIZE - 1>::type>>(str);
-}
+struct duration_parse_traits
+{
+  using type = decltype(duration_zero<SIZE>());
+};
+
+}  // namespace internal
 
 template <std::size_t SIZE>
-inline constexpr auto st(const char(&str)[SIZE]) {
-  return parse<sys_time<internal::parse_traits<SIZE - 1>::type>>(str);
+[[nodiscard]] inline consteval auto lt(const char (&str)[SIZE])
+{
+  using duration = typename internal::parse_traits<internal::time_point_size(SIZE - 1)>::type;
+  return internal::parse_literal<local_time<duration>>({ str, SIZE - 1 });
 }
 
 template <std::size_t SIZE>
-inline constexpr auto ut(const char(&str)[SIZE]) {
-  return parse<utc_time<internal::parse_traits<SIZE - 1>::type>>(str);
+[[nodiscard]] inline consteval auto st(const char (&str)[SIZE])
+{
+  using duration = typename internal::parse_traits<internal::time_point_size(SIZE - 1)>::type;
+  return internal::parse_literal<sys_time<duration>>({ str, SIZE - 1 });
 }
 
+namespace literals {
 
-// GCC Only
-template <std::size_t N>
-struct static_string {
-  static_assert(N != 0);
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_h()
+{
+  return internal::parse_literal<hours>(str.view());
+}
 
-  inline constexpr static_string(const char(&arr)[N]) {
-    for (std::size_t i = 0; i < N; ++i) {
-      value[i] = arr[i];
-    }
-  }
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_min()
+{
+  return internal::parse_literal<minutes>(str.view());
+}
 
-  char value[N]{};
-  static constexpr std::size_t size = N;
-};
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_s()
+{
+  return internal::parse_literal<seconds>(str.view());
+}
 
-template <std::size_t N>
-static_string(const char(&)[N])->static_string<N>;
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_ms()
+{
+  return internal::parse_literal<milliseconds>(str.view());
+}
 
-template <static_string>
-struct S {};
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_us()
+{
+  return internal::parse_literal<microseconds>(str.view());
+}
 
-template struct S<"Hello">;
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_ns()
+{
+  return internal::parse_literal<nanoseconds>(str.view());
+}
 
-template <static_string str>
-inline constexpr std::size_t operator""_size() {
-  return decltype(str)::size;
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_dur()
+{
+  using duration = typename internal::duration_parse_traits<internal::duration_size(str.view())>::type;
+  return internal::parse_literal<duration>(str.view());
 }
 
-std::size_t test() {
-  return "Hello"_size;
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_lt()
+{
+  constexpr auto size = internal::time_point_size(str.view());
+  using duration = typename internal::parse_traits<size>::type;
+  return internal::parse_literal<local_time<duration>>(str.view());
 }
 
-#endif
+template <internal::static_string str>
+[[nodiscard]] inline consteval auto operator""_st()
+{
+  constexpr auto size = internal::time_point_size(str.view());
+  using duration = typename internal::parse_traits<size>::type;
+  return internal::parse_literal<sys_time<duration>>(str.view());
+}
 
+}  // namespace literals
 }  // namespace dtz
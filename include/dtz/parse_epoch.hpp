@@ -0,0 +1,208 @@
+#pragma once
+#include "chrono.hpp"
+#include "error.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace dtz {
+namespace internal {
+
+// Loads 8 characters so that the first one is in the lowest byte.
+inline constexpr std::uint64_t load_digits(const char* p) noexcept
+{
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < 8; i++) {
+    value |= std::uint64_t{ static_cast<unsigned char>(p[i]) } << (i * 8);
+  }
+  return value;
+}
+
+// Returns true if every byte of value is a digit.
+inline constexpr bool are_digits(std::uint64_t value) noexcept
+{
+  return ((value & 0xF0F0F0F0F0F0F0F0) | (((value + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+// Converts 8 digits loaded by load_digits by combining pairs of neighbouring digits, then of two-digit
+// and of four-digit numbers with one multiplication each.
+inline constexpr std::uint64_t convert_digits(std::uint64_t value) noexcept
+{
+  value = (value & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+  value = (value & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+  return (value & 0x0000FFFF0000FFFF) * 42949672960001 >> 32;
+}
+
+// Parses up to 19 digits. Returns false if a character is not a digit.
+inline constexpr bool parse_digits(const char* p, std::size_t size, std::uint64_t& result) noexcept
+{
+  std::uint64_t value = 0;
+  for (; size >= 8; size -= 8, p += 8) {
+    const auto digits = load_digits(p);
+    if (!are_digits(digits)) {
+      return false;
+    }
+    value = value * 100'000'000 + convert_digits(digits);
+  }
+  for (; size > 0; size--, p++) {
+    const auto digit = static_cast<unsigned>(*p - '0');
+    if (digit > 9) {
+      return false;
+    }
+    value = value * 10 + digit;
+  }
+  result = value;
+  return true;
+}
+
+// Parses the integer digits [beg, dot) and the fraction after dot in Unit.
+template <typename Unit, Duration Duration>
+inline constexpr errc parse_epoch(const char* beg, const char* dot, const char* end, bool negative, sys_time<Duration>& result) noexcept
+{
+  static_assert(std::is_same_v<Unit, seconds> || std::is_same_v<Unit, milliseconds> || std::is_same_v<Unit, microseconds> ||
+                std::is_same_v<Unit, nanoseconds>);
+
+  const auto size = static_cast<std::size_t>(dot - beg);
+  std::uint64_t value = 0;
+  if (size == 0 || size > 19 || !parse_digits(beg, size, value)) {
+    return errc::invalid_format;
+  }
+  // Values must fit in Duration when it is finer than Unit.
+  constexpr auto max = std::uint64_t{ std::numeric_limits<typename Duration::rep>::max() };
+  constexpr auto scale = std::ratio_less_v<typename Duration::period, typename Unit::period> ? static_cast<std::uint64_t>(cast<Duration>(Unit{ 1 }).count()) : 1;
+  if (value > max / scale) {
+    return errc::invalid_format;
+  }
+
+  // Fraction digits of Unit that are at least one nanosecond. Further digits are ignored.
+  constexpr std::size_t precision = std::is_same_v<Unit, seconds> ? 9 : std::is_same_v<Unit, milliseconds> ? 6 : std::is_same_v<Unit, microseconds> ? 3 : 0;
+  std::uint64_t fraction = 0;
+  if (dot != end) {
+    const auto digits = static_cast<std::size_t>(end - dot - 1);
+    const auto used = digits < precision ? digits : precision;
+    if (digits == 0 || !parse_digits(dot + 1, used, fraction)) {
+      return errc::invalid_subseconds_format;
+    }
+    for (auto cur = dot + 1 + used; cur != end; ++cur) {
+      if (*cur < '0' || *cur > '9') {
+        return errc::invalid_subseconds_format;
+      }
+    }
+    for (auto i = used; i < precision; i++) {
+      fraction *= 10;
+    }
+  }
+
+  // The sum must fit in Duration as well.
+  const auto integer = cast<Duration>(Unit{ static_cast<typename Unit::rep>(value) });
+  const auto fractional = cast<Duration>(nanoseconds{ static_cast<nanoseconds::rep>(fraction) });
+  if (fractional > Duration::max() - integer) {
+    return errc::invalid_format;
+  }
+  const auto tp = integer + fractional;
+  result = sys_time<Duration>{ negative ? -tp : tp };
+  return {};
+}
+
+// Parses "[-]digits[.fraction]" in Unit or in the unit detected from the number of digits if Unit is void.
+template <typename Unit, Duration Duration>
+inline constexpr errc parse_epoch(std::string_view str, sys_time<Duration>& result) noexcept
+{
+  const char* beg = str.data();
+  const char* const end = beg + str.size();
+  const auto negative = beg != end && *beg == '-';
+  if (negative) {
+    ++beg;
+  }
+  const char* const dot = beg + std::min(std::string_view{ beg, end }.find('.'), static_cast<std::size_t>(end - beg));
+
+  if constexpr (std::is_void_v<Unit>) {
+    // Numbers from 10^8 to 10^10 seconds cover 1973 to 2286 and have the same number of digits as
+    // their value in finer units plus 3, 6 or 9.
+    switch (dot - beg) {
+    case 9:
+    case 10:
+      return parse_epoch<seconds>(beg, dot, end, negative, result);
+    case 12:
+    case 13:
+      return parse_epoch<milliseconds>(beg, dot, end, negative, result);
+    case 15:
+    case 16:
+      return parse_epoch<microseconds>(beg, dot, end, negative, result);
+    case 18:
+    case 19:
+      return parse_epoch<nanoseconds>(beg, dot, end, negative, result);
+    default:
+      return errc::invalid_format;
+    }
+  } else {
+    return parse_epoch<Unit>(beg, dot, end, negative, result);
+  }
+}
+
+}  // namespace internal
+
+// Parses a Unix epoch number like "1622550605" or "1622550605123.456" into a sys_time.
+//
+// The unit is Unit or, by default, detected from the number of integer digits: 9 or 10 digits are
+// seconds (1973 to 2286) and 12 to 13, 15 to 16 and 18 to 19 digits are milliseconds, microseconds and
+// nanoseconds in the same range. Fraction digits finer than nanoseconds are ignored and the result is
+// truncated to Duration without floating point.
+template <TimePoint TimePoint, typename Unit = void>
+  requires std::is_same_v<typename TimePoint::clock, system_clock>
+[[nodiscard]] inline constexpr TimePoint parse_epoch(std::string_view str, std::error_code& ec) noexcept
+{
+  TimePoint result{};
+  if (const auto e = internal::parse_epoch<Unit>(str, result); e != errc{}) {
+    ec = std::make_error_code(e);
+    return {};
+  }
+  return result;
+}
+
+template <TimePoint TimePoint, typename Unit = void>
+  requires std::is_same_v<typename TimePoint::clock, system_clock>
+[[nodiscard]] inline TimePoint parse_epoch(std::string_view str)
+{
+  std::error_code ec;
+  const auto result = parse_epoch<TimePoint, Unit>(str, ec);
+  if (ec) {
+    throw std::system_error(ec, "epoch parse error for \"" + std::string{ str } + "\"");
+  }
+  return result;
+}
+
+// Parses every string of strs into out, which must have the same size. Stops at the first invalid
+// string, sets ec and returns its index. Returns the number of strings otherwise.
+template <TimePoint TimePoint, typename Unit = void>
+  requires std::is_same_v<typename TimePoint::clock, system_clock>
+inline std::size_t parse_epoch(std::span<const std::string_view> strs, std::span<TimePoint> out, std::error_code& ec) noexcept
+{
+  ec.clear();
+  for (std::size_t i = 0; i < strs.size(); i++) {
+    if (const auto e = internal::parse_epoch<Unit>(strs[i], out[i]); e != errc{}) {
+      ec = std::make_error_code(e);
+      return i;
+    }
+  }
+  return strs.size();
+}
+
+template <TimePoint TimePoint, typename Unit = void>
+  requires std::is_same_v<typename TimePoint::clock, system_clock>
+inline void parse_epoch(std::span<const std::string_view> strs, std::span<TimePoint> out)
+{
+  std::error_code ec;
+  if (const auto i = parse_epoch<TimePoint, Unit>(strs, out, ec); ec) {
+    throw std::system_error(ec, "epoch parse error for \"" + std::string{ strs[i] } + "\"");
+  }
+}
+
+}  // namespace dtz
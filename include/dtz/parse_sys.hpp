@@ -0,0 +1,142 @@
+#pragma once
+#include "chrono.hpp"
+#include "error.hpp"
+#include "parse.hpp"
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace dtz {
+
+// Converts local times in a time zone to sys_time like zoned_time with choose. The offset is cached with
+// the interval of local times that it maps to a single sys_time, so local times in the same interval
+// cost one comparison and one subtraction instead of a time zone lookup.
+class sys_converter
+{
+public:
+  explicit sys_converter(const time_zone* zone, choose choose = choose::earliest) noexcept : zone_(zone), choose_(choose)
+  {}
+
+  [[nodiscard]] const time_zone* zone() const noexcept
+  {
+    return zone_;
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] auto to_sys(const local_time<Duration>& lt)
+  {
+    using Result = sys_time<std::common_type_t<Duration, seconds>>;
+    const auto s = floor<seconds>(lt);
+    if (s < begin_ || !(s < end_)) {
+      const auto info = zone_->get_info(s);
+      if (info.result != local_info::unique) {
+        // Same as time_zone::to_sys(lt, choose).
+        if (info.result == local_info::nonexistent) {
+          return Result{ info.first.end };
+        }
+        const auto& i = choose_ == choose::latest ? info.second : info.first;
+        return Result{ lt.time_since_epoch() - i.offset };
+      }
+      // Offsets of two intervals differ by less than two days, so local times that are further
+      // away from the transitions map only to this interval.
+      constexpr auto margin = days{ 2 };
+      begin_ = local_time<seconds>{ info.first.begin.time_since_epoch() + info.first.offset + margin };
+      end_ = local_time<seconds>{ info.first.end.time_since_epoch() + info.first.offset - margin };
+      offset_ = info.first.offset;
+    }
+    return Result{ lt.time_since_epoch() - offset_ };
+  }
+
+private:
+  const time_zone* zone_ = nullptr;
+  choose choose_ = choose::earliest;
+  local_time<seconds> begin_ = local_time<seconds>::max();
+  local_time<seconds> end_ = local_time<seconds>::min();
+  seconds offset_{};
+};
+
+// Parses a local time like parse<local_time<Duration>> and converts it to sys_time in the zone of the
+// converter. The result has the duration of zoned_time<Duration>.
+template <Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+[[nodiscard]] inline auto parse_sys(std::string_view str, sys_converter& converter, std::error_code& ec) noexcept
+{
+  using Result = sys_time<std::common_type_t<Duration, seconds>>;
+  local_time<Duration> lt{};
+  if (const auto e = internal::parse(str, lt); e != errc{}) {
+    ec = std::make_error_code(e);
+    return Result{};
+  }
+  return Result{ converter.to_sys(lt) };
+}
+
+template <Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+[[nodiscard]] inline auto parse_sys(std::string_view str, sys_converter& converter)
+{
+  std::error_code ec;
+  const auto result = parse_sys<Duration>(str, converter, ec);
+  if (ec) {
+    throw std::system_error(ec, "time point parse error for \"" + std::string{ str } + "\"");
+  }
+  return result;
+}
+
+// Parses a local time and converts it to sys_time in zone like make_zoned(zone, lt, choose).
+template <Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+[[nodiscard]] inline auto parse_sys(std::string_view str, const time_zone* zone, choose choose, std::error_code& ec) noexcept
+{
+  sys_converter converter{ zone, choose };
+  return parse_sys<Duration>(str, converter, ec);
+}
+
+template <Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+[[nodiscard]] inline auto parse_sys(std::string_view str, const time_zone* zone, choose choose)
+{
+  sys_converter converter{ zone, choose };
+  return parse_sys<Duration>(str, converter);
+}
+
+// Parses every string of strs into out, which must have the same size. Stops at the first invalid
+// string, sets ec and returns its index. Returns the number of strings otherwise.
+template <Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+inline std::size_t parse_sys(std::span<const std::string_view> strs, sys_converter& converter,
+  std::span<sys_time<std::common_type_t<Duration, seconds>>> out, std::error_code& ec) noexcept
+{
+  ec.clear();
+  for (std::size_t i = 0; i < strs.size(); i++) {
+    out[i] = parse_sys<Duration>(strs[i], converter, ec);
+    if (ec) {
+      return i;
+    }
+  }
+  return strs.size();
+}
+
+template <Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+inline std::size_t parse_sys(std::span<const std::string_view> strs, const time_zone* zone, choose choose,
+  std::span<sys_time<std::common_type_t<Duration, seconds>>> out, std::error_code& ec) noexcept
+{
+  sys_converter converter{ zone, choose };
+  return parse_sys<Duration>(strs, converter, out, ec);
+}
+
+template <Duration Duration>
+  requires ValidZonedTimeDuration<Duration>
+inline void parse_sys(std::span<const std::string_view> strs, const time_zone* zone, choose choose,
+  std::span<sys_time<std::common_type_t<Duration, seconds>>> out)
+{
+  std::error_code ec;
+  if (const auto i = parse_sys<Duration>(strs, zone, choose, out, ec); ec) {
+    throw std::system_error(ec, "time point parse error for \"" + std::string{ strs[i] } + "\"");
+  }
+}
+
+}  // namespace dtz
@@ -0,0 +1,171 @@
+#pragma once
+#include "chrono.hpp"
+#include "error.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace dtz {
+
+enum class frequency {
+  daily,
+  weekly,
+  monthly,
+  yearly,
+};
+
+// RFC 5545 recurrence rule expanded in a time zone.
+//
+// Supports FREQ (DAILY, WEEKLY, MONTHLY, YEARLY), INTERVAL, COUNT, UNTIL, BYMONTH, BYMONTHDAY, BYDAY,
+// BYHOUR, BYMINUTE, BYSECOND, BYSETPOS and WKST. Other rule parts are rejected with errc::invalid_format.
+//
+// DTSTART is always the first occurrence. Local times that occur twice resolve to the first occurrence
+// and local times in a gap use the offset before the gap, as specified by RFC 5545.
+//
+// Queries jump directly to the period that contains the requested time instead of iterating from DTSTART.
+// Rules with COUNT are expanded once on construction and searched with a binary search.
+class recurrence
+{
+public:
+  recurrence(const time_zone* zone, local_time<seconds> dtstart, std::string_view rule, std::error_code& ec);
+  recurrence(const time_zone* zone, local_time<seconds> dtstart, std::string_view rule);
+
+  [[nodiscard]] const time_zone* zone() const noexcept
+  {
+    return zone_;
+  }
+
+  [[nodiscard]] local_time<seconds> dtstart() const noexcept
+  {
+    return dtstart_;
+  }
+
+  [[nodiscard]] frequency freq() const noexcept
+  {
+    return freq_;
+  }
+
+  // Returns the first occurrence after tp or sys_time<seconds>::max() when there is none.
+  [[nodiscard]] sys_time<seconds> next(sys_time<seconds> tp) const;
+
+  // Writes all occurrences in [begin, end) to out.
+  template <std::output_iterator<sys_time<seconds>> OutputIt>
+  OutputIt between(sys_time<seconds> begin, sys_time<seconds> end, OutputIt out) const
+  {
+    for (auto tp = next(begin - seconds{ 1 }); tp < end; tp = next(tp)) {
+      *out++ = tp;
+    }
+    return out;
+  }
+
+private:
+  void initialize(std::string_view rule, std::error_code& ec);
+  [[nodiscard]] errc parse(std::string_view rule);
+  [[nodiscard]] std::int64_t period(local_days d) const noexcept;
+  [[nodiscard]] local_days first_day(std::int64_t period) const noexcept;
+  [[nodiscard]] bool expand(std::int64_t period, std::vector<sys_time<seconds>>& out) const;
+  void expand_days(std::int64_t period, std::vector<local_days>& out) const;
+  [[nodiscard]] bool match_month(year_month_day ymd) const noexcept;
+  [[nodiscard]] bool match_monthday(int d, int last) const noexcept;
+  [[nodiscard]] bool match_weekday(local_days d, int index, int last_index) const noexcept;
+  [[nodiscard]] sys_time<seconds> to_sys(local_time<seconds> lt) const noexcept;
+
+  const time_zone* zone_ = nullptr;
+  local_time<seconds> dtstart_{};
+  sys_time<seconds> first_{};
+  frequency freq_ = frequency::daily;
+  int interval_ = 1;
+  std::size_t count_ = 0;
+  sys_time<seconds> until_ = sys_time<seconds>::max();
+  weekday wkst_ = mon;
+
+  // Bit n of bymonth_, bymonthday_ and byday_ selects month n, day n and the nth weekday.
+  // The *_last_ masks count from the end. Bit 0 of byday_ selects every occurrence of the weekday.
+  std::uint16_t bymonth_ = 0;
+  std::uint32_t bymonthday_ = 0;
+  std::uint32_t bymonthday_last_ = 0;
+  std::array<std::uint64_t, 7> byday_{};
+  std::array<std::uint64_t, 7> byday_last_{};
+  bool byday_any_ = false;
+  bool byday_ordinals_ = false;
+
+  std::vector<seconds> times_;
+  std::vector<int> bysetpos_;
+  std::vector<sys_time<seconds>> occurrences_;
+};
+
+// Pending occurrences of many recurrences ordered by time.
+class recurrence_queue
+{
+public:
+  struct occurrence
+  {
+    std::size_t id = 0;
+    sys_time<seconds> time;
+
+    [[nodiscard]] friend bool operator>(const occurrence& lhs, const occurrence& rhs) noexcept
+    {
+      return lhs.time > rhs.time;
+    }
+  };
+
+  // Adds the recurrence with its occurrences at or after begin and returns its id.
+  std::size_t push(recurrence r, sys_time<seconds> begin)
+  {
+    const auto id = recurrences_.size();
+    recurrences_.push_back(std::move(r));
+    schedule(id, recurrences_.back().next(begin - seconds{ 1 }));
+    return id;
+  }
+
+  // Writes all pending occurrences before end to out in time order and schedules the following ones.
+  template <std::output_iterator<occurrence> OutputIt>
+  OutputIt pop(sys_time<seconds> end, OutputIt out)
+  {
+    while (!heap_.empty() && heap_.front().time < end) {
+      std::pop_heap(heap_.begin(), heap_.end(), std::greater<>{});
+      const auto o = heap_.back();
+      heap_.pop_back();
+      *out++ = o;
+      schedule(o.id, recurrences_[o.id].next(o.time));
+    }
+    return out;
+  }
+
+  // Returns the next pending occurrence time or sys_time<seconds>::max() when the queue is empty.
+  [[nodiscard]] sys_time<seconds> top() const noexcept
+  {
+    return heap_.empty() ? sys_time<seconds>::max() : heap_.front().time;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return heap_.empty();
+  }
+
+  [[nodiscard]] const recurrence& operator[](std::size_t id) const noexcept
+  {
+    return recurrences_[id];
+  }
+
+private:
+  void schedule(std::size_t id, sys_time<seconds> time)
+  {
+    if (time != sys_time<seconds>::max()) {
+      heap_.push_back({ id, time });
+      std::push_heap(heap_.begin(), heap_.end(), std::greater<>{});
+    }
+  }
+
+  std::vector<recurrence> recurrences_;
+  std::vector<occurrence> heap_;
+};
+
+}  // namespace dtz
@@ -0,0 +1,463 @@
+#pragma once
+#include "chrono.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace dtz {
+
+// Hierarchical timer wheel for deadlines of Clock rounded up to Resolution.
+//
+// Timers live in 11 levels of 64 slots. Level n holds the timers whose tick first differs from the current
+// tick in bits [6n, 6n + 6), so a slot is moved one level down when the current tick reaches it and every
+// timer is moved at most 11 times. Insert and cancel link and unlink a node in O(1). Advancing skips empty
+// slots with the occupancy bitmask of every level and fires all timers up to the new tick as one batch.
+//
+// Timer nodes are allocated in chunks and never move, so values stay valid while callbacks insert timers.
+// Time points before the clock epoch are treated as the clock epoch.
+template <Clock Clock, typename T = std::uint64_t, Duration Resolution = milliseconds>
+class timer_wheel
+{
+public:
+  using clock = Clock;
+  using value_type = T;
+  using resolution = Resolution;
+
+  struct timer_id
+  {
+    std::uint32_t index = 0;
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] friend bool operator==(const timer_id& lhs, const timer_id& rhs) noexcept = default;
+  };
+
+  timer_wheel()
+  {
+    heads_.fill(npos);
+  }
+
+  template <Duration Duration>
+  explicit timer_wheel(const time_point<Clock, Duration>& now) : timer_wheel()
+  {
+    tick_ = ticks(dtz::floor<Resolution>(now));
+  }
+
+  timer_wheel(const timer_wheel& other) = delete;
+  timer_wheel& operator=(const timer_wheel& other) = delete;
+
+  timer_wheel(timer_wheel&& other) noexcept = default;
+  timer_wheel& operator=(timer_wheel&& other) noexcept = default;
+
+  ~timer_wheel() = default;
+
+  // Returns the current time, which is the last time passed to advance rounded down to Resolution.
+  [[nodiscard]] time_point<Clock, Resolution> now() const noexcept
+  {
+    return time_point<Clock, Resolution>{ Resolution{ static_cast<typename Resolution::rep>(tick_) } };
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  // Adds a timer that fires on the first advance to or past deadline. Deadlines at or before now()
+  // fire on the next advance.
+  template <Duration Duration>
+  timer_id insert(const time_point<Clock, Duration>& deadline, T value)
+  {
+    const auto index = allocate();
+    auto& n = node(index);
+    n.tick = ticks(dtz::ceil<Resolution>(deadline));
+    n.state = timer_state::armed;
+    n.value = std::move(value);
+    place(index);
+    size_++;
+    return { index, n.generation };
+  }
+
+  // Moves a pending timer to a new deadline. Rescheduling a timer from its own callback re-arms it.
+  // Returns false when the timer already fired or was cancelled.
+  template <Duration Duration>
+  bool reschedule(timer_id id, const time_point<Clock, Duration>& deadline) noexcept
+  {
+    if (!contains(id)) {
+      return false;
+    }
+    auto& n = node(id.index);
+    if (n.state == timer_state::armed) {
+      unlink(id.index);
+    } else {
+      size_++;
+    }
+    n.tick = ticks(dtz::ceil<Resolution>(deadline));
+    n.state = timer_state::armed;
+    place(id.index);
+    return true;
+  }
+
+  // Removes a pending timer. Cancelling a timer that fires in the current batch skips its callback.
+  // Returns false when the timer already fired or was cancelled.
+  bool cancel(timer_id id) noexcept
+  {
+    if (!contains(id)) {
+      return false;
+    }
+    auto& n = node(id.index);
+    if (n.state == timer_state::armed) {
+      unlink(id.index);
+      release(id.index);
+      size_--;
+    } else {
+      n.state = timer_state::cancelled;
+    }
+    return true;
+  }
+
+  [[nodiscard]] bool contains(timer_id id) const noexcept
+  {
+    if (id.index >= capacity_) {
+      return false;
+    }
+    const auto& n = node(id.index);
+    return n.generation == id.generation && (n.state == timer_state::armed || n.state == timer_state::firing);
+  }
+
+  // Returns the value of a pending or firing timer.
+  [[nodiscard]] T& operator[](timer_id id) noexcept
+  {
+    return node(id.index).value;
+  }
+
+  [[nodiscard]] const T& operator[](timer_id id) const noexcept
+  {
+    return node(id.index).value;
+  }
+
+  // Advances the wheel to now and calls f(timer_id, T&) for every timer with a deadline at or before now.
+  // Returns the number of fired timers.
+  template <Duration Duration, typename F>
+  std::size_t advance(const time_point<Clock, Duration>& now, F&& f)
+  {
+    const auto target = ticks(dtz::floor<Resolution>(now));
+    firing_.clear();
+    collect(ready);
+    for (auto tick = next_tick(); tick <= target; tick = next_tick()) {
+      tick_ = tick;
+      for (auto level = levels - 1; level > 0; level--) {
+        if ((tick & ((std::uint64_t{ 1 } << (level * bits)) - 1)) == 0) {
+          cascade(level * slots + ((tick >> (level * bits)) & mask));
+        }
+      }
+      collect(tick & mask);
+      collect(ready);
+    }
+    if (target > tick_) {
+      tick_ = target;
+    }
+
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < firing_.size(); i++) {
+      const auto index = firing_[i];
+      auto& n = node(index);
+      if (n.state == timer_state::firing) {
+        count++;
+        f(timer_id{ index, n.generation }, n.value);
+      }
+      if (n.state != timer_state::armed) {
+        release(index);
+      }
+    }
+    return count;
+  }
+
+  // Removes all timers without firing them.
+  void clear() noexcept
+  {
+    for (std::uint32_t index = 0; index < capacity_; index++) {
+      if (node(index).state == timer_state::armed) {
+        release(index);
+      }
+    }
+    heads_.fill(npos);
+    occupied_.fill(0);
+    size_ = 0;
+  }
+
+private:
+  static constexpr std::size_t bits = 6;
+  static constexpr std::size_t slots = std::size_t{ 1 } << bits;
+  static constexpr std::uint64_t mask = slots - 1;
+  static constexpr std::size_t levels = (64 + bits - 1) / bits;
+  static constexpr std::size_t ready = levels * slots;
+  static constexpr std::uint32_t npos = ~std::uint32_t{ 0 };
+  static constexpr std::size_t chunk_bits = 12;
+  static constexpr std::size_t chunk_size = std::size_t{ 1 } << chunk_bits;
+
+  enum class timer_state : std::uint8_t {
+    free,
+    armed,
+    firing,
+    cancelled,
+  };
+
+  struct timer
+  {
+    std::uint64_t tick = 0;
+    std::uint32_t prev = npos;
+    std::uint32_t next = npos;
+    std::uint32_t generation = 0;
+    std::uint16_t slot = 0;
+    timer_state state = timer_state::free;
+    T value{};
+  };
+
+  [[nodiscard]] static std::uint64_t ticks(const time_point<Clock, Resolution>& tp) noexcept
+  {
+    const auto count = tp.time_since_epoch().count();
+    return count > 0 ? static_cast<std::uint64_t>(count) : 0;
+  }
+
+  [[nodiscard]] timer& node(std::uint32_t index) noexcept
+  {
+    return chunks_[index >> chunk_bits][index & (chunk_size - 1)];
+  }
+
+  [[nodiscard]] const timer& node(std::uint32_t index) const noexcept
+  {
+    return chunks_[index >> chunk_bits][index & (chunk_size - 1)];
+  }
+
+  [[nodiscard]] std::uint32_t allocate()
+  {
+    if (free_ == npos) {
+      chunks_.push_back(std::make_unique<timer[]>(chunk_size));
+      free_ = capacity_;
+      for (std::size_t i = 0; i < chunk_size; i++) {
+        chunks_.back()[i].next = i + 1 < chunk_size ? capacity_ + static_cast<std::uint32_t>(i) + 1 : npos;
+      }
+      capacity_ += static_cast<std::uint32_t>(chunk_size);
+    }
+    const auto index = free_;
+    free_ = node(index).next;
+    return index;
+  }
+
+  void release(std::uint32_t index) noexcept
+  {
+    auto& n = node(index);
+    n.value = T{};
+    n.generation++;
+    n.state = timer_state::free;
+    n.next = free_;
+    free_ = index;
+  }
+
+  // Links the node into the slot of its tick relative to the current tick.
+  void place(std::uint32_t index) noexcept
+  {
+    auto& n = node(index);
+    std::size_t slot = ready;
+    if (n.tick > tick_) {
+      const auto level = static_cast<std::size_t>(std::bit_width(n.tick ^ tick_) - 1) / bits;
+      const auto digit = (n.tick >> (level * bits)) & mask;
+      slot = level * slots + digit;
+      occupied_[level] |= std::uint64_t{ 1 } << digit;
+    }
+    n.slot = static_cast<std::uint16_t>(slot);
+    n.prev = npos;
+    n.next = heads_[slot];
+    if (n.next != npos) {
+      node(n.next).prev = index;
+    }
+    heads_[slot] = index;
+  }
+
+  void unlink(std::uint32_t index) noexcept
+  {
+    const auto& n = node(index);
+    if (n.prev != npos) {
+      node(n.prev).next = n.next;
+    } else {
+      heads_[n.slot] = n.next;
+      if (n.next == npos && n.slot != ready) {
+        occupied_[n.slot / slots] &= ~(std::uint64_t{ 1 } << (n.slot & mask));
+      }
+    }
+    if (n.next != npos) {
+      node(n.next).prev = n.prev;
+    }
+  }
+
+  // Detaches the list of a slot and clears its occupancy bit.
+  [[nodiscard]] std::uint32_t take(std::size_t slot) noexcept
+  {
+    const auto head = heads_[slot];
+    heads_[slot] = npos;
+    if (slot != ready) {
+      occupied_[slot / slots] &= ~(std::uint64_t{ 1 } << (slot & mask));
+    }
+    return head;
+  }
+
+  void collect(std::size_t slot)
+  {
+    for (auto index = take(slot); index != npos;) {
+      auto& n = node(index);
+      n.state = timer_state::firing;
+      firing_.push_back(index);
+      size_--;
+      index = n.next;
+    }
+  }
+
+  void cascade(std::size_t slot) noexcept
+  {
+    for (auto index = take(slot); index != npos;) {
+      const auto next = node(index).next;
+      place(index);
+      index = next;
+    }
+  }
+
+  // Returns the first tick after the current tick with a slot to fire or cascade.
+  [[nodiscard]] std::uint64_t next_tick() const noexcept
+  {
+    for (std::size_t level = 0; level < levels; level++) {
+      const auto digit = (tick_ >> (level * bits)) & mask;
+      const auto pending = digit == mask ? 0 : occupied_[level] & (~std::uint64_t{ 0 } << (digit + 1));
+      if (pending) {
+        const auto shift = (level + 1) * bits;
+        const auto high = shift < 64 ? tick_ >> shift << shift : 0;
+        return high | static_cast<std::uint64_t>(std::countr_zero(pending)) << (level * bits);
+      }
+    }
+    return ~std::uint64_t{ 0 };
+  }
+
+  std::uint64_t tick_ = 0;
+  std::size_t size_ = 0;
+  std::uint32_t free_ = npos;
+  std::uint32_t capacity_ = 0;
+  std::array<std::uint32_t, levels * slots + 1> heads_{};
+  std::array<std::uint64_t, levels> occupied_{};
+  std::vector<std::unique_ptr<timer[]>> chunks_;
+  std::vector<std::uint32_t> firing_;
+};
+
+// Timer wheel with deadlines in local time of a time zone.
+//
+// Deadlines are converted with make_zoned and choose, so a deadline that occurs twice fires at the chosen
+// instant and a deadline in a gap fires at the transition. Timers with a period re-arm after every callback
+// at the previous local deadline plus the period, e.g. 09:00 every day regardless of DST transitions.
+template <typename T = std::uint64_t, Duration Resolution = milliseconds>
+class zoned_timer_wheel
+{
+  struct entry
+  {
+    const time_zone* zone = nullptr;
+    local_time<Resolution> deadline{};
+    Resolution period{ 0 };
+    dtz::choose rule = dtz::choose::earliest;
+    T value{};
+  };
+
+public:
+  using value_type = T;
+  using resolution = Resolution;
+  using timer_id = typename timer_wheel<system_clock, entry, Resolution>::timer_id;
+
+  zoned_timer_wheel() = default;
+
+  template <Duration Duration>
+  explicit zoned_timer_wheel(const sys_time<Duration>& now) : wheel_(now)
+  {}
+
+  [[nodiscard]] sys_time<Resolution> now() const noexcept
+  {
+    return wheel_.now();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return wheel_.size();
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return wheel_.empty();
+  }
+
+  // Adds a timer that fires at the local deadline in zone and, with a positive period, every period after it.
+  template <Duration Duration>
+  timer_id insert(const time_zone* zone, const local_time<Duration>& deadline, choose choose, T value, Resolution period = {})
+  {
+    const auto lt = dtz::ceil<Resolution>(deadline);
+    return wheel_.insert(to_sys(zone, lt, choose), entry{ zone, lt, period, choose, std::move(value) });
+  }
+
+  bool cancel(timer_id id) noexcept
+  {
+    return wheel_.cancel(id);
+  }
+
+  [[nodiscard]] bool contains(timer_id id) const noexcept
+  {
+    return wheel_.contains(id);
+  }
+
+  [[nodiscard]] T& operator[](timer_id id) noexcept
+  {
+    return wheel_[id].value;
+  }
+
+  [[nodiscard]] const T& operator[](timer_id id) const noexcept
+  {
+    return wheel_[id].value;
+  }
+
+  // Returns the local deadline of a pending timer.
+  [[nodiscard]] local_time<Resolution> deadline(timer_id id) const noexcept
+  {
+    return wheel_[id].deadline;
+  }
+
+  // Advances the wheel to now, calls f(timer_id, T&) for every due timer and re-arms periodic timers
+  // that were not cancelled by their callback. Returns the number of fired timers.
+  template <Duration Duration, typename F>
+  std::size_t advance(const sys_time<Duration>& now, F&& f)
+  {
+    return wheel_.advance(now, [&](timer_id id, entry& e) {
+      f(id, e.value);
+      if (e.period > Resolution::zero() && wheel_.contains(id)) {
+        e.deadline += e.period;
+        wheel_.reschedule(id, to_sys(e.zone, e.deadline, e.rule));
+      }
+    });
+  }
+
+  void clear() noexcept
+  {
+    wheel_.clear();
+  }
+
+private:
+  [[nodiscard]] static sys_time<Resolution> to_sys(const time_zone* zone, const local_time<Resolution>& lt, choose choose)
+  {
+    return dtz::make_zoned(zone, lt, choose).get_sys_time();
+  }
+
+  timer_wheel<system_clock, entry, Resolution> wheel_;
+};
+
+}  // namespace dtz
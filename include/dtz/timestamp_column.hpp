@@ -0,0 +1,341 @@
+#pragma once
+#include "binary.hpp"
+#include "chrono.hpp"
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+namespace dtz {
+
+// Append-only column of sys_time values compressed with delta-of-delta bit packing as in Gorilla.
+//
+// Values are stored in blocks of block_size values. Every block starts at a word boundary with its
+// first value in the block header, so it can be decoded on its own. Each following value is stored
+// as the zig-zag delta of delta to the previous two values in the block:
+//
+//   0                      delta of delta 0 (1 bit)
+//   10   + 7 bits          below 2^7
+//   110  + 9 bits          below 2^9
+//   1110 + 12 bits         below 2^12
+//   1111 + 64 bits         any other value
+//
+// A series with a fixed interval takes one bit per value plus a 32 byte header per block.
+// Block headers keep the minimum and maximum, so range scans skip blocks without decoding them.
+template <Duration Duration = nanoseconds>
+  requires std::integral<typename Duration::rep>
+class timestamp_column
+{
+public:
+  using value_type = sys_time<Duration>;
+  using size_type = std::size_t;
+
+  static constexpr std::size_t block_size = 1024;
+
+  struct block_info
+  {
+    std::size_t first = 0;
+    std::size_t size = 0;
+    value_type min{};
+    value_type max{};
+  };
+
+  // Decodes values sequentially. Seeking to an index decodes its block up to the index.
+  class iterator
+  {
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = sys_time<Duration>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    iterator() noexcept = default;
+
+    [[nodiscard]] value_type operator*() const noexcept
+    {
+      return internal::binary_value<value_type>(last_);
+    }
+
+    iterator& operator++() noexcept
+    {
+      if (++index_ < column_->size_) {
+        if (index_ % block_size == 0) {
+          load(index_ / block_size);
+        } else {
+          const auto dod = internal::unzigzag(column_->read_dod(bit_));
+          delta_ += dod;
+          last_ += delta_;
+        }
+      }
+      return *this;
+    }
+
+    iterator operator++(int) noexcept
+    {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+
+    [[nodiscard]] std::size_t index() const noexcept
+    {
+      return index_;
+    }
+
+    [[nodiscard]] friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept
+    {
+      return lhs.index_ == rhs.index_;
+    }
+
+  private:
+    friend class timestamp_column;
+
+    iterator(const timestamp_column* column, std::size_t index) noexcept : column_(column), index_(index)
+    {
+      if (index_ < column_->size_) {
+        load(index_ / block_size);
+        for (auto i = index_ % block_size; i > 0; i--) {
+          delta_ += internal::unzigzag(column_->read_dod(bit_));
+          last_ += delta_;
+        }
+      }
+    }
+
+    void load(std::size_t b) noexcept
+    {
+      const auto& h = column_->headers_[b];
+      bit_ = h.offset * 64;
+      last_ = h.first;
+      delta_ = 0;
+    }
+
+    const timestamp_column* column_ = nullptr;
+    std::size_t index_ = 0;
+    std::size_t bit_ = 0;
+    std::uint64_t last_ = 0;
+    std::uint64_t delta_ = 0;
+  };
+
+  using const_iterator = iterator;
+
+  void push_back(value_type tp)
+  {
+    const auto value = internal::binary_count(tp);
+    if (size_ % block_size == 0) {
+      bits_ = words_.size() * 64;
+      headers_.push_back({ value, tp, tp, words_.size() });
+      last_ = value;
+      delta_ = 0;
+      size_++;
+      return;
+    }
+    const auto d = value - last_;
+    const auto dod = internal::zigzag(d - delta_);
+    if (dod == 0) {
+      write(0, 1);
+    } else if (dod < (1 << 7)) {
+      write(0b01 | dod << 2, 9);
+    } else if (dod < (1 << 9)) {
+      write(0b011 | dod << 3, 12);
+    } else if (dod < (1 << 12)) {
+      write(0b0111 | dod << 4, 16);
+    } else {
+      write(0b1111, 4);
+      write(dod, 64);
+    }
+    last_ = value;
+    delta_ = d;
+    auto& h = headers_.back();
+    h.min = std::min(h.min, tp);
+    h.max = std::max(h.max, tp);
+    size_++;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  [[nodiscard]] bool empty() const noexcept
+  {
+    return size_ == 0;
+  }
+
+  // Returns the number of bytes used by the compressed values and block headers.
+  [[nodiscard]] std::size_t memory() const noexcept
+  {
+    return words_.size() * sizeof(std::uint64_t) + headers_.size() * sizeof(header);
+  }
+
+  [[nodiscard]] std::size_t blocks() const noexcept
+  {
+    return headers_.size();
+  }
+
+  [[nodiscard]] block_info block(std::size_t b) const noexcept
+  {
+    const auto& h = headers_[b];
+    return { b * block_size, std::min(block_size, size_ - b * block_size), h.min, h.max };
+  }
+
+  [[nodiscard]] iterator begin() const noexcept
+  {
+    return { this, 0 };
+  }
+
+  [[nodiscard]] iterator end() const noexcept
+  {
+    return { this, size_ };
+  }
+
+  // Returns an iterator to the value at index. Decodes up to block_size values.
+  [[nodiscard]] iterator seek(std::size_t index) const noexcept
+  {
+    return { this, std::min(index, size_) };
+  }
+
+  [[nodiscard]] value_type operator[](std::size_t index) const noexcept
+  {
+    return *seek(index);
+  }
+
+  // Returns the first value not less (lower_bound) or greater (upper_bound) than tp. Requires values
+  // in ascending order. Finds the block with the block maxima and decodes only that block.
+  [[nodiscard]] iterator lower_bound(value_type tp) const noexcept
+  {
+    return bound(tp, [](value_type value, value_type tp) { return value < tp; });
+  }
+
+  [[nodiscard]] iterator upper_bound(value_type tp) const noexcept
+  {
+    return bound(tp, [](value_type value, value_type tp) { return value <= tp; });
+  }
+
+  // Calls f(index, value) for every value in [begin, end), skipping blocks outside of the range.
+  // Values may be in any order.
+  template <typename F>
+  void scan(value_type begin, value_type end, F f) const
+  {
+    for (std::size_t b = 0; b < headers_.size(); b++) {
+      const auto& h = headers_[b];
+      if (h.max < begin || h.min >= end) {
+        continue;
+      }
+      const auto first = b * block_size;
+      const auto last = std::min(first + block_size, size_);
+      for (auto it = iterator{ this, first }; it.index() < last; ++it) {
+        if (const auto value = *it; value >= begin && value < end) {
+          f(it.index(), value);
+        }
+      }
+    }
+  }
+
+  void clear() noexcept
+  {
+    words_.clear();
+    headers_.clear();
+    size_ = 0;
+    bits_ = 0;
+  }
+
+  void shrink_to_fit()
+  {
+    words_.shrink_to_fit();
+    headers_.shrink_to_fit();
+  }
+
+private:
+  struct header
+  {
+    std::uint64_t first = 0;
+    value_type min{};
+    value_type max{};
+    std::size_t offset = 0;
+  };
+
+  template <typename Compare>
+  [[nodiscard]] iterator bound(value_type tp, Compare compare) const noexcept
+  {
+    const auto h = std::partition_point(headers_.begin(), headers_.end(), [&](const header& h) {
+      return compare(h.max, tp);
+    });
+    if (h == headers_.end()) {
+      return end();
+    }
+    const auto first = static_cast<std::size_t>(h - headers_.begin()) * block_size;
+    auto it = iterator{ this, first };
+    while (it.index() < size_ && compare(*it, tp)) {
+      ++it;
+    }
+    return it;
+  }
+
+  // Appends the lowest n bits of value, least significant bit first.
+  void write(std::uint64_t value, int n)
+  {
+    const auto offset = static_cast<int>(bits_ & 63);
+    if (offset == 0) {
+      words_.push_back(value);
+    } else {
+      words_.back() |= value << offset;
+      if (offset + n > 64) {
+        words_.push_back(value >> (64 - offset));
+      }
+    }
+    bits_ += static_cast<std::size_t>(n);
+  }
+
+  [[nodiscard]] std::uint64_t read(std::size_t& bit, int n) const noexcept
+  {
+    const auto word = bit >> 6;
+    const auto offset = static_cast<int>(bit & 63);
+    auto value = words_[word] >> offset;
+    if (offset + n > 64) {
+      value |= words_[word + 1] << (64 - offset);
+    }
+    bit += static_cast<std::size_t>(n);
+    return n == 64 ? value : value & ((std::uint64_t{ 1 } << n) - 1);
+  }
+
+  // Reads the next zig-zag delta of delta. Peeks 16 bits, which covers every encoding but the last.
+  [[nodiscard]] std::uint64_t read_dod(std::size_t& bit) const noexcept
+  {
+    const auto word = bit >> 6;
+    const auto offset = static_cast<int>(bit & 63);
+    auto peek = words_[word] >> offset;
+    if (offset > 48 && word + 1 < words_.size()) {
+      peek |= words_[word + 1] << (64 - offset);
+    }
+    if ((peek & 1) == 0) {
+      bit += 1;
+      return 0;
+    }
+    if ((peek & 2) == 0) {
+      bit += 9;
+      return (peek >> 2) & 0x7F;
+    }
+    if ((peek & 4) == 0) {
+      bit += 12;
+      return (peek >> 3) & 0x1FF;
+    }
+    if ((peek & 8) == 0) {
+      bit += 16;
+      return (peek >> 4) & 0xFFF;
+    }
+    bit += 4;
+    return read(bit, 64);
+  }
+
+  std::vector<std::uint64_t> words_;
+  std::vector<header> headers_;
+  std::size_t size_ = 0;
+  std::size_t bits_ = 0;
+  std::uint64_t last_ = 0;
+  std::uint64_t delta_ = 0;
+};
+
+}  // namespace dtz
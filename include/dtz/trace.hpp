@@ -0,0 +1,362 @@
+#pragma once
+#include "chrono.hpp"
+#include "format.hpp"
+#include "histogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#  include <intrin.h>
+#  define DTZ_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#  define DTZ_TSC 1
+#else
+#  define DTZ_TSC 0
+#endif
+
+namespace dtz {
+namespace internal {
+
+// Relation between the time stamp counter and steady_clock, measured once on first use.
+struct tsc_calibration
+{
+  std::uint64_t tsc = 0;
+  std::int64_t ns = 0;
+  double ns_per_tick = 1.0;
+};
+
+const tsc_calibration& calibrate_tsc();
+
+}  // namespace internal
+
+// Steady clock that reads the time stamp counter, converted to nanoseconds with a calibration against
+// steady_clock that takes about 10 ms on first use. Assumes an invariant time stamp counter. Falls back to
+// steady_clock on platforms without one.
+struct tsc_clock
+{
+  using duration = nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = dtz::time_point<tsc_clock>;
+  static constexpr bool is_steady = true;
+
+  [[nodiscard]] static time_point now() noexcept
+  {
+#if DTZ_TSC
+    static const auto& calibration = internal::calibrate_tsc();
+    const auto ticks = static_cast<double>(__rdtsc() - calibration.tsc);
+    return time_point{ nanoseconds{ calibration.ns + static_cast<std::int64_t>(ticks * calibration.ns_per_tick) } };
+#else
+    return time_point{ dtz::floor<nanoseconds>(steady_clock::now().time_since_epoch()) };
+#endif
+  }
+};
+
+// Measures the time since construction or the last restart.
+template <Clock Clock = steady_clock>
+class stopwatch
+{
+public:
+  using clock = Clock;
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+  stopwatch() noexcept : start_(Clock::now())
+  {}
+
+  [[nodiscard]] time_point start() const noexcept
+  {
+    return start_;
+  }
+
+  [[nodiscard]] duration elapsed() const noexcept
+  {
+    return Clock::now() - start_;
+  }
+
+  // Returns the elapsed time and restarts the stopwatch at the same instant.
+  duration lap() noexcept
+  {
+    const auto now = Clock::now();
+    const auto elapsed = now - start_;
+    start_ = now;
+    return elapsed;
+  }
+
+  void restart() noexcept
+  {
+    start_ = Clock::now();
+  }
+
+private:
+  time_point start_;
+};
+
+// Records (event id, start, duration) in a ring buffer per thread and writes them as Chrome trace events.
+//
+// The first threads that record get their own ring buffer, allocated on their first event or by reserve.
+// Only the owning thread writes a ring, so record stores three relaxed words and publishes them with a
+// release store, without locks or allocations. Full rings overwrite their oldest events. Rings belong to
+// thread indices, which exiting threads hand on to new threads, so the thread of an event identifies its
+// ring rather than a system thread. Threads beyond the configured number of concurrent threads are not
+// recorded and counted in dropped.
+template <Clock Clock = steady_clock>
+class trace_recorder
+{
+public:
+  using clock = Clock;
+  using duration = typename Clock::duration;
+  using time_point = typename Clock::time_point;
+
+  struct event
+  {
+    std::uint32_t id = 0;
+    std::uint32_t thread = 0;
+    time_point start{};
+    typename Clock::duration duration{};
+  };
+
+  // Records the time from construction to destruction as one event.
+  class scope
+  {
+  public:
+    scope(trace_recorder& recorder, std::uint32_t id) noexcept : recorder_(&recorder), id_(id), start_(Clock::now())
+    {}
+
+    scope(const scope& other) = delete;
+    scope& operator=(const scope& other) = delete;
+
+    ~scope()
+    {
+      recorder_->record(id_, start_, Clock::now() - start_);
+    }
+
+  private:
+    trace_recorder* recorder_;
+    std::uint32_t id_;
+    time_point start_;
+  };
+
+  // Capacity is the number of latest events kept per thread. Rings have one more slot, rounded up to a
+  // power of two, so the slot being written never holds one of them.
+  explicit trace_recorder(std::size_t capacity = (1 << 16) - 1, std::size_t threads = 256) :
+    capacity_(std::max<std::size_t>(capacity, 1)), mask_(std::bit_ceil(capacity_ + 1) - 1), threads_(threads),
+    rings_(std::make_unique<ring[]>(threads)), origin_(Clock::now()), wall_origin_(system_clock::now())
+  {}
+
+  trace_recorder(const trace_recorder& other) = delete;
+  trace_recorder& operator=(const trace_recorder& other) = delete;
+
+  ~trace_recorder()
+  {
+    for (std::size_t i = 0; i < threads_; i++) {
+      delete[] rings_[i].slots.load(std::memory_order_relaxed);
+    }
+  }
+
+  // Returns the id for an event name. Names are registered once, outside of the hot path.
+  std::uint32_t name(std::string_view name)
+  {
+    std::lock_guard lock{ mutex_ };
+    const auto it = std::find(names_.begin(), names_.end(), name);
+    if (it != names_.end()) {
+      return static_cast<std::uint32_t>(it - names_.begin());
+    }
+    names_.emplace_back(name);
+    return static_cast<std::uint32_t>(names_.size() - 1);
+  }
+
+  // Allocates the ring buffer of the calling thread ahead of its first event.
+  void reserve()
+  {
+    if (const auto thread = internal::thread_index(); thread < threads_ && !rings_[thread].slots.load(std::memory_order_relaxed)) {
+      allocate(rings_[thread]);
+    }
+  }
+
+  void record(std::uint32_t id, time_point start, duration duration)
+  {
+    const auto thread = internal::thread_index();
+    if (thread >= threads_) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    auto& r = rings_[thread];
+    auto slots = r.slots.load(std::memory_order_relaxed);
+    if (!slots) {
+      slots = allocate(r);
+    }
+    const auto head = r.head.load(std::memory_order_relaxed);
+    auto& s = slots[head & mask_];
+    // Readers that see any of the following stores also see head, like the write side of a seqlock.
+    std::atomic_thread_fence(std::memory_order_release);
+    s.id.store(id, std::memory_order_relaxed);
+    s.start.store(start.time_since_epoch().count(), std::memory_order_relaxed);
+    s.duration.store(duration.count(), std::memory_order_relaxed);
+    r.head.store(head + 1, std::memory_order_release);
+  }
+
+  [[nodiscard]] scope trace(std::uint32_t id) noexcept
+  {
+    return { *this, id };
+  }
+
+  // Returns the recorded events of every thread in recording order. Events that are overwritten while
+  // they are copied are left out.
+  [[nodiscard]] std::vector<event> events() const
+  {
+    std::vector<event> result;
+    for (std::size_t i = 0; i < threads_; i++) {
+      const auto& r = rings_[i];
+      const auto slots = r.slots.load(std::memory_order_acquire);
+      if (!slots) {
+        continue;
+      }
+      const auto head = r.head.load(std::memory_order_acquire);
+      const auto first = head > capacity_ ? head - capacity_ : 0;
+      const auto offset = result.size();
+      for (auto n = first; n < head; n++) {
+        const auto& s = slots[n & mask_];
+        result.push_back({ s.id.load(std::memory_order_relaxed), static_cast<std::uint32_t>(i),
+          time_point{ duration{ s.start.load(std::memory_order_relaxed) } }, duration{ s.duration.load(std::memory_order_relaxed) } });
+      }
+      std::atomic_thread_fence(std::memory_order_acquire);
+      // The event at last may be written concurrently and overwrites the one at last - capacity.
+      const auto last = r.head.load(std::memory_order_relaxed);
+      const auto overwritten = std::min(last > mask_ ? last - mask_ : 0, head);
+      if (overwritten > first) {
+        const auto begin = result.begin() + static_cast<std::ptrdiff_t>(offset);
+        result.erase(begin, begin + static_cast<std::ptrdiff_t>(overwritten - first));
+      }
+    }
+    return result;
+  }
+
+  [[nodiscard]] std::uint64_t dropped() const noexcept
+  {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the time of construction. Trace event timestamps are relative to it.
+  [[nodiscard]] time_point origin() const noexcept
+  {
+    return origin_;
+  }
+
+  // Writes the events as a Chrome trace event JSON object with complete ("X") events. Timestamps are
+  // microseconds since origin, the args contain the formatted duration and otherData the wall clock origin.
+  template <std::output_iterator<char> OutputIt>
+  OutputIt write_chrome_trace(OutputIt out) const
+  {
+    std::vector<std::string> names;
+    {
+      std::lock_guard lock{ mutex_ };
+      names = names_;
+    }
+    out = internal::write(out, R"({"displayTimeUnit":"ns","otherData":{"origin":")");
+    out = dtz::format_to(out, dtz::floor<microseconds>(wall_origin_));
+    out = internal::write(out, R"("},"traceEvents":[)");
+    auto first = true;
+    for (const auto& e : events()) {
+      out = internal::write(out, first ? R"({"name":")" : R"(,{"name":")");
+      first = false;
+      if (e.id < names.size()) {
+        out = write_escaped(out, names[e.id]);
+      } else {
+        out = internal::write<1>(out, e.id);
+      }
+      out = internal::write(out, R"(","ph":"X","pid":1,"tid":)");
+      out = internal::write<1>(out, e.thread);
+      out = internal::write(out, R"(,"ts":)");
+      out = write_microseconds(out, e.start - origin_);
+      out = internal::write(out, R"(,"dur":)");
+      out = write_microseconds(out, e.duration);
+      out = internal::write(out, R"(,"args":{"duration":")");
+      out = dtz::format_to(out, dtz::duration_cast<nanoseconds>(e.duration));
+      out = internal::write(out, R"("}})");
+    }
+    return internal::write(out, "]}");
+  }
+
+  [[nodiscard]] std::string chrome_trace() const
+  {
+    std::string result;
+    write_chrome_trace(std::back_inserter(result));
+    return result;
+  }
+
+private:
+  struct slot
+  {
+    std::atomic<std::uint32_t> id{ 0 };
+    std::atomic<typename Clock::rep> start{ 0 };
+    std::atomic<typename Clock::rep> duration{ 0 };
+  };
+
+  struct alignas(64) ring
+  {
+    std::atomic<slot*> slots{ nullptr };
+    std::atomic<std::uint64_t> head{ 0 };
+  };
+
+  slot* allocate(ring& r)
+  {
+    const auto slots = new slot[mask_ + 1];
+    r.slots.store(slots, std::memory_order_release);
+    return slots;
+  }
+
+  // Writes a duration as microseconds with three decimals, e.g. "1250.000".
+  template <std::output_iterator<char> OutputIt>
+  static OutputIt write_microseconds(OutputIt out, duration d)
+  {
+    auto ns = dtz::duration_cast<nanoseconds>(d).count();
+    if (ns < 0) {
+      *out++ = '-';
+      ns = -ns;
+    }
+    out = internal::write<1>(out, ns / 1000);
+    *out++ = '.';
+    return internal::write<3>(out, ns % 1000);
+  }
+
+  template <std::output_iterator<char> OutputIt>
+  static OutputIt write_escaped(OutputIt out, std::string_view str)
+  {
+    for (const auto c : str) {
+      if (c == '"' || c == '\\') {
+        *out++ = '\\';
+        *out++ = c;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        out = internal::write(out, "\\u00");
+        *out++ = "0123456789abcdef"[(c >> 4) & 0xF];
+        *out++ = "0123456789abcdef"[c & 0xF];
+      } else {
+        *out++ = c;
+      }
+    }
+    return out;
+  }
+
+  std::size_t capacity_ = 0;
+  std::size_t mask_ = 0;
+  std::size_t threads_ = 0;
+  std::unique_ptr<ring[]> rings_;
+  std::atomic<std::uint64_t> dropped_{ 0 };
+  time_point origin_;
+  sys_time<system_clock::duration> wall_origin_;
+  mutable std::mutex mutex_;
+  std::vector<std::string> names_;
+};
+
+}  // namespace dtz
@@ -0,0 +1,269 @@
+#pragma once
+#include "chrono.hpp"
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+
+namespace dtz {
+namespace internal {
+
+// Each step returns the first candidate date at or after a given date and the candidate following a candidate.
+
+struct day_step
+{
+  [[nodiscard]] constexpr local_days first(local_days d) const noexcept
+  {
+    return d;
+  }
+
+  [[nodiscard]] constexpr local_days next(local_days d) const noexcept
+  {
+    return d + days{ 1 };
+  }
+};
+
+struct week_step
+{
+  weekday wd;
+
+  [[nodiscard]] constexpr local_days first(local_days d) const noexcept
+  {
+    return d + (wd - weekday{ d });
+  }
+
+  [[nodiscard]] constexpr local_days next(local_days d) const noexcept
+  {
+    return d + weeks{ 1 };
+  }
+};
+
+// Selects the last day of the month in month_step.
+struct last_day
+{};
+
+// Produces the day (or weekday_indexed, last_day, weekday for its last occurrence) of every stride months,
+// skipping months where it does not exist (e.g. the 5th Friday). Spec types must be default constructible.
+template <typename Spec>
+struct month_step
+{
+  Spec spec;
+  int stride = 1;
+
+  [[nodiscard]] constexpr local_days first(local_days d) const noexcept
+  {
+    const auto ymd = year_month_day{ d };
+    auto ym = ymd.year() / ymd.month();
+    ym -= months{ static_cast<int>((static_cast<unsigned>(ym.month()) - 1) % static_cast<unsigned>(stride)) };
+    for (;; ym += months{ stride }) {
+      if (const auto c = make(ym); c.ok() && local_days{ c } >= d) {
+        return local_days{ c };
+      }
+    }
+  }
+
+  [[nodiscard]] constexpr local_days next(local_days d) const noexcept
+  {
+    const auto ymd = year_month_day{ d };
+    for (auto ym = ymd.year() / ymd.month() + months{ stride };; ym += months{ stride }) {
+      if (const auto c = make(ym); c.ok()) {
+        return local_days{ c };
+      }
+    }
+  }
+
+  [[nodiscard]] constexpr auto make(year_month ym) const noexcept
+  {
+    if constexpr (std::is_same_v<Spec, last_day>) {
+      return ym / last;
+    } else if constexpr (std::is_same_v<Spec, weekday>) {
+      return ym / spec[last];
+    } else {
+      return ym / spec;
+    }
+  }
+};
+
+// Offset of a local time range [begin, end) in sys_seconds. The string in sys_info is not needed here.
+struct offset_info
+{
+  sys_time<seconds> begin;
+  sys_time<seconds> end;
+  seconds offset{ 0 };
+};
+
+// Generates local times from Step in a zone and yields their sys_time, with choose::earliest semantics
+// for local times that are ambiguous or do not exist. Local times increase, so the offset of the
+// previous value stays valid until the next zone transition and is only looked up again after it.
+template <typename Step>
+class calendar_view : public std::ranges::view_interface<calendar_view<Step>>
+{
+public:
+  class iterator
+  {
+  public:
+    using iterator_concept = std::forward_iterator_tag;
+    using value_type = sys_time<seconds>;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() = default;
+
+    iterator(const time_zone* zone, Step step, local_days date, seconds tod, sys_time<seconds> end) noexcept :
+      zone_(zone), step_(step), date_(date), tod_(tod), end_(end)
+    {
+      update();
+    }
+
+    [[nodiscard]] value_type operator*() const noexcept
+    {
+      return value_;
+    }
+
+    iterator& operator++() noexcept
+    {
+      date_ = step_.next(date_);
+      update();
+      return *this;
+    }
+
+    iterator operator++(int) noexcept
+    {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+
+    [[nodiscard]] bool operator==(const iterator& other) const noexcept
+    {
+      return value_ == other.value_;
+    }
+
+    [[nodiscard]] bool operator==(std::default_sentinel_t) const noexcept
+    {
+      return value_ >= end_;
+    }
+
+  private:
+    void update() noexcept
+    {
+      const auto lt = date_ + tod_;
+      const auto st = sys_time<seconds>{ lt.time_since_epoch() - info_.offset };
+      if (st >= info_.begin && st < info_.end) {
+        value_ = st;
+        return;
+      }
+      value_ = zone_->to_sys(lt, choose::earliest);
+      const auto info = zone_->get_info(value_);
+      info_ = { info.begin, info.end, info.offset };
+    }
+
+    const time_zone* zone_ = nullptr;
+    Step step_{};
+    local_days date_{};
+    seconds tod_{ 0 };
+    sys_time<seconds> end_{};
+    sys_time<seconds> value_{};
+    offset_info info_{};
+  };
+
+  calendar_view() = default;
+
+  calendar_view(const time_zone* zone, Step step, sys_time<seconds> begin, sys_time<seconds> end, seconds tod) noexcept :
+    zone_(zone), step_(step), begin_(begin), end_(end), tod_(tod)
+  {}
+
+  // Starts at the first candidate on the local date of begin and skips the ones before begin. Empty
+  // ranges are not searched, so steps without any candidate can be represented by them.
+  [[nodiscard]] iterator begin() const noexcept
+  {
+    if (!(begin_ < end_)) {
+      return {};
+    }
+    auto it = iterator{ zone_, step_, step_.first(floor<days>(zone_->to_local(begin_) - tod_)), tod_, end_ };
+    while (*it < begin_) {
+      ++it;
+    }
+    return it;
+  }
+
+  [[nodiscard]] std::default_sentinel_t end() const noexcept
+  {
+    return {};
+  }
+
+private:
+  const time_zone* zone_ = nullptr;
+  Step step_{};
+  sys_time<seconds> begin_{};
+  sys_time<seconds> end_{};
+  seconds tod_{ 0 };
+};
+
+}  // namespace internal
+
+namespace views {
+
+// Every local midnight (or local tod) in zone in [begin, end).
+[[nodiscard]] inline auto days(const time_zone* zone, sys_time<seconds> begin, sys_time<seconds> end, seconds tod = {}) noexcept
+{
+  return internal::calendar_view<internal::day_step>{ zone, {}, begin, end, tod };
+}
+
+// Every weekday wd in zone in [begin, end).
+[[nodiscard]] inline auto weeks(const time_zone* zone, weekday wd, sys_time<seconds> begin, sys_time<seconds> end, seconds tod = {}) noexcept
+{
+  return internal::calendar_view<internal::week_step>{ zone, { wd }, begin, end, tod };
+}
+
+// The first day of every month in zone in [begin, end).
+[[nodiscard]] inline auto months(const time_zone* zone, sys_time<seconds> begin, sys_time<seconds> end, seconds tod = {}) noexcept
+{
+  using step = internal::month_step<day>;
+  return internal::calendar_view<step>{ zone, { day{ 1 } }, begin, end, tod };
+}
+
+// The first day of every quarter in zone in [begin, end).
+[[nodiscard]] inline auto quarters(const time_zone* zone, sys_time<seconds> begin, sys_time<seconds> end, seconds tod = {}) noexcept
+{
+  using step = internal::month_step<day>;
+  return internal::calendar_view<step>{ zone, { day{ 1 }, 3 }, begin, end, tod };
+}
+
+// The first day of every year in zone in [begin, end).
+[[nodiscard]] inline auto years(const time_zone* zone, sys_time<seconds> begin, sys_time<seconds> end, seconds tod = {}) noexcept
+{
+  using step = internal::month_step<day>;
+  return internal::calendar_view<step>{ zone, { day{ 1 }, 12 }, begin, end, tod };
+}
+
+// The last day of every month in zone in [begin, end).
+[[nodiscard]] inline auto month_last(const time_zone* zone, sys_time<seconds> begin, sys_time<seconds> end, seconds tod = {}) noexcept
+{
+  using step = internal::month_step<internal::last_day>;
+  return internal::calendar_view<step>{ zone, {}, begin, end, tod };
+}
+
+// The indexed weekday (e.g. fri[2]) of every month in zone in [begin, end). Months without it are skipped.
+// The view is empty if wdi is not ok (e.g. fri[0] or fri[6]), which no month has.
+[[nodiscard]] inline auto weekday_indexed(const time_zone* zone, dtz::weekday_indexed wdi, sys_time<seconds> begin, sys_time<seconds> end, seconds tod = {}) noexcept
+{
+  using step = internal::month_step<dtz::weekday_indexed>;
+  return internal::calendar_view<step>{ zone, { wdi }, begin, wdi.ok() ? end : begin, tod };
+}
+
+// The last weekday (e.g. fri[last]) of every month in zone in [begin, end). The view is empty if wdl is not ok.
+[[nodiscard]] inline auto weekday_last(const time_zone* zone, dtz::weekday_last wdl, sys_time<seconds> begin, sys_time<seconds> end, seconds tod = {}) noexcept
+{
+  using step = internal::month_step<weekday>;
+  return internal::calendar_view<step>{ zone, { wdl.weekday() }, begin, wdl.ok() ? end : begin, tod };
+}
+
+}  // namespace views
+}  // namespace dtz
+
+namespace std::ranges {
+
+template <typename Step>
+inline constexpr bool enable_borrowed_range<dtz::internal::calendar_view<Step>> = true;
+
+}  // namespace std::ranges
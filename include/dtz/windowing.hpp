@@ -0,0 +1,277 @@
+#pragma once
+#include "bucketer.hpp"
+#include "chrono.hpp"
+#include "interval_set.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <ratio>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace dtz {
+
+enum class window_kind {
+  fixed,
+  calendar,
+  session,
+};
+
+// Assigns event-time sys_time values to windows with an accumulator each and emits the windows in
+// order once the watermark passes their end.
+//
+// Fixed windows have a size and start every slide since 1970-01-01 UTC (tumbling windows when both
+// are equal). Hopping windows with a slide larger than their size leave gaps, and events in a gap are
+// skipped. Calendar windows span size local calendar units in a time zone and start at every unit,
+// with boundaries like bucketer, so local days last 23 or 25 hours around DST transitions. Session
+// windows extend every event by a gap and merge overlapping sessions with Accumulator::operator+=.
+//
+// The watermark trails the latest event time by the allowed lateness and can be raised with advance.
+// Events are added to their windows that end after the watermark. Events without such a window are
+// late and dropped. The current calendar unit and its window starts are cached, so assigning events
+// in order costs no time zone conversions until they cross into the next unit.
+template <typename Accumulator, Duration Duration = nanoseconds>
+  requires std::ratio_less_equal_v<typename Duration::period, std::ratio<1>>
+class windowing
+{
+public:
+  using time_point = sys_time<Duration>;
+  using window = interval<time_point>;
+
+  [[nodiscard]] static windowing tumbling(Duration size, Duration lateness = Duration::zero())
+  {
+    return sliding(size, size, lateness);
+  }
+
+  [[nodiscard]] static windowing sliding(Duration size, Duration slide, Duration lateness = Duration::zero())
+  {
+    if (size <= Duration::zero() || slide <= Duration::zero()) {
+      throw std::invalid_argument("window size and slide must be positive");
+    }
+    windowing result{ window_kind::fixed, lateness };
+    result.size_ = size;
+    result.slide_ = slide;
+    return result;
+  }
+
+  [[nodiscard]] static windowing tumbling(const time_zone* zone, bucket_unit unit, Duration lateness = Duration::zero())
+  {
+    return sliding(zone, unit, 1, lateness);
+  }
+
+  // Windows of size calendar units starting at every unit.
+  [[nodiscard]] static windowing sliding(const time_zone* zone, bucket_unit unit, int size, Duration lateness = Duration::zero())
+  {
+    if (size <= 0) {
+      throw std::invalid_argument("window size must be positive");
+    }
+    windowing result{ window_kind::calendar, lateness };
+    result.bucketer_.emplace(zone, unit, sys_time<seconds>{}, sys_time<seconds>{});
+    result.units_ = static_cast<std::size_t>(size);
+    return result;
+  }
+
+  [[nodiscard]] static windowing session(Duration gap, Duration lateness = Duration::zero())
+    requires requires(Accumulator& a, Accumulator&& b) { a += std::move(b); }
+  {
+    if (gap <= Duration::zero()) {
+      throw std::invalid_argument("session gap must be positive");
+    }
+    windowing result{ window_kind::session, lateness };
+    result.size_ = gap;
+    return result;
+  }
+
+  [[nodiscard]] window_kind kind() const noexcept
+  {
+    return kind_;
+  }
+
+  // Calls update(Accumulator&) for every open window of the event. Returns false if the event was added
+  // to no window, because it is late or because it falls between hopping windows (slide > size).
+  // These events are counted by late and skipped.
+  template <typename Update>
+  bool add(time_point tp, Update update)
+  {
+    if (!seen_ || tp > latest_) {
+      latest_ = tp;
+      seen_ = true;
+      raise(tp - lateness_);
+    }
+    auto added = false;
+    switch (kind_) {
+    case window_kind::fixed: {
+      // Windows [k * slide, k * slide + size) that contain tp, from the latest start back.
+      auto offset = tp.time_since_epoch() % slide_;
+      if (offset < Duration::zero()) {
+        offset += slide_;
+      }
+      if (!(offset < size_)) {
+        skipped_++;
+        return false;
+      }
+      for (auto begin = tp - offset; tp < begin + size_; begin -= slide_) {
+        if (watermark_ < begin + size_) {
+          update(get({ begin, begin + size_ }));
+          added = true;
+        }
+      }
+      break;
+    }
+    case window_kind::calendar:
+      assign(tp);
+      for (std::size_t i = 0; i < starts_.size() - units_; i++) {
+        const auto w = window{ starts_[i], starts_[i + units_] };
+        if (watermark_ < w.end) {
+          update(get(w));
+          added = true;
+        }
+      }
+      break;
+    case window_kind::session:
+      if (watermark_ < tp + size_) {
+        update(merge({ tp, tp + size_ }));
+        added = true;
+      }
+      break;
+    }
+    if (!added) {
+      late_++;
+    }
+    return added;
+  }
+
+  // Raises the watermark, e.g. when the stream is idle.
+  void advance(time_point watermark) noexcept
+  {
+    raise(watermark);
+  }
+
+  // Calls emit(const window&, Accumulator&&) for every window that ends at or before the watermark in
+  // order of their start and removes them.
+  template <typename Emit>
+  void poll(Emit emit)
+  {
+    while (!windows_.empty() && !(watermark_ < windows_.front().first.end)) {
+      auto w = std::move(windows_.front());
+      windows_.pop_front();
+      emit(w.first, std::move(w.second));
+    }
+  }
+
+  // Emits every open window.
+  template <typename Emit>
+  void flush(Emit emit)
+  {
+    while (!windows_.empty()) {
+      auto w = std::move(windows_.front());
+      windows_.pop_front();
+      emit(w.first, std::move(w.second));
+    }
+  }
+
+  [[nodiscard]] time_point watermark() const noexcept
+  {
+    return watermark_;
+  }
+
+  // Returns the number of open windows.
+  [[nodiscard]] std::size_t size() const noexcept
+  {
+    return windows_.size();
+  }
+
+  // Returns the number of dropped late events.
+  [[nodiscard]] std::uint64_t late() const noexcept
+  {
+    return late_;
+  }
+
+  // Returns the number of events between hopping windows, which belong to no window.
+  [[nodiscard]] std::uint64_t skipped() const noexcept
+  {
+    return skipped_;
+  }
+
+private:
+  windowing(window_kind kind, Duration lateness) noexcept : kind_(kind), lateness_(lateness)
+  {}
+
+  void raise(time_point watermark) noexcept
+  {
+    watermark_ = std::max(watermark_, watermark);
+  }
+
+  // Returns the accumulator of the window and opens it if it is new. Windows are ordered by start and
+  // searched from the back, which is where events of an ordered stream belong.
+  Accumulator& get(const window& w)
+  {
+    auto i = windows_.size();
+    while (i > 0 && w.begin < windows_[i - 1].first.begin) {
+      i--;
+    }
+    if (i > 0 && windows_[i - 1].first.begin == w.begin) {
+      return windows_[i - 1].second;
+    }
+    return windows_.emplace(windows_.begin() + static_cast<std::ptrdiff_t>(i), w, Accumulator{})->second;
+  }
+
+  // Opens a session and merges it with every open session it overlaps or touches.
+  Accumulator& merge(window w)
+  {
+    auto last = windows_.size();
+    while (last > 0 && w.end < windows_[last - 1].first.begin) {
+      last--;
+    }
+    auto first = last;
+    while (first > 0 && !(windows_[first - 1].first.end < w.begin)) {
+      first--;
+    }
+    if (first == last) {
+      return windows_.emplace(windows_.begin() + static_cast<std::ptrdiff_t>(first), w, Accumulator{})->second;
+    }
+    auto& target = windows_[first];
+    target.first.begin = std::min(target.first.begin, w.begin);
+    target.first.end = std::max(windows_[last - 1].first.end, w.end);
+    // Only session() creates session windows and it requires Accumulator::operator+=.
+    if constexpr (requires(Accumulator & a, Accumulator && b) { a += std::move(b); }) {
+      for (auto i = first + 1; i < last; i++) {
+        target.second += std::move(windows_[i].second);
+      }
+    }
+    windows_.erase(windows_.begin() + static_cast<std::ptrdiff_t>(first + 1), windows_.begin() + static_cast<std::ptrdiff_t>(last));
+    return target.second;
+  }
+
+  // Caches the starts of the units id - units + 1 to id + units for the unit id that contains tp.
+  void assign(time_point tp)
+  {
+    if (!starts_.empty() && !(tp < starts_[units_ - 1]) && tp < starts_[units_]) {
+      return;
+    }
+    const auto id = bucketer_->id(tp);
+    starts_.resize(units_ * 2);
+    for (std::size_t i = 0; i < starts_.size(); i++) {
+      starts_[i] = time_point{ bucketer_->start(id - static_cast<std::int64_t>(units_) + 1 + static_cast<std::int64_t>(i)) };
+    }
+  }
+
+  window_kind kind_ = window_kind::fixed;
+  Duration lateness_{};
+  Duration size_{};
+  Duration slide_{};
+  std::optional<bucketer> bucketer_;
+  std::size_t units_ = 1;
+  std::vector<time_point> starts_;
+  time_point latest_{};
+  time_point watermark_ = time_point::min();
+  bool seen_ = false;
+  std::uint64_t late_ = 0;
+  std::uint64_t skipped_ = 0;
+  std::deque<std::pair<window, Accumulator>> windows_;
+};
+
+}  // namespace dtz
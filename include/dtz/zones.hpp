@@ -0,0 +1,653 @@
+#pragma once
+#include "chrono.hpp"
+#include "error.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace dtz {
+
+// Time zone with a constant UTC offset like "+05:30".
+//
+// Zones are values and can be used as the TimeZonePtr of zoned_time, e.g. zoned_time<seconds, fixed_zone>.
+// Conversions are computed from the offset without the tz database.
+class fixed_zone
+{
+public:
+  constexpr fixed_zone() noexcept = default;
+
+  constexpr explicit fixed_zone(seconds offset) noexcept : offset_(offset)
+  {}
+
+  [[nodiscard]] constexpr seconds offset() const noexcept
+  {
+    return offset_;
+  }
+
+  // Returns the offset as "+HH:MM" or "+HH:MM:SS".
+  [[nodiscard]] std::string name() const;
+
+  template <Duration Duration>
+  [[nodiscard]] constexpr auto to_local(const sys_time<Duration>& tp) const noexcept
+  {
+    return local_time<std::common_type_t<Duration, seconds>>{ tp.time_since_epoch() + offset_ };
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] constexpr auto to_sys(const local_time<Duration>& lt) const noexcept
+  {
+    return sys_time<std::common_type_t<Duration, seconds>>{ lt.time_since_epoch() - offset_ };
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] constexpr auto to_sys(const local_time<Duration>& lt, choose) const noexcept
+  {
+    return to_sys(lt);
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] sys_info get_info(const sys_time<Duration>&) const
+  {
+    return { sys_time<seconds>::min(), sys_time<seconds>::max(), offset_, minutes{ 0 }, name() };
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] local_info get_info(const local_time<Duration>&) const
+  {
+    return { local_info::unique, get_info(sys_time<seconds>{}), {} };
+  }
+
+  [[nodiscard]] constexpr const fixed_zone* operator->() const noexcept
+  {
+    return this;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const fixed_zone& lhs, const fixed_zone& rhs) noexcept = default;
+
+  // zoned_time asserts that its zone is not null.
+  [[nodiscard]] friend constexpr bool operator==(const fixed_zone&, std::nullptr_t) noexcept
+  {
+    return false;
+  }
+
+private:
+  seconds offset_{};
+};
+
+// Time zone defined by a POSIX TZ string like "EST5EDT,M3.2.0,M11.1.0".
+//
+// The string names the standard time and its offset west of UTC, optionally followed by the daylight
+// saving time with its offset (one hour ahead by default) and the rules for its start and end:
+//
+//   Mm.w.d[/time]   day d (0 is Sunday) of week w (5 is the last) of month m
+//   Jn[/time]       day n from 1 to 365 ignoring February 29
+//   n[/time]        day n from 0 to 365 counting February 29
+//
+// Times are local and default to 02:00. Without rules, the US rules "M3.2.0,M11.1.0" apply. Zones are
+// values like fixed_zone and compute the transitions of a year from the rules.
+class posix_zone
+{
+public:
+  struct rule
+  {
+    char type = 'M';
+    int month = 0;
+    int week = 0;
+    int day = 0;
+    seconds time = hours{ 2 };
+
+    [[nodiscard]] constexpr local_time<seconds> at(year y) const noexcept
+    {
+      local_days d;
+      if (type == 'J') {
+        d = local_days{ y / dtz::month{ 1 } / 1 } + days{ day - 1 + (y.is_leap() && day >= 60 ? 1 : 0) };
+      } else if (type == 'n') {
+        d = local_days{ y / dtz::month{ 1 } / 1 } + days{ day };
+      } else if (week == 5) {
+        d = local_days{ y / dtz::month{ static_cast<unsigned>(month) } / weekday{ static_cast<unsigned>(day) }[last] };
+      } else {
+        d = local_days{ y / dtz::month{ static_cast<unsigned>(month) } / weekday{ static_cast<unsigned>(day) }[static_cast<unsigned>(week)] };
+      }
+      return d + time;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const rule& lhs, const rule& rhs) noexcept = default;
+  };
+
+  // UTC, with no daylight saving time.
+  constexpr posix_zone() noexcept = default;
+
+  [[nodiscard]] constexpr seconds std_offset() const noexcept
+  {
+    return std_offset_;
+  }
+
+  [[nodiscard]] constexpr seconds dst_offset() const noexcept
+  {
+    return dst_offset_;
+  }
+
+  [[nodiscard]] constexpr bool has_dst() const noexcept
+  {
+    return dst_;
+  }
+
+  [[nodiscard]] constexpr const rule& dst_start() const noexcept
+  {
+    return start_;
+  }
+
+  [[nodiscard]] constexpr const rule& dst_end() const noexcept
+  {
+    return end_;
+  }
+
+  [[nodiscard]] constexpr std::string_view std_abbrev() const noexcept
+  {
+    return { std_abbrev_.data(), std_size_ };
+  }
+
+  [[nodiscard]] constexpr std::string_view dst_abbrev() const noexcept
+  {
+    return { dst_abbrev_.data(), dst_size_ };
+  }
+
+  // Returns the TZ string. The DST offset and rule times are omitted when they are the defaults.
+  [[nodiscard]] std::string name() const;
+
+  template <Duration Duration>
+  [[nodiscard]] constexpr auto to_local(const sys_time<Duration>& tp) const noexcept
+  {
+    const auto p = find(floor<seconds>(tp));
+    return local_time<std::common_type_t<Duration, seconds>>{ tp.time_since_epoch() + p.offset };
+  }
+
+  // Throws nonexistent_local_time and ambiguous_local_time like time_zone::to_sys.
+  template <Duration Duration>
+  [[nodiscard]] constexpr auto to_sys(const local_time<Duration>& lt) const
+  {
+    const auto l = resolve(floor<seconds>(lt));
+    if (l.result == local_info::nonexistent) {
+      throw nonexistent_local_time{ lt, get_info(lt) };
+    }
+    if (l.result == local_info::ambiguous) {
+      throw ambiguous_local_time{ lt, get_info(lt) };
+    }
+    return sys_time<std::common_type_t<Duration, seconds>>{ lt.time_since_epoch() - l.first.offset };
+  }
+
+  // Returns the transition for nonexistent local times.
+  template <Duration Duration>
+  [[nodiscard]] constexpr auto to_sys(const local_time<Duration>& lt, choose choose) const noexcept
+  {
+    using Result = sys_time<std::common_type_t<Duration, seconds>>;
+    const auto l = resolve(floor<seconds>(lt));
+    if (l.result == local_info::nonexistent) {
+      return Result{ l.first.end };
+    }
+    const auto& p = l.result == local_info::ambiguous && choose == choose::latest ? l.second : l.first;
+    return Result{ lt.time_since_epoch() - p.offset };
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] sys_info get_info(const sys_time<Duration>& tp) const
+  {
+    return info(find(floor<seconds>(tp)));
+  }
+
+  template <Duration Duration>
+  [[nodiscard]] local_info get_info(const local_time<Duration>& lt) const
+  {
+    const auto l = resolve(floor<seconds>(lt));
+    if (l.result == local_info::unique) {
+      return { l.result, info(l.first), {} };
+    }
+    return { l.result, info(l.first), info(l.second) };
+  }
+
+  [[nodiscard]] constexpr const posix_zone* operator->() const noexcept
+  {
+    return this;
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const posix_zone& lhs, const posix_zone& rhs) noexcept = default;
+
+  // zoned_time asserts that its zone is not null.
+  [[nodiscard]] friend constexpr bool operator==(const posix_zone&, std::nullptr_t) noexcept
+  {
+    return false;
+  }
+
+private:
+  friend constexpr errc parse_posix_zone(std::string_view str, posix_zone& result) noexcept;
+
+  // Interval [begin, end) with a constant offset.
+  struct period
+  {
+    sys_time<seconds> begin = sys_time<seconds>::min();
+    sys_time<seconds> end = sys_time<seconds>::max();
+    seconds offset{};
+    bool dst = false;
+  };
+
+  struct resolution
+  {
+    decltype(local_info::result) result = local_info::unique;
+    period first;
+    period second;
+  };
+
+  [[nodiscard]] constexpr period find(sys_time<seconds> tp) const noexcept
+  {
+    if (!dst_) {
+      return { sys_time<seconds>::min(), sys_time<seconds>::max(), std_offset_, false };
+    }
+
+    // The transitions of the years around tp in order, with DST after the transition or not.
+    constexpr auto min = sys_days{ year{ -32766 } / 1 / 1 };
+    constexpr auto max = sys_days{ year{ 32766 } / 12 / 31 };
+    const auto y = year_month_day{ std::clamp(floor<days>(tp), min, max) }.year();
+    std::array<sys_time<seconds>, 6> transitions{};
+    const auto south = end_sys(y) < start_sys(y);
+    for (auto i = 0; i < 3; i++) {
+      const auto s = start_sys(y + years{ i - 1 });
+      const auto e = end_sys(y + years{ i - 1 });
+      transitions[static_cast<std::size_t>(i * 2)] = south ? e : s;
+      transitions[static_cast<std::size_t>(i * 2 + 1)] = south ? s : e;
+    }
+    auto i = transitions.size();
+    while (i > 0 && tp < transitions[i - 1]) {
+      i--;
+    }
+    period p;
+    p.begin = i > 0 ? transitions[i - 1] : sys_time<seconds>::min();
+    p.end = i < transitions.size() ? transitions[i] : sys_time<seconds>::max();
+    p.dst = i > 0 ? (i % 2 == 1) != south : south;
+    p.offset = p.dst ? dst_offset_ : std_offset_;
+    return p;
+  }
+
+  // Finds the periods of the earliest and latest sys_time that lt can map to.
+  [[nodiscard]] constexpr resolution resolve(local_time<seconds> lt) const noexcept
+  {
+    const auto first = find(sys_time<seconds>{ lt.time_since_epoch() - std::max(std_offset_, dst_offset_) });
+    const auto second = find(sys_time<seconds>{ lt.time_since_epoch() - std::min(std_offset_, dst_offset_) });
+    const auto valid = [&](const period& p) {
+      const auto tp = sys_time<seconds>{ lt.time_since_epoch() - p.offset };
+      return !(tp < p.begin) && tp < p.end;
+    };
+    if (first.begin == second.begin) {
+      return { local_info::unique, first, {} };
+    }
+    const auto v1 = valid(first);
+    const auto v2 = valid(second);
+    if (v1 && v2) {
+      return { local_info::ambiguous, first, second };
+    }
+    if (!v1 && !v2) {
+      return { local_info::nonexistent, first, second };
+    }
+    return { local_info::unique, v1 ? first : second, {} };
+  }
+
+  [[nodiscard]] constexpr sys_time<seconds> start_sys(year y) const noexcept
+  {
+    return sys_time<seconds>{ start_.at(y).time_since_epoch() - std_offset_ };
+  }
+
+  [[nodiscard]] constexpr sys_time<seconds> end_sys(year y) const noexcept
+  {
+    return sys_time<seconds>{ end_.at(y).time_since_epoch() - dst_offset_ };
+  }
+
+  [[nodiscard]] sys_info info(const period& p) const
+  {
+    const auto save = p.dst ? duration_cast<minutes>(dst_offset_ - std_offset_) : minutes{ 0 };
+    return { p.begin, p.end, p.offset, save, std::string{ p.dst ? dst_abbrev() : std_abbrev() } };
+  }
+
+  std::array<char, 16> std_abbrev_{ 'U', 'T', 'C' };
+  std::array<char, 16> dst_abbrev_{};
+  std::size_t std_size_ = 3;
+  std::size_t dst_size_ = 0;
+  seconds std_offset_{};
+  seconds dst_offset_{};
+  bool dst_ = false;
+  rule start_{ 'M', 3, 2, 0 };
+  rule end_{ 'M', 11, 1, 0 };
+};
+
+template <typename T>
+concept CustomTimeZone = (std::is_same_v<T, fixed_zone> || std::is_same_v<T, posix_zone>);
+
+template <>
+struct is_time_zone_ptr<fixed_zone> : std::true_type
+{};
+
+template <>
+struct is_time_zone_ptr<posix_zone> : std::true_type
+{};
+
+// ====================================================================================================================
+// Parse
+// ====================================================================================================================
+
+namespace internal {
+
+// Parses "h[:mm[:ss]]" with up to three digits and max_hours for the hours.
+inline constexpr const char* parse_zone_time(const char* cur, const char* end, int max_hours, seconds& result) noexcept
+{
+  const auto number = [&](int min_digits, int max_digits, int max, int& value) {
+    const auto beg = cur;
+    value = 0;
+    while (cur != end && *cur >= '0' && *cur <= '9' && cur - beg < max_digits) {
+      value = value * 10 + (*cur++ - '0');
+    }
+    return cur - beg >= min_digits && value <= max;
+  };
+  int h = 0;
+  int m = 0;
+  int s = 0;
+  if (!number(1, 3, max_hours, h)) {
+    return nullptr;
+  }
+  if (cur != end && *cur == ':') {
+    ++cur;
+    if (!number(2, 2, 59, m)) {
+      return nullptr;
+    }
+    if (cur != end && *cur == ':') {
+      ++cur;
+      if (!number(2, 2, 59, s)) {
+        return nullptr;
+      }
+    }
+  }
+  result = hours{ h } + minutes{ m } + seconds{ s };
+  return cur;
+}
+
+// Parses an optionally signed time. Returns nullptr on failure.
+inline constexpr const char* parse_zone_signed_time(const char* cur, const char* end, int max_hours, seconds& result) noexcept
+{
+  auto negative = false;
+  if (cur != end && (*cur == '+' || *cur == '-')) {
+    negative = *cur++ == '-';
+  }
+  cur = parse_zone_time(cur, end, max_hours, result);
+  if (negative) {
+    result = -result;
+  }
+  return cur;
+}
+
+inline constexpr const char* parse_zone_abbrev(const char* cur, const char* end, std::array<char, 16>& abbrev, std::size_t& size) noexcept
+{
+  const auto quoted = cur != end && *cur == '<';
+  if (quoted) {
+    ++cur;
+  }
+  const auto beg = cur;
+  const auto valid = [&](char c) {
+    const auto alpha = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+    return alpha || (quoted && ((c >= '0' && c <= '9') || c == '+' || c == '-'));
+  };
+  while (cur != end && valid(*cur)) {
+    ++cur;
+  }
+  size = static_cast<std::size_t>(cur - beg);
+  if (size < 3 || size > abbrev.size()) {
+    return nullptr;
+  }
+  if (quoted) {
+    if (cur == end || *cur != '>') {
+      return nullptr;
+    }
+    ++cur;
+  }
+  abbrev = {};
+  std::copy(beg, beg + size, abbrev.begin());
+  return cur;
+}
+
+inline constexpr const char* parse_zone_rule(const char* cur, const char* end, posix_zone::rule& rule) noexcept
+{
+  const auto number = [&](int min, int max, int& value) {
+    const auto beg = cur;
+    value = 0;
+    while (cur != end && *cur >= '0' && *cur <= '9' && cur - beg < 3) {
+      value = value * 10 + (*cur++ - '0');
+    }
+    return cur != beg && value >= min && value <= max;
+  };
+  rule = {};
+  if (cur != end && *cur == 'M') {
+    ++cur;
+    if (!number(1, 12, rule.month) || cur == end || *cur++ != '.' || !number(1, 5, rule.week) || cur == end || *cur++ != '.' ||
+        !number(0, 6, rule.day)) {
+      return nullptr;
+    }
+  } else if (cur != end && *cur == 'J') {
+    ++cur;
+    rule.type = 'J';
+    if (!number(1, 365, rule.day)) {
+      return nullptr;
+    }
+  } else {
+    rule.type = 'n';
+    if (!number(0, 365, rule.day)) {
+      return nullptr;
+    }
+  }
+  if (cur != end && *cur == '/') {
+    // RFC 8536 allows times from -167 to 167 hours.
+    return parse_zone_signed_time(cur + 1, end, 167, rule.time);
+  }
+  return cur;
+}
+
+}  // namespace internal
+
+// Parses "Z", "UTC" or an offset "+hh[[:]mm[[:]ss]]" optionally prefixed with "UTC" or "GMT".
+inline constexpr errc parse_fixed_zone(std::string_view str, fixed_zone& result) noexcept
+{
+  if (str == "Z" || str == "UTC" || str == "GMT") {
+    result = fixed_zone{};
+    return {};
+  }
+  if (str.starts_with("UTC") || str.starts_with("GMT")) {
+    str.remove_prefix(3);
+  }
+  if (str.empty() || (str[0] != '+' && str[0] != '-')) {
+    return errc::invalid_time_zone_format;
+  }
+  const auto negative = str[0] == '-';
+  str.remove_prefix(1);
+
+  // Insert the colons of the basic format.
+  char buffer[8] = {};
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < str.size(); i++) {
+    if (size == sizeof(buffer)) {
+      return errc::invalid_time_zone_format;
+    }
+    if (str.find(':') == std::string_view::npos && i > 0 && i % 2 == 0) {
+      buffer[size++] = ':';
+      if (size == sizeof(buffer)) {
+        return errc::invalid_time_zone_format;
+      }
+    }
+    buffer[size++] = str[i];
+  }
+  seconds offset{};
+  const auto end = buffer + size;
+  if (internal::parse_zone_time(buffer, end, 24, offset) != end) {
+    return errc::invalid_time_zone_format;
+  }
+  result = fixed_zone{ negative ? -offset : offset };
+  return {};
+}
+
+inline constexpr errc parse_posix_zone(std::string_view str, posix_zone& result) noexcept
+{
+  const char* cur = str.data();
+  const char* const end = cur + str.size();
+  posix_zone zone;
+  if (cur = internal::parse_zone_abbrev(cur, end, zone.std_abbrev_, zone.std_size_); !cur) {
+    return errc::invalid_time_zone_format;
+  }
+  if (cur = internal::parse_zone_signed_time(cur, end, 24, zone.std_offset_); !cur) {
+    return errc::invalid_time_zone_format;
+  }
+
+  // The offsets are west of UTC.
+  zone.std_offset_ = -zone.std_offset_;
+  if (cur != end) {
+    zone.dst_ = true;
+    if (cur = internal::parse_zone_abbrev(cur, end, zone.dst_abbrev_, zone.dst_size_); !cur) {
+      return errc::invalid_time_zone_format;
+    }
+    zone.dst_offset_ = zone.std_offset_ + hours{ 1 };
+    if (cur != end && *cur != ',') {
+      if (cur = internal::parse_zone_signed_time(cur, end, 24, zone.dst_offset_); !cur) {
+        return errc::invalid_time_zone_format;
+      }
+      zone.dst_offset_ = -zone.dst_offset_;
+    }
+    if (cur != end) {
+      if (*cur++ != ',' || !(cur = internal::parse_zone_rule(cur, end, zone.start_))) {
+        return errc::invalid_time_zone_format;
+      }
+      if (cur == end || *cur++ != ',' || !(cur = internal::parse_zone_rule(cur, end, zone.end_))) {
+        return errc::invalid_time_zone_format;
+      }
+    }
+  }
+  if (cur != end) {
+    return errc::invalid_time_zone_format;
+  }
+  result = zone;
+  return {};
+}
+
+[[nodiscard]] inline constexpr fixed_zone make_fixed_zone(std::string_view str, std::error_code& ec) noexcept
+{
+  fixed_zone result;
+  if (const auto e = parse_fixed_zone(str, result); e != errc{}) {
+    ec = std::make_error_code(e);
+    return {};
+  }
+  return result;
+}
+
+[[nodiscard]] inline fixed_zone make_fixed_zone(std::string_view str)
+{
+  std::error_code ec;
+  const auto result = make_fixed_zone(str, ec);
+  if (ec) {
+    throw std::system_error(ec, "fixed zone parse error for \"" + std::string{ str } + "\"");
+  }
+  return result;
+}
+
+[[nodiscard]] inline constexpr posix_zone make_posix_zone(std::string_view str, std::error_code& ec) noexcept
+{
+  posix_zone result;
+  if (const auto e = parse_posix_zone(str, result); e != errc{}) {
+    ec = std::make_error_code(e);
+    return {};
+  }
+  return result;
+}
+
+[[nodiscard]] inline posix_zone make_posix_zone(std::string_view str)
+{
+  std::error_code ec;
+  const auto result = make_posix_zone(str, ec);
+  if (ec) {
+    throw std::system_error(ec, "posix zone parse error for \"" + std::string{ str } + "\"");
+  }
+  return result;
+}
+
+// ====================================================================================================================
+// ZonedTime
+// ====================================================================================================================
+
+template <CustomTimeZone CustomTimeZone, SafeZonedLocalTime FromSafeZonedLocalTime>
+[[nodiscard]] inline constexpr auto make_zoned(const CustomTimeZone& zone, const FromSafeZonedLocalTime& lt) noexcept
+{
+  return zoned_time<typename FromSafeZonedLocalTime::duration, CustomTimeZone>{ zone, lt, choose::earliest };
+}
+
+template <CustomTimeZone CustomTimeZone, UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+[[nodiscard]] inline constexpr auto make_zoned(const CustomTimeZone& zone, const FromUnsafeZonedLocalTime& lt, choose choose) noexcept
+{
+  return zoned_time<typename FromUnsafeZonedLocalTime::duration, CustomTimeZone>{ zone, lt, choose };
+}
+
+template <CustomTimeZone CustomTimeZone, UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+[[nodiscard]] inline constexpr auto make_zoned(const CustomTimeZone& zone, const FromUnsafeZonedLocalTime& lt)
+{
+  return zoned_time<typename FromUnsafeZonedLocalTime::duration, CustomTimeZone>(zone, lt);
+}
+
+template <CustomTimeZone CustomTimeZone, UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+[[nodiscard]] inline auto make_zoned(const CustomTimeZone& zone, const FromUnsafeZonedLocalTime& lt, std::error_code& ec) noexcept
+{
+  using Duration = typename FromUnsafeZonedLocalTime::duration;
+  ec.clear();
+  const auto info = zone.get_info(lt);
+  if (info.result == local_info::ambiguous) {
+    ec = std::make_error_code(errc::ambiguous_local_time);
+  } else if (info.result == local_info::nonexistent) {
+    ec = std::make_error_code(errc::nonexistent_local_time);
+  } else {
+    return zoned_time<Duration, CustomTimeZone>{ zone, lt, choose::earliest };
+  }
+  return zoned_time<Duration, CustomTimeZone>{ zone, sys_time<Duration>{} };
+}
+
+template <CustomTimeZone CustomTimeZone, Clock FromClock, ValidZonedTimeDuration FromValidZonedTimeDuration>
+[[nodiscard]] inline constexpr auto make_zoned(const CustomTimeZone& zone, const time_point<FromClock, FromValidZonedTimeDuration>& tp) noexcept
+{
+  return zoned_time<FromValidZonedTimeDuration, CustomTimeZone>{ zone, tp };
+}
+
+}  // namespace dtz
+
+namespace date {
+
+template <>
+struct zoned_traits<dtz::fixed_zone>
+{
+  static dtz::fixed_zone default_zone() noexcept
+  {
+    return {};
+  }
+
+  static dtz::fixed_zone locate_zone(std::string_view name)
+  {
+    return dtz::make_fixed_zone(name);
+  }
+};
+
+template <>
+struct zoned_traits<dtz::posix_zone>
+{
+  static dtz::posix_zone default_zone() noexcept
+  {
+    return {};
+  }
+
+  static dtz::posix_zone locate_zone(std::string_view name)
+  {
+    return dtz::make_posix_zone(name);
+  }
+};
+
+}  // namespace date
@@ -0,0 +1,84 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+using time_point = dtz::sys_time<dtz::milliseconds>;
+
+// Corpus time points as "YYYY-MM-DDTHH:MM:SS.fffZ".
+const std::vector<std::string>& iso_8601()
+{
+  static const auto strings = [] {
+    auto strings = corpus::strings<time_point>();
+    for (auto& str : strings) {
+      str[10] = 'T';
+      str += 'Z';
+    }
+    return strings;
+  }();
+  return strings;
+}
+
+// Tries the layouts one after another and rewrites ISO 8601 values for parse.
+time_point parse_each(std::string_view str, std::error_code& ec)
+{
+  ec.clear();
+  if (const auto tp = dtz::parse<time_point>(str, ec); !ec) {
+    return tp;
+  }
+  if (str.size() > 10 && str[10] == 'T') {
+    std::string copy{ str.substr(0, str.size() - (str.back() == 'Z' ? 1 : 0)) };
+    copy[10] = ' ';
+    ec.clear();
+    return dtz::parse<time_point>(copy, ec);
+  }
+  return {};
+}
+
+}  // namespace
+
+static void adaptive_parser_date_time(benchmark::State& state)
+{
+  const auto& strings = corpus::strings<time_point>();
+  dtz::adaptive_parser<dtz::milliseconds> parser;
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(parser.parse(corpus::at(strings, i), ec));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(adaptive_parser_date_time);
+
+static void adaptive_parser_iso_8601(benchmark::State& state)
+{
+  const auto& strings = iso_8601();
+  dtz::adaptive_parser<dtz::milliseconds> parser;
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(parser.parse(corpus::at(strings, i), ec));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(adaptive_parser_iso_8601);
+
+// Tries parse before the ISO 8601 layout for every value.
+static void adaptive_parser_each_iso_8601(benchmark::State& state)
+{
+  const auto& strings = iso_8601();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(parse_each(corpus::at(strings, i), ec));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(adaptive_parser_each_iso_8601);
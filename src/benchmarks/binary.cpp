@@ -0,0 +1,103 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Sorted sys times one second apart with occasional jitter, like a series of sensor readings.
+static const std::vector<dtz::sys_time<dtz::nanoseconds>>& binary_series()
+{
+  static const auto values = [] {
+    std::mt19937_64 engine{ corpus::seed };
+    std::vector<dtz::sys_time<dtz::nanoseconds>> result;
+    auto tp = dtz::sys_time<dtz::nanoseconds>{ dtz::sys_days{ dtz::year{ 2021 } / 1 / 1 } };
+    for (std::size_t i = 0; i < corpus::size * 64; i++) {
+      tp += dtz::seconds{ 1 } + dtz::milliseconds{ corpus::random(engine, 0, 99) == 0 ? corpus::random(engine, 1, 999) : 0 };
+      result.push_back(tp);
+    }
+    return result;
+  }();
+  return values;
+}
+
+static void dtz_encode_fixed(benchmark::State& state)
+{
+  const auto& values = binary_series();
+  std::vector<std::byte> buffer(values.size() * 8);
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(dtz::encode_fixed(values, buffer.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(buffer.size()));
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+BENCHMARK(dtz_encode_fixed);
+
+static void dtz_encode_column(benchmark::State& state)
+{
+  const auto& values = binary_series();
+  std::vector<std::byte> buffer;
+  dtz::encode_column(values, buffer);
+  for (auto _ : counters::loop{ state }) {
+    buffer.clear();
+    dtz::encode_column(values, buffer);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+  state.counters["bytes_per_value"] = static_cast<double>(buffer.size()) / static_cast<double>(values.size());
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(values.size() * 8));
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+BENCHMARK(dtz_encode_column);
+
+static void dtz_decode_column(benchmark::State& state)
+{
+  const auto& values = binary_series();
+  std::vector<std::byte> buffer;
+  dtz::encode_column(values, buffer);
+  std::vector<dtz::sys_time<dtz::nanoseconds>> decoded;
+  decoded.reserve(values.size());
+  for (auto _ : counters::loop{ state }) {
+    decoded.clear();
+    benchmark::DoNotOptimize(dtz::decode_column(buffer, decoded));
+  }
+  if (decoded != values) {
+    state.SkipWithError("decoded values differ");
+  }
+  state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(values.size() * 8));
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+BENCHMARK(dtz_decode_column);
+
+static void dtz_decode_zoned_column(benchmark::State& state)
+{
+  const auto& values = corpus::values<dtz::zoned_time<dtz::nanoseconds>>();
+  auto sorted = values;
+  std::sort(sorted.begin(), sorted.end(), [](const auto& lhs, const auto& rhs) { return lhs.get_sys_time() < rhs.get_sys_time(); });
+  std::vector<std::byte> buffer;
+  dtz::encode_column(sorted, buffer);
+  std::vector<dtz::zoned_time<dtz::nanoseconds>> decoded;
+  for (auto _ : counters::loop{ state }) {
+    decoded.clear();
+    benchmark::DoNotOptimize(dtz::decode_column(buffer, decoded));
+  }
+  state.counters["bytes_per_value"] = static_cast<double>(buffer.size()) / static_cast<double>(values.size());
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+BENCHMARK(dtz_decode_zoned_column);
+
+// The text format the codec replaces.
+static void dtz_format_series(benchmark::State& state)
+{
+  const auto& values = binary_series();
+  std::vector<char> buffer(values.size() * dtz::traits<dtz::sys_time<dtz::nanoseconds>>::buffer_size);
+  for (auto _ : counters::loop{ state }) {
+    auto out = buffer.data();
+    for (const auto& value : values) {
+      out = dtz::format_to(out, value);
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+BENCHMARK(dtz_format_series);
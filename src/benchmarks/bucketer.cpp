@@ -0,0 +1,63 @@
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace dtz::literals;
+
+static std::vector<dtz::sys_time<dtz::milliseconds>> bucketer_events()
+{
+  const auto begin = dtz::sys_days{ 2020_y / 1 / 1 };
+  std::mt19937_64 random{ 42 };
+  std::uniform_int_distribution<std::int64_t> distribution{ 0, 366LL * 86400 * 1000 - 1 };
+  std::vector<dtz::sys_time<dtz::milliseconds>> events(1 << 16);
+  for (auto& event : events) {
+    event = begin + dtz::milliseconds{ distribution(random) };
+  }
+  return events;
+}
+
+static void dtz_bucketer_ids_day(benchmark::State& state)
+{
+  const auto events = bucketer_events();
+  const dtz::bucketer bucketer{ dtz::locate_zone("Europe/Berlin"), dtz::bucket_unit::day,
+    dtz::sys_days{ 2020_y / 1 / 1 }, dtz::sys_days{ 2021_y / 1 / 1 } };
+  std::vector<std::int64_t> ids(events.size());
+  for (auto _ : state) {
+    bucketer.ids(std::span{ events }, std::span{ ids });
+    benchmark::DoNotOptimize(ids.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(dtz_bucketer_ids_day);
+
+static void dtz_bucketer_starts_month(benchmark::State& state)
+{
+  const auto events = bucketer_events();
+  const dtz::bucketer bucketer{ dtz::locate_zone("Europe/Berlin"), dtz::bucket_unit::month,
+    dtz::sys_days{ 2020_y / 1 / 1 }, dtz::sys_days{ 2021_y / 1 / 1 } };
+  std::vector<dtz::sys_time<dtz::seconds>> starts(events.size());
+  for (auto _ : state) {
+    bucketer.starts(std::span{ events }, std::span{ starts });
+    benchmark::DoNotOptimize(starts.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(dtz_bucketer_starts_month);
+
+static void dtz_make_zoned_floor_day(benchmark::State& state)
+{
+  const auto events = bucketer_events();
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  std::vector<std::int64_t> ids(events.size());
+  for (auto _ : state) {
+    for (std::size_t i = 0; i < events.size(); i++) {
+      const auto zon = dtz::make_zoned(zone, events[i]);
+      ids[i] = dtz::floor<dtz::days>(zon.get_local_time()).time_since_epoch().count();
+    }
+    benchmark::DoNotOptimize(ids.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(dtz_make_zoned_floor_day);
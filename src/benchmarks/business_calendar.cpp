@@ -0,0 +1,49 @@
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <set>
+#include <vector>
+
+using namespace dtz::literals;
+
+static const std::vector<dtz::year_month_day> business_calendar_holidays{
+  2020_y / 1 / 1, 2020_y / 4 / 10, 2020_y / 4 / 13, 2020_y / 5 / 1, 2020_y / 12 / 24, 2020_y / 12 / 25, 2020_y / 12 / 31,
+};
+
+static void dtz_business_calendar_add_business_days(benchmark::State& state)
+{
+  const std::vector<dtz::weekday> weekend{ dtz::sat, dtz::sun };
+  const dtz::business_calendar calendar{ 2000_y, 2050_y, weekend, business_calendar_holidays };
+  auto ymd = dtz::year_month_day{ 2020_y / 1 / 1 };
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(calendar.add_business_days(ymd, 10));
+  }
+}
+BENCHMARK(dtz_business_calendar_add_business_days);
+
+static void dtz_business_calendar_naive_add_business_days(benchmark::State& state)
+{
+  const std::set<dtz::year_month_day> holidays{ business_calendar_holidays.begin(), business_calendar_holidays.end() };
+  const auto ymd = dtz::year_month_day{ 2020_y / 1 / 1 };
+  for (auto _ : state) {
+    auto day = dtz::sys_days{ ymd };
+    for (auto n = 10; n > 0;) {
+      day += dtz::days{ 1 };
+      const auto wd = dtz::weekday{ day };
+      if (wd != dtz::sat && wd != dtz::sun && !holidays.contains(dtz::year_month_day{ day })) {
+        n--;
+      }
+    }
+    benchmark::DoNotOptimize(day);
+  }
+}
+BENCHMARK(dtz_business_calendar_naive_add_business_days);
+
+static void dtz_business_calendar_business_days_between(benchmark::State& state)
+{
+  const std::vector<dtz::weekday> weekend{ dtz::sat, dtz::sun };
+  const dtz::business_calendar calendar{ 2000_y, 2050_y, weekend, business_calendar_holidays };
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(calendar.business_days_between(2001_y / 3 / 1, 2040_y / 7 / 1));
+  }
+}
+BENCHMARK(dtz_business_calendar_business_days_between);
@@ -0,0 +1,83 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <algorithm>
+#include <vector>
+
+static const std::vector<dtz::zoned_time<dtz::milliseconds>>& zoned_events()
+{
+  static const auto values = corpus::values<dtz::zoned_time<dtz::milliseconds>>();
+  return values;
+}
+
+static void dtz_compact_zoned_from_zoned_time(benchmark::State& state)
+{
+  const auto& values = zoned_events();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto czt = dtz::compact_zoned<>{ corpus::at(values, i) };
+    benchmark::DoNotOptimize(czt);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_compact_zoned_from_zoned_time);
+
+static void dtz_compact_zoned_format(benchmark::State& state)
+{
+  std::vector<dtz::compact_zoned<>> values;
+  for (const auto& zt : zoned_events()) {
+    values.emplace_back(zt);
+  }
+  char buffer[dtz::traits<dtz::compact_zoned<>>::buffer_size];
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(dtz::format_to(buffer, corpus::at(values, i)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_compact_zoned_format);
+
+static void dtz_zoned_time_format(benchmark::State& state)
+{
+  const auto& values = zoned_events();
+  char buffer[dtz::traits<dtz::zoned_time<dtz::milliseconds>>::buffer_size];
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(dtz::format_to(buffer, corpus::at(values, i)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_zoned_time_format);
+
+// Sorting an event table by time, where the element size decides the memory traffic.
+template <typename T>
+static void sort_events(benchmark::State& state, const std::vector<T>& values)
+{
+  std::vector<T> sorted;
+  for (auto _ : counters::loop{ state }) {
+    state.PauseTiming();
+    sorted = values;
+    state.ResumeTiming();
+    std::sort(sorted.begin(), sorted.end(), [](const T& lhs, const T& rhs) { return lhs.get_sys_time() < rhs.get_sys_time(); });
+    benchmark::DoNotOptimize(sorted.data());
+  }
+  state.counters["bytes_per_value"] = static_cast<double>(sizeof(T));
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+
+static void dtz_zoned_time_sort(benchmark::State& state)
+{
+  sort_events(state, zoned_events());
+}
+BENCHMARK(dtz_zoned_time_sort);
+
+static void dtz_compact_zoned_sort(benchmark::State& state)
+{
+  std::vector<dtz::compact_zoned<>> values;
+  for (const auto& zt : zoned_events()) {
+    values.emplace_back(zt);
+  }
+  sort_events(state, values);
+}
+BENCHMARK(dtz_compact_zoned_sort);
@@ -0,0 +1,122 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Fixed input corpora for the benchmarks. Every corpus is generated from the same seed, so results of
+// different runs and builds measure the same inputs and can be compared in the JSON output.
+namespace corpus {
+
+inline constexpr std::size_t size = 1 << 12;
+inline constexpr std::uint64_t seed = 42;
+
+// Time zones with fixed offsets, hourly DST, and offsets that are not whole hours.
+inline constexpr std::string_view zones[] = {
+  "UTC",
+  "Europe/Berlin",
+  "Europe/London",
+  "America/New_York",
+  "America/Los_Angeles",
+  "Asia/Kolkata",
+  "Asia/Kathmandu",
+};
+
+inline std::int64_t random(std::mt19937_64& engine, std::int64_t min, std::int64_t max)
+{
+  return std::uniform_int_distribution<std::int64_t>{ min, max }(engine);
+}
+
+// Local times and time points between 1970 and 2100.
+template <typename T>
+inline T make(std::mt19937_64& engine)
+{
+  if constexpr (dtz::Duration<T>) {
+    return dtz::duration_cast<T>(dtz::nanoseconds{ random(engine, 0, 86'400'000'000'000 - 1) });
+  } else if constexpr (dtz::TimePointOrLocalTime<T>) {
+    return dtz::floor<typename T::duration>(T{} + dtz::nanoseconds{ random(engine, 0, 4'102'444'800'000'000'000 - 1) });
+  } else if constexpr (dtz::ZonedTime<T>) {
+    const auto zone = dtz::locate_zone(zones[static_cast<std::size_t>(random(engine, 0, std::size(zones) - 1))]);
+    return T{ zone, make<dtz::sys_time<typename dtz::is_zoned_time<T>::duration>>(engine) };
+  } else if constexpr (dtz::HHMMSS<T>) {
+    return T{ make<typename T::precision>(engine) };
+  } else {
+    const auto ymd = dtz::year_month_day{ make<dtz::sys_days>(engine) };
+    const auto wdi = dtz::weekday_indexed{ dtz::weekday{ dtz::sys_days{ ymd } }, static_cast<unsigned>(ymd.day()) / 7 + 1 };
+    const auto wdl = dtz::weekday_last{ dtz::weekday{ dtz::sys_days{ ymd } } };
+    if constexpr (std::is_same_v<T, dtz::day>) {
+      return ymd.day();
+    } else if constexpr (std::is_same_v<T, dtz::month>) {
+      return ymd.month();
+    } else if constexpr (std::is_same_v<T, dtz::year>) {
+      return ymd.year();
+    } else if constexpr (std::is_same_v<T, dtz::weekday>) {
+      return wdi.weekday();
+    } else if constexpr (std::is_same_v<T, dtz::weekday_indexed>) {
+      return wdi;
+    } else if constexpr (std::is_same_v<T, dtz::weekday_last>) {
+      return wdl;
+    } else if constexpr (std::is_same_v<T, dtz::month_day>) {
+      return ymd.month() / ymd.day();
+    } else if constexpr (std::is_same_v<T, dtz::month_day_last>) {
+      return ymd.month() / dtz::last;
+    } else if constexpr (std::is_same_v<T, dtz::month_weekday>) {
+      return ymd.month() / wdi;
+    } else if constexpr (std::is_same_v<T, dtz::month_weekday_last>) {
+      return ymd.month() / wdl;
+    } else if constexpr (std::is_same_v<T, dtz::year_month>) {
+      return ymd.year() / ymd.month();
+    } else if constexpr (std::is_same_v<T, dtz::year_month_day>) {
+      return ymd;
+    } else if constexpr (std::is_same_v<T, dtz::year_month_day_last>) {
+      return ymd.year() / ymd.month() / dtz::last;
+    } else if constexpr (std::is_same_v<T, dtz::year_month_weekday>) {
+      return ymd.year() / ymd.month() / wdi;
+    } else {
+      return ymd.year() / ymd.month() / wdl;
+    }
+  }
+}
+
+template <typename T>
+inline const std::vector<T>& values()
+{
+  static const auto values = [] {
+    std::mt19937_64 engine{ seed };
+    std::vector<T> result;
+    result.reserve(size);
+    for (std::size_t i = 0; i < size; i++) {
+      result.push_back(make<T>(engine));
+    }
+    return result;
+  }();
+  return values;
+}
+
+// Formatted values.
+template <typename T>
+inline const std::vector<std::string>& strings()
+{
+  static const auto strings = [] {
+    std::vector<std::string> result;
+    result.reserve(size);
+    for (const auto& value : values<T>()) {
+      result.push_back(dtz::format(value));
+    }
+    return result;
+  }();
+  return strings;
+}
+
+// Returns the corpus entry for an iteration.
+template <typename T>
+inline const T& at(const std::vector<T>& corpus, std::size_t& i) noexcept
+{
+  return corpus[i++ & (size - 1)];
+}
+
+}  // namespace corpus
@@ -0,0 +1,277 @@
+#include "counters.hpp"
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <new>
+#include <string_view>
+
+#ifdef __linux__
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+namespace counters {
+namespace {
+
+// Plain thread local counters keep the replaced operator new free of atomic instructions.
+thread_local allocations counted;
+
+bool perf = false;
+
+void* allocate(std::size_t size) noexcept
+{
+  counted.count++;
+  counted.bytes += size;
+  return std::malloc(size ? size : 1);
+}
+
+void* allocate(std::size_t size, std::align_val_t alignment) noexcept
+{
+  counted.count++;
+  counted.bytes += size;
+  const auto align = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+  return _aligned_malloc(size ? size : 1, align);
+#else
+  return std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+}
+
+void deallocate(void* p, std::align_val_t) noexcept
+{
+#ifdef _WIN32
+  _aligned_free(p);
+#else
+  std::free(p);
+#endif
+}
+
+#ifdef __linux__
+
+constexpr std::uint64_t perf_events[] = {
+  PERF_COUNT_HW_INSTRUCTIONS,
+  PERF_COUNT_HW_CACHE_MISSES,
+  PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+constexpr const char* perf_names[] = {
+  "instructions",
+  "cache_misses",
+  "branch_misses",
+};
+
+// Opens a disabled user space counter for the calling thread. Returns -1 if it is not available.
+int perf_open(std::uint64_t config) noexcept
+{
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.disabled = 1;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+#endif
+
+}  // namespace
+
+allocations thread_allocations() noexcept
+{
+  return counted;
+}
+
+void initialize(int* argc, char** argv)
+{
+  auto size = 1;
+  for (auto i = 1; i < *argc; i++) {
+    if (std::string_view{ argv[i] } == "--perf_counters") {
+      perf = true;
+    } else {
+      argv[size++] = argv[i];
+    }
+  }
+  *argc = size;
+#ifdef __linux__
+  if (perf) {
+    for (std::size_t i = 0; i < std::size(perf_events); i++) {
+      const auto fd = perf_open(perf_events[i]);
+      if (fd < 0) {
+        std::fprintf(stderr, "***WARNING*** %s counter not available (check perf_event_paranoid)\n", perf_names[i]);
+        continue;
+      }
+      close(fd);
+    }
+  }
+#else
+  if (perf) {
+    std::fputs("***WARNING*** hardware counters are only available on Linux\n", stderr);
+  }
+#endif
+}
+
+void loop::start()
+{
+#ifdef __linux__
+  if (perf) {
+    for (std::size_t i = 0; i < events_.size(); i++) {
+      events_[i] = perf_open(perf_events[i]);
+    }
+    for (const auto fd : events_) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+  }
+#endif
+  start_ = counted;
+}
+
+void loop::stop()
+{
+  end_ = counted;
+#ifdef __linux__
+  for (const auto fd : events_) {
+    if (fd >= 0) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+  for (std::size_t i = 0; i < events_.size(); i++) {
+    if (events_[i] >= 0 && read(events_[i], &values_[i], sizeof(values_[i])) != sizeof(values_[i])) {
+      close(events_[i]);
+      events_[i] = -1;
+    }
+  }
+#endif
+}
+
+loop::~loop()
+{
+#ifdef __linux__
+  for (std::size_t i = 0; i < events_.size(); i++) {
+    if (events_[i] >= 0) {
+      state_.counters[perf_names[i]] = { static_cast<double>(values_[i]), benchmark::Counter::kAvgIterations };
+      close(events_[i]);
+    }
+  }
+#endif
+  state_.counters["allocs"] = { static_cast<double>(end_.count - start_.count), benchmark::Counter::kAvgIterations };
+  state_.counters["bytes"] = { static_cast<double>(end_.bytes - start_.bytes), benchmark::Counter::kAvgIterations };
+}
+
+}  // namespace counters
+
+// ====================================================================================================================
+// Replaced allocation functions
+// ====================================================================================================================
+
+void* operator new(std::size_t size)
+{
+  if (const auto p = counters::allocate(size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size)
+{
+  return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counters::allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return counters::allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  if (const auto p = counters::allocate(size, alignment)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return counters::allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  return counters::allocate(size, alignment);
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t alignment) noexcept
+{
+  counters::deallocate(p, alignment);
+}
+
+void operator delete[](void* p, std::align_val_t alignment) noexcept
+{
+  counters::deallocate(p, alignment);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+  counters::deallocate(p, alignment);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t alignment) noexcept
+{
+  counters::deallocate(p, alignment);
+}
+
+void operator delete(void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  counters::deallocate(p, alignment);
+}
+
+void operator delete[](void* p, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+  counters::deallocate(p, alignment);
+}
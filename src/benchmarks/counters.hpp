@@ -0,0 +1,96 @@
+#pragma once
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+
+// Allocation and hardware counters reported as benchmark user counters.
+//
+// The benchmarks executable replaces the global operator new and delete to count the allocations of
+// every thread. Hardware counters are read with perf_event_open on Linux when the executable is started
+// with --perf_counters and are left out when they are not available.
+namespace counters {
+
+struct allocations
+{
+  std::uint64_t count = 0;
+  std::uint64_t bytes = 0;
+};
+
+// Returns the number and size of the allocations of the calling thread since it was started.
+allocations thread_allocations() noexcept;
+
+// Removes and applies --perf_counters from the command line. Must be called before benchmark::Initialize.
+void initialize(int* argc, char** argv);
+
+// Wraps the benchmark loop and reports allocs and bytes per iteration of the calling thread, and
+// instructions, cache_misses and branch_misses per iteration when hardware counters are enabled:
+//
+//   for (auto _ : counters::loop{ state }) { ... }
+//
+// Counting stops when the loop ends, so counters set after it (like items_per_second) are not included.
+class loop
+{
+public:
+  class iterator
+  {
+  public:
+    iterator(benchmark::State::StateIterator it, loop& parent) noexcept : it_(it), parent_(parent)
+    {}
+
+    auto operator*() const noexcept
+    {
+      return *it_;
+    }
+
+    iterator& operator++() noexcept
+    {
+      ++it_;
+      return *this;
+    }
+
+    bool operator!=(const iterator& other)
+    {
+      if (it_ != other.it_) [[likely]] {
+        return true;
+      }
+      parent_.stop();
+      return false;
+    }
+
+  private:
+    benchmark::State::StateIterator it_;
+    loop& parent_;
+  };
+
+  explicit loop(benchmark::State& state) noexcept : state_(state)
+  {}
+
+  loop(const loop& other) = delete;
+  loop& operator=(const loop& other) = delete;
+
+  ~loop();
+
+  iterator begin()
+  {
+    return { state_.begin(), *this };
+  }
+
+  iterator end()
+  {
+    auto it = state_.end();
+    start();
+    return { it, *this };
+  }
+
+private:
+  void start();
+  void stop();
+
+  benchmark::State& state_;
+  std::array<int, 3> events_{ -1, -1, -1 };
+  std::array<std::uint64_t, 3> values_{};
+  allocations start_;
+  allocations end_;
+};
+
+}  // namespace counters
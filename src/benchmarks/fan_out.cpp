@@ -0,0 +1,64 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <vector>
+
+// The corpus zones repeated to 56 zones like a world clock.
+static std::vector<const dtz::time_zone*> fan_out_zones()
+{
+  std::vector<const dtz::time_zone*> zones;
+  while (zones.size() < 56) {
+    for (const auto name : corpus::zones) {
+      zones.push_back(dtz::locate_zone(name));
+    }
+  }
+  return zones;
+}
+
+static void dtz_fan_out(benchmark::State& state)
+{
+  const auto zones = fan_out_zones();
+  const auto& values = corpus::values<dtz::sys_time<dtz::nanoseconds>>();
+  std::vector<char> buffer(zones.size() * dtz::traits<dtz::zoned_time<dtz::nanoseconds>>::buffer_size);
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(dtz::fan_out(values[i++ % values.size()], zones, buffer.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(zones.size()));
+}
+BENCHMARK(dtz_fan_out);
+
+// Consecutive events reuse the cached offsets.
+static void dtz_fan_out_zone_offsets(benchmark::State& state)
+{
+  const auto zones = fan_out_zones();
+  dtz::zone_offsets offsets{ zones };
+  const auto start = dtz::sys_time<dtz::nanoseconds>{ dtz::sys_days{ dtz::year{ 2021 } / 1 / 1 } };
+  std::vector<char> buffer(zones.size() * dtz::traits<dtz::zoned_time<dtz::nanoseconds>>::buffer_size);
+  std::int64_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(dtz::fan_out(start + dtz::milliseconds{ 1 } * i++, offsets, buffer.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(zones.size()));
+}
+BENCHMARK(dtz_fan_out_zone_offsets);
+
+// One zoned_time and format_to per zone.
+static void dtz_fan_out_make_zoned(benchmark::State& state)
+{
+  const auto zones = fan_out_zones();
+  const auto& values = corpus::values<dtz::sys_time<dtz::nanoseconds>>();
+  std::vector<char> buffer(zones.size() * dtz::traits<dtz::zoned_time<dtz::nanoseconds>>::buffer_size);
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto tp = values[i++ % values.size()];
+    auto out = buffer.data();
+    for (const auto zone : zones) {
+      out = dtz::format_to(out, dtz::make_zoned(zone, tp));
+    }
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(zones.size()));
+}
+BENCHMARK(dtz_fan_out_make_zoned);
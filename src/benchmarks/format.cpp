@@ -0,0 +1,168 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <string>
+
+using namespace dtz::literals;
+
+static const auto local_time_value = dtz::local_days{ 2020_y / 1 / 1 } + 1h + 1min + 2s + 3ms + 4us + 5ns;
+static const auto year_month_day_value = 2020_y / 1 / 1;
+
+static void dtz_format_to_fmt_memory_buffer(benchmark::State& state)
+{
+  fmt::basic_memory_buffer<char, dtz::traits<dtz::local_time<dtz::nanoseconds>>::buffer_size> buffer;
+  for (auto _ : counters::loop{ state }) {
+    buffer.clear();
+    dtz::format_to(buffer, local_time_value);
+    benchmark::DoNotOptimize(buffer.data());
+  }
+}
+BENCHMARK(dtz_format_to_fmt_memory_buffer);
+
+static void dtz_format_to_char_pointer(benchmark::State& state)
+{
+  char buffer[dtz::traits<dtz::local_time<dtz::nanoseconds>>::buffer_size];
+  for (auto _ : counters::loop{ state }) {
+    const auto end = dtz::format_to(buffer, local_time_value);
+    benchmark::DoNotOptimize(end);
+  }
+}
+BENCHMARK(dtz_format_to_char_pointer);
+
+static void dtz_fmt_format_local_time(benchmark::State& state)
+{
+  for (auto _ : counters::loop{ state }) {
+    const auto str = fmt::format("{}", local_time_value);
+    benchmark::DoNotOptimize(str.data());
+  }
+}
+BENCHMARK(dtz_fmt_format_local_time);
+
+static void dtz_fmt_format_to_local_time(benchmark::State& state)
+{
+  std::string str;
+  str.reserve(64);
+  for (auto _ : counters::loop{ state }) {
+    str.clear();
+    fmt::format_to(std::back_inserter(str), "{}", local_time_value);
+    benchmark::DoNotOptimize(str.data());
+  }
+}
+BENCHMARK(dtz_fmt_format_to_local_time);
+
+static void dtz_fmt_format_to_year_month_day(benchmark::State& state)
+{
+  std::string str;
+  str.reserve(64);
+  for (auto _ : counters::loop{ state }) {
+    str.clear();
+    fmt::format_to(std::back_inserter(str), "{}", year_month_day_value);
+    benchmark::DoNotOptimize(str.data());
+  }
+}
+BENCHMARK(dtz_fmt_format_to_year_month_day);
+
+#ifdef __cpp_lib_format
+
+static void dtz_std_format_local_time(benchmark::State& state)
+{
+  for (auto _ : counters::loop{ state }) {
+    const auto str = std::format("{}", local_time_value);
+    benchmark::DoNotOptimize(str.data());
+  }
+}
+BENCHMARK(dtz_std_format_local_time);
+
+static void dtz_std_format_to_local_time(benchmark::State& state)
+{
+  std::string str;
+  str.reserve(64);
+  for (auto _ : counters::loop{ state }) {
+    str.clear();
+    std::format_to(std::back_inserter(str), "{}", local_time_value);
+    benchmark::DoNotOptimize(str.data());
+  }
+}
+BENCHMARK(dtz_std_format_to_local_time);
+
+static void dtz_std_format_to_year_month_day(benchmark::State& state)
+{
+  std::string str;
+  str.reserve(64);
+  for (auto _ : counters::loop{ state }) {
+    str.clear();
+    std::format_to(std::back_inserter(str), "{}", year_month_day_value);
+    benchmark::DoNotOptimize(str.data());
+  }
+}
+BENCHMARK(dtz_std_format_to_year_month_day);
+
+#endif
+
+// ====================================================================================================================
+// Corpus
+// ====================================================================================================================
+
+template <typename T>
+static void dtz_format_to(benchmark::State& state)
+{
+  const auto& values = corpus::values<T>();
+  char buffer[dtz::traits<T>::buffer_size];
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto end = dtz::format_to(buffer, corpus::at(values, i));
+    benchmark::DoNotOptimize(end);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T>
+static void dtz_format(benchmark::State& state)
+{
+  const auto& values = corpus::values<T>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto str = dtz::format(corpus::at(values, i));
+    benchmark::DoNotOptimize(str.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define DTZ_FORMAT_BENCHMARK(T)         \
+  BENCHMARK_TEMPLATE(dtz_format_to, T); \
+  BENCHMARK_TEMPLATE(dtz_format, T)
+
+DTZ_FORMAT_BENCHMARK(dtz::nanoseconds);
+DTZ_FORMAT_BENCHMARK(dtz::microseconds);
+DTZ_FORMAT_BENCHMARK(dtz::milliseconds);
+DTZ_FORMAT_BENCHMARK(dtz::seconds);
+DTZ_FORMAT_BENCHMARK(dtz::minutes);
+DTZ_FORMAT_BENCHMARK(dtz::hours);
+DTZ_FORMAT_BENCHMARK(dtz::local_time<dtz::nanoseconds>);
+DTZ_FORMAT_BENCHMARK(dtz::local_time<dtz::microseconds>);
+DTZ_FORMAT_BENCHMARK(dtz::local_time<dtz::milliseconds>);
+DTZ_FORMAT_BENCHMARK(dtz::local_time<dtz::seconds>);
+DTZ_FORMAT_BENCHMARK(dtz::local_time<dtz::minutes>);
+DTZ_FORMAT_BENCHMARK(dtz::local_days);
+DTZ_FORMAT_BENCHMARK(dtz::sys_time<dtz::nanoseconds>);
+DTZ_FORMAT_BENCHMARK(dtz::sys_time<dtz::seconds>);
+DTZ_FORMAT_BENCHMARK(dtz::zoned_time<dtz::nanoseconds>);
+DTZ_FORMAT_BENCHMARK(dtz::zoned_time<dtz::seconds>);
+DTZ_FORMAT_BENCHMARK(dtz::hh_mm_ss<dtz::nanoseconds>);
+DTZ_FORMAT_BENCHMARK(dtz::hh_mm_ss<dtz::seconds>);
+DTZ_FORMAT_BENCHMARK(dtz::day);
+DTZ_FORMAT_BENCHMARK(dtz::month);
+DTZ_FORMAT_BENCHMARK(dtz::year);
+DTZ_FORMAT_BENCHMARK(dtz::weekday);
+DTZ_FORMAT_BENCHMARK(dtz::weekday_indexed);
+DTZ_FORMAT_BENCHMARK(dtz::weekday_last);
+DTZ_FORMAT_BENCHMARK(dtz::month_day);
+DTZ_FORMAT_BENCHMARK(dtz::month_day_last);
+DTZ_FORMAT_BENCHMARK(dtz::month_weekday);
+DTZ_FORMAT_BENCHMARK(dtz::month_weekday_last);
+DTZ_FORMAT_BENCHMARK(dtz::year_month);
+DTZ_FORMAT_BENCHMARK(dtz::year_month_day);
+DTZ_FORMAT_BENCHMARK(dtz::year_month_day_last);
+DTZ_FORMAT_BENCHMARK(dtz::year_month_weekday);
+DTZ_FORMAT_BENCHMARK(dtz::year_month_weekday_last);
@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <algorithm>
+#include <mutex>
+#include <random>
+#include <vector>
+
+static std::vector<dtz::nanoseconds> latencies()
+{
+  std::mt19937_64 random{ 42 };
+  std::lognormal_distribution<double> distribution{ 11.0, 1.0 };
+  std::vector<dtz::nanoseconds> values(1 << 12);
+  for (auto& value : values) {
+    value = dtz::nanoseconds{ static_cast<std::int64_t>(distribution(random)) };
+  }
+  return values;
+}
+
+static void dtz_histogram_record(benchmark::State& state)
+{
+  static dtz::histogram<dtz::nanoseconds> histogram;
+  const auto values = latencies();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    histogram.record(values[i++ & (values.size() - 1)]);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_histogram_record)->Threads(1)->Threads(4);
+
+static void std_mutex_vector_record(benchmark::State& state)
+{
+  static std::mutex mutex;
+  static std::vector<dtz::nanoseconds> recorded;
+  const auto values = latencies();
+  std::size_t i = 0;
+  for (auto _ : state) {
+    std::lock_guard lock{ mutex };
+    recorded.push_back(values[i++ & (values.size() - 1)]);
+    if (recorded.size() == 1 << 20) {
+      recorded.clear();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(std_mutex_vector_record)->Threads(1)->Threads(4);
+
+static void dtz_histogram_read(benchmark::State& state)
+{
+  dtz::histogram<dtz::nanoseconds> histogram{ 7, 8 };
+  for (const auto value : latencies()) {
+    histogram.record(value);
+  }
+  for (auto _ : state) {
+    const auto snapshot = histogram.read();
+    benchmark::DoNotOptimize(snapshot.percentile(99.0));
+  }
+}
+BENCHMARK(dtz_histogram_read);
+
+static void std_sort_percentile(benchmark::State& state)
+{
+  const auto values = latencies();
+  for (auto _ : state) {
+    auto copy = values;
+    const auto it = copy.begin() + static_cast<std::ptrdiff_t>(copy.size() * 99 / 100);
+    std::nth_element(copy.begin(), it, copy.end());
+    benchmark::DoNotOptimize(*it);
+  }
+}
+BENCHMARK(std_sort_percentile);
@@ -0,0 +1,85 @@
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <random>
+#include <vector>
+
+using namespace dtz::literals;
+
+// Maintenance windows between 5 minutes and 4 hours long within one year.
+static std::vector<dtz::interval<dtz::sys_time<dtz::seconds>>> windows(std::size_t size)
+{
+  std::mt19937_64 random{ 42 };
+  std::vector<dtz::interval<dtz::sys_time<dtz::seconds>>> result;
+  for (std::size_t i = 0; i < size; i++) {
+    const auto begin = dtz::sys_time<dtz::seconds>{ dtz::sys_days{ 2021_y / 1 / 1 } } + dtz::seconds{ static_cast<std::int64_t>(random() % 31'536'000) };
+    result.push_back({ begin, begin + dtz::seconds{ static_cast<std::int64_t>(300 + random() % 14'100) } });
+  }
+  return result;
+}
+
+static void dtz_interval_index_stab(benchmark::State& state)
+{
+  const auto intervals = windows(static_cast<std::size_t>(state.range(0)));
+  std::vector<dtz::interval_index<dtz::sys_time<dtz::seconds>>::entry> entries;
+  for (std::size_t i = 0; i < intervals.size(); i++) {
+    entries.push_back({ intervals[i], i });
+  }
+  const dtz::interval_index<dtz::sys_time<dtz::seconds>> index{ entries };
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::size_t count = 0;
+    index.stab(intervals[i].begin + 1min, [&](const auto&) { count++; });
+    benchmark::DoNotOptimize(count);
+    i = i + 1 < intervals.size() ? i + 1 : 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_interval_index_stab)->Arg(1000)->Arg(100'000);
+
+static void std_vector_stab(benchmark::State& state)
+{
+  const auto intervals = windows(static_cast<std::size_t>(state.range(0)));
+  std::size_t i = 0;
+  for (auto _ : state) {
+    const auto tp = intervals[i].begin + 1min;
+    std::size_t count = 0;
+    for (const auto& w : intervals) {
+      count += w.contains(tp);
+    }
+    benchmark::DoNotOptimize(count);
+    i = i + 1 < intervals.size() ? i + 1 : 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(std_vector_stab)->Arg(1000)->Arg(100'000);
+
+static void dtz_interval_set_insert(benchmark::State& state)
+{
+  const auto intervals = windows(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    dtz::interval_set<dtz::sys_time<dtz::seconds>> set;
+    for (const auto& w : intervals) {
+      set.insert(w);
+    }
+    benchmark::DoNotOptimize(set.size());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(dtz_interval_set_insert)->Arg(1000)->Arg(10'000);
+
+static void dtz_interval_set_contains(benchmark::State& state)
+{
+  const auto intervals = windows(static_cast<std::size_t>(state.range(0)));
+  dtz::interval_set<dtz::sys_time<dtz::seconds>> set;
+  for (const auto& w : intervals) {
+    set.insert(w);
+  }
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(set.contains(intervals[i].end));
+    i = i + 1 < intervals.size() ? i + 1 : 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_interval_set_contains)->Arg(1000)->Arg(100'000);
@@ -0,0 +1,89 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+// Corpus durations in the ISO 8601 format.
+template <typename T>
+const std::vector<std::string>& iso_strings()
+{
+  static const auto strings = [] {
+    std::vector<std::string> strings;
+    for (const auto& value : corpus::values<T>()) {
+      char buffer[dtz::iso_duration_buffer_size];
+      strings.emplace_back(buffer, dtz::format_iso_duration_to(buffer, value));
+    }
+    return strings;
+  }();
+  return strings;
+}
+
+}  // namespace
+
+template <typename T>
+static void format_iso_duration(benchmark::State& state)
+{
+  const auto& values = corpus::values<T>();
+  char buffer[dtz::iso_duration_buffer_size];
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(dtz::format_iso_duration_to(buffer, corpus::at(values, i)));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(format_iso_duration, dtz::nanoseconds);
+BENCHMARK_TEMPLATE(format_iso_duration, dtz::milliseconds);
+BENCHMARK_TEMPLATE(format_iso_duration, dtz::seconds);
+
+// The "HH:MM:SS.fff" format of the same values.
+template <typename T>
+static void format_iso_duration_hms(benchmark::State& state)
+{
+  const auto& values = corpus::values<T>();
+  char buffer[dtz::traits<T>::buffer_size];
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(dtz::format_to(buffer, corpus::at(values, i)));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(format_iso_duration_hms, dtz::nanoseconds);
+BENCHMARK_TEMPLATE(format_iso_duration_hms, dtz::milliseconds);
+BENCHMARK_TEMPLATE(format_iso_duration_hms, dtz::seconds);
+
+template <typename T>
+static void parse_iso_duration(benchmark::State& state)
+{
+  const auto& strings = iso_strings<T>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(dtz::parse_iso_duration<T>(corpus::at(strings, i), ec));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(parse_iso_duration, dtz::nanoseconds);
+BENCHMARK_TEMPLATE(parse_iso_duration, dtz::milliseconds);
+BENCHMARK_TEMPLATE(parse_iso_duration, dtz::seconds);
+
+template <typename T>
+static void parse_iso_duration_hms(benchmark::State& state)
+{
+  const auto& strings = corpus::strings<T>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(dtz::parse<T>(corpus::at(strings, i), ec));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(parse_iso_duration_hms, dtz::nanoseconds);
+BENCHMARK_TEMPLATE(parse_iso_duration_hms, dtz::milliseconds);
+BENCHMARK_TEMPLATE(parse_iso_duration_hms, dtz::seconds);
@@ -1,3 +1,4 @@
+#include "counters.hpp"
 #include <benchmark/benchmark.h>
 #include <dtz/chrono.hpp>
 #include <cstdlib>
@@ -33,6 +34,7 @@ BENCHMARK(dtz_format_to_back_insert_iterator);
 int main(int argc, char** argv)
 {
   dtz::initialize();
+  counters::initialize(&argc, argv);
   benchmark::Initialize(&argc, argv);
   if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
     return EXIT_FAILURE;
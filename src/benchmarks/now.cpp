@@ -1,10 +1,87 @@
 #include <benchmark/benchmark.h>
 #include <dtz.hpp>
+#include <system_error>
 
-//static void dtz_now(benchmark::State& state) {
-//  for (auto _ : state) {
-//    const auto str = dtz::now();
-//    benchmark::DoNotOptimize(str);
-//  }
-//}
-//BENCHMARK(dtz_now);
+static void dtz_now(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::now());
+  }
+}
+BENCHMARK(dtz_now);
+
+static void dtz_now_steady_clock(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::now<dtz::steady_clock>());
+  }
+}
+BENCHMARK(dtz_now_steady_clock);
+
+static void dtz_now_utc_clock(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::now<dtz::utc_clock>());
+  }
+}
+BENCHMARK(dtz_now_utc_clock);
+
+static void dtz_now_zone(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::now(zone));
+  }
+}
+BENCHMARK(dtz_now_zone);
+
+static void dtz_now_zone_name(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::now("Europe/Berlin"));
+  }
+}
+BENCHMARK(dtz_now_zone_name);
+
+static void dtz_now_zone_name_error_code(benchmark::State& state)
+{
+  for (auto _ : state) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(dtz::now("Europe/Berlin", ec));
+  }
+}
+BENCHMARK(dtz_now_zone_name_error_code);
+
+static void dtz_now_current_zone(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::now(dtz::current_zone()));
+  }
+}
+BENCHMARK(dtz_now_current_zone);
+
+static void date_now_current_zone(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::now(date::current_zone()));
+  }
+}
+BENCHMARK(date_now_current_zone);
+
+static void dtz_now_local_time(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::cast<dtz::local_t>(dtz::now(zone)));
+  }
+}
+BENCHMARK(dtz_now_local_time);
+
+static void dtz_format_now(benchmark::State& state)
+{
+  char buffer[dtz::traits<dtz::sys_time<dtz::system_clock::duration>>::buffer_size];
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dtz::format_to(buffer, dtz::now()));
+  }
+}
+BENCHMARK(dtz_format_now);
@@ -0,0 +1,62 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <string_view>
+#include <system_error>
+
+// Parses formatted corpus values of type T.
+template <typename T>
+static void dtz_parse(benchmark::State& state)
+{
+  const auto& strings = corpus::strings<T>();
+  for (const auto& str : strings) {
+    std::error_code ec;
+    if (dtz::parse<T>(str, ec) != corpus::values<T>()[static_cast<std::size_t>(&str - strings.data())] || ec) {
+      state.SkipWithError(("could not parse " + str).data());
+      return;
+    }
+  }
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    const auto value = dtz::parse<T>(corpus::at(strings, i), ec);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(dtz_parse, dtz::nanoseconds);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::microseconds);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::milliseconds);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::seconds);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::minutes);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::hours);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::local_time<dtz::nanoseconds>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::local_time<dtz::microseconds>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::local_time<dtz::milliseconds>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::local_time<dtz::seconds>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::local_time<dtz::minutes>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::local_days);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::sys_time<dtz::nanoseconds>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::sys_time<dtz::microseconds>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::sys_time<dtz::milliseconds>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::sys_time<dtz::seconds>);
+BENCHMARK_TEMPLATE(dtz_parse, dtz::sys_days);
+
+// Rejects strings with an invalid last character.
+static void dtz_parse_error(benchmark::State& state)
+{
+  auto strings = corpus::strings<dtz::local_time<dtz::nanoseconds>>();
+  for (auto& str : strings) {
+    str.back() = 'x';
+  }
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    const auto value = dtz::parse<dtz::local_time<dtz::nanoseconds>>(corpus::at(strings, i), ec);
+    benchmark::DoNotOptimize(value);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_parse_error);
@@ -0,0 +1,75 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <charconv>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+// Corpus time points as epoch numbers in Unit.
+template <typename Unit>
+const std::vector<std::string>& epochs()
+{
+  static const auto strings = [] {
+    std::vector<std::string> strings;
+    for (const auto tp : corpus::values<dtz::sys_time<dtz::nanoseconds>>()) {
+      strings.push_back(std::to_string(dtz::floor<Unit>(tp).time_since_epoch().count()));
+    }
+    return strings;
+  }();
+  return strings;
+}
+
+}  // namespace
+
+template <typename Unit>
+static void parse_epoch(benchmark::State& state)
+{
+  const auto& strings = epochs<Unit>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(dtz::parse_epoch<dtz::sys_time<dtz::nanoseconds>>(corpus::at(strings, i), ec));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(parse_epoch, dtz::seconds);
+BENCHMARK_TEMPLATE(parse_epoch, dtz::milliseconds);
+BENCHMARK_TEMPLATE(parse_epoch, dtz::nanoseconds);
+
+// Converts the digits with std::from_chars in a known unit.
+template <typename Unit>
+static void parse_epoch_from_chars(benchmark::State& state)
+{
+  const auto& strings = epochs<Unit>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto& str = corpus::at(strings, i);
+    std::int64_t value = 0;
+    std::from_chars(str.data(), str.data() + str.size(), value);
+    benchmark::DoNotOptimize(dtz::sys_time<dtz::nanoseconds>{ Unit{ value } });
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(parse_epoch_from_chars, dtz::seconds);
+BENCHMARK_TEMPLATE(parse_epoch_from_chars, dtz::milliseconds);
+BENCHMARK_TEMPLATE(parse_epoch_from_chars, dtz::nanoseconds);
+
+static void parse_epoch_batch(benchmark::State& state)
+{
+  const auto& strings = epochs<dtz::nanoseconds>();
+  const std::vector<std::string_view> strs{ strings.begin(), strings.end() };
+  std::vector<dtz::sys_time<dtz::nanoseconds>> out(strs.size());
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(dtz::parse_epoch<dtz::sys_time<dtz::nanoseconds>, dtz::nanoseconds>(strs, out, ec));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(strs.size()));
+}
+BENCHMARK(parse_epoch_batch);
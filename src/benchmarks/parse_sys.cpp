@@ -0,0 +1,83 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+using local_seconds = dtz::local_time<dtz::seconds>;
+
+// Corpus local times sorted like the records of a log.
+const std::vector<std::string>& ordered()
+{
+  static const auto strings = [] {
+    auto strings = corpus::strings<local_seconds>();
+    std::sort(strings.begin(), strings.end());
+    return strings;
+  }();
+  return strings;
+}
+
+}  // namespace
+
+// Parses a local time and converts it with make_zoned.
+static void parse_sys_make_zoned(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto& strings = state.range(0) ? ordered() : corpus::strings<local_seconds>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    const auto lt = dtz::parse<local_seconds>(corpus::at(strings, i), ec);
+    benchmark::DoNotOptimize(dtz::make_zoned(zone, lt, dtz::choose::earliest).get_sys_time());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(parse_sys_make_zoned)->Arg(0)->Arg(1);
+
+static void parse_sys_zone(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto& strings = state.range(0) ? ordered() : corpus::strings<local_seconds>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(dtz::parse_sys<dtz::seconds>(corpus::at(strings, i), zone, dtz::choose::earliest, ec));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(parse_sys_zone)->Arg(0)->Arg(1);
+
+// Reuses the cached offset for local times in the same interval.
+static void parse_sys_converter(benchmark::State& state)
+{
+  dtz::sys_converter converter{ dtz::locate_zone("Europe/Berlin") };
+  const auto& strings = state.range(0) ? ordered() : corpus::strings<local_seconds>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(dtz::parse_sys<dtz::seconds>(corpus::at(strings, i), converter, ec));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(parse_sys_converter)->Arg(0)->Arg(1);
+
+static void parse_sys_batch(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto& strings = ordered();
+  const std::vector<std::string_view> strs{ strings.begin(), strings.end() };
+  std::vector<dtz::sys_time<dtz::seconds>> out(strs.size());
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    benchmark::DoNotOptimize(dtz::parse_sys<dtz::seconds>(strs, zone, dtz::choose::earliest, out, ec));
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(strs.size()));
+}
+BENCHMARK(parse_sys_batch);
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <iterator>
+#include <vector>
+
+using namespace dtz::literals;
+
+static void dtz_recurrence_next(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const dtz::recurrence recurrence{ zone, dtz::local_days{ 2000_y / 1 / 1 } + 17h, "FREQ=MONTHLY;BYDAY=-1FR" };
+  auto tp = dtz::sys_time<dtz::seconds>{ dtz::sys_days{ 2020_y / 1 / 1 } };
+  for (auto _ : state) {
+    tp = recurrence.next(tp);
+    if (tp > dtz::sys_days{ 2100_y / 1 / 1 }) {
+      tp = dtz::sys_days{ 2020_y / 1 / 1 };
+    }
+    benchmark::DoNotOptimize(tp);
+  }
+}
+BENCHMARK(dtz_recurrence_next);
+
+static void dtz_recurrence_queue_pop(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto begin = dtz::sys_time<dtz::seconds>{ dtz::sys_days{ 2020_y / 1 / 1 } };
+  const char* rules[] = { "FREQ=DAILY", "FREQ=WEEKLY;BYDAY=MO,WE,FR", "FREQ=MONTHLY;BYDAY=-1FR", "FREQ=MONTHLY;BYMONTHDAY=1,15" };
+  dtz::recurrence_queue queue;
+  for (auto i = 0; i < state.range(0); i++) {
+    const auto dtstart = dtz::local_days{ 2019_y / 1 / 1 } + dtz::minutes{ i % 1440 };
+    queue.push({ zone, dtstart, rules[i % 4] }, begin);
+  }
+  std::vector<dtz::recurrence_queue::occurrence> due;
+  auto tick = begin;
+  std::int64_t items = 0;
+  for (auto _ : state) {
+    tick += dtz::minutes{ 1 };
+    due.clear();
+    queue.pop(tick, std::back_inserter(due));
+    items += static_cast<std::int64_t>(due.size());
+  }
+  state.SetItemsProcessed(items);
+}
+BENCHMARK(dtz_recurrence_queue_pop)->Arg(100'000);
@@ -0,0 +1,122 @@
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace dtz::literals;
+
+// Connection timeouts between 1 second and 2 minutes with millisecond precision.
+static std::vector<dtz::steady_clock::time_point> timer_deadlines(std::size_t size)
+{
+  std::mt19937_64 random{ 42 };
+  std::uniform_int_distribution<std::int64_t> distribution{ 1000, 120'000 };
+  std::vector<dtz::steady_clock::time_point> deadlines(size);
+  for (auto& deadline : deadlines) {
+    deadline = dtz::steady_clock::time_point{ 1h } + dtz::milliseconds{ distribution(random) };
+  }
+  return deadlines;
+}
+
+// Inserts all timers and expires them in 1 millisecond steps.
+static void dtz_timer_wheel_expire(benchmark::State& state)
+{
+  const auto deadlines = timer_deadlines(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    dtz::timer_wheel<dtz::steady_clock> timers{ dtz::steady_clock::time_point{ 1h } };
+    for (std::size_t i = 0; i < deadlines.size(); i++) {
+      timers.insert(deadlines[i], i);
+    }
+    std::uint64_t sum = 0;
+    for (auto now = timers.now(); !timers.empty(); now += 1ms) {
+      timers.advance(now, [&](auto, std::uint64_t value) {
+        sum += value;
+      });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(dtz_timer_wheel_expire)->Arg(1'000'000)->Arg(10'000'000)->Unit(benchmark::kMillisecond);
+
+static void std_multimap_expire(benchmark::State& state)
+{
+  const auto deadlines = timer_deadlines(static_cast<std::size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::multimap<dtz::steady_clock::time_point, std::uint64_t> timers;
+    for (std::size_t i = 0; i < deadlines.size(); i++) {
+      timers.emplace(deadlines[i], i);
+    }
+    std::uint64_t sum = 0;
+    for (auto now = dtz::steady_clock::time_point{ 1h }; !timers.empty(); now += 1ms) {
+      for (auto it = timers.begin(); it != timers.end() && it->first <= now; it = timers.erase(it)) {
+        sum += it->second;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(std_multimap_expire)->Arg(1'000'000)->Arg(10'000'000)->Unit(benchmark::kMillisecond);
+
+// Re-arms a timeout (cancel and insert) with 10M pending timers.
+static void dtz_timer_wheel_rearm(benchmark::State& state)
+{
+  const auto deadlines = timer_deadlines(static_cast<std::size_t>(state.range(0)));
+  dtz::timer_wheel<dtz::steady_clock> timers{ dtz::steady_clock::time_point{ 1h } };
+  std::vector<dtz::timer_wheel<dtz::steady_clock>::timer_id> ids;
+  ids.reserve(deadlines.size());
+  for (std::size_t i = 0; i < deadlines.size(); i++) {
+    ids.push_back(timers.insert(deadlines[i], i));
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    timers.cancel(ids[i]);
+    ids[i] = timers.insert(deadlines[deadlines.size() - i - 1], i);
+    i = i + 1 < ids.size() ? i + 1 : 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_timer_wheel_rearm)->Arg(10'000'000);
+
+static void std_multimap_rearm(benchmark::State& state)
+{
+  const auto deadlines = timer_deadlines(static_cast<std::size_t>(state.range(0)));
+  std::multimap<dtz::steady_clock::time_point, std::uint64_t> timers;
+  std::vector<std::multimap<dtz::steady_clock::time_point, std::uint64_t>::iterator> ids;
+  ids.reserve(deadlines.size());
+  for (std::size_t i = 0; i < deadlines.size(); i++) {
+    ids.push_back(timers.emplace(deadlines[i], i));
+  }
+  std::size_t i = 0;
+  for (auto _ : state) {
+    timers.erase(ids[i]);
+    ids[i] = timers.emplace(deadlines[deadlines.size() - i - 1], i);
+    i = i + 1 < ids.size() ? i + 1 : 0;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(std_multimap_rearm)->Arg(10'000'000);
+
+// Daily local wall-clock timers in many zones re-armed across a year of DST transitions.
+static void dtz_zoned_timer_wheel_daily(benchmark::State& state)
+{
+  const std::vector<const dtz::time_zone*> zones{ dtz::locate_zone("Europe/Berlin"),
+    dtz::locate_zone("America/New_York"), dtz::locate_zone("Europe/London"), dtz::locate_zone("Asia/Tokyo") };
+  for (auto _ : state) {
+    dtz::zoned_timer_wheel<> timers{ dtz::sys_days{ 2020_y / 12 / 31 } };
+    for (std::uint64_t i = 0; i < 1000; i++) {
+      const auto tod = dtz::minutes{ static_cast<std::int64_t>(i % 1440) };
+      timers.insert(zones[i % zones.size()], dtz::local_days{ 2021_y / 1 / 1 } + tod, dtz::choose::earliest, i, 24h);
+    }
+    std::uint64_t sum = 0;
+    for (dtz::sys_time<dtz::hours> now = dtz::sys_days{ 2021_y / 1 / 1 }; now < dtz::sys_days{ 2022_y / 1 / 1 }; now += 1h) {
+      timers.advance(now, [&](auto, std::uint64_t value) {
+        sum += value;
+      });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * 1000 * 365);
+}
+BENCHMARK(dtz_zoned_timer_wheel_daily)->Unit(benchmark::kMillisecond);
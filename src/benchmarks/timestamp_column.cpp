@@ -0,0 +1,85 @@
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <random>
+#include <vector>
+
+using namespace dtz::literals;
+
+// One day of readings one second apart, with occasional jitter of up to one second.
+static std::vector<dtz::sys_time<dtz::nanoseconds>> column_series()
+{
+  std::mt19937_64 random{ 42 };
+  std::vector<dtz::sys_time<dtz::nanoseconds>> values;
+  auto tp = dtz::sys_time<dtz::nanoseconds>{ dtz::sys_days{ 2021_y / 1 / 1 } };
+  for (int i = 0; i < 86'400; i++) {
+    tp += 1s;
+    values.push_back(random() % 100 == 0 ? tp + dtz::milliseconds{ static_cast<std::int64_t>(random() % 1000) } : tp);
+  }
+  return values;
+}
+
+static void dtz_timestamp_column_push_back(benchmark::State& state)
+{
+  const auto values = column_series();
+  dtz::timestamp_column<> column;
+  for (auto _ : state) {
+    column.clear();
+    for (const auto& value : values) {
+      column.push_back(value);
+    }
+    benchmark::DoNotOptimize(column.size());
+  }
+  state.counters["bits_per_value"] = static_cast<double>(column.memory() * 8) / static_cast<double>(column.size());
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+BENCHMARK(dtz_timestamp_column_push_back);
+
+static void dtz_timestamp_column_decode(benchmark::State& state)
+{
+  const auto values = column_series();
+  dtz::timestamp_column<> column;
+  for (const auto& value : values) {
+    column.push_back(value);
+  }
+  for (auto _ : counters::loop{ state }) {
+    std::int64_t sum = 0;
+    for (const auto tp : column) {
+      sum += tp.time_since_epoch().count();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+BENCHMARK(dtz_timestamp_column_decode);
+
+static void dtz_timestamp_column_lower_bound(benchmark::State& state)
+{
+  const auto values = column_series();
+  dtz::timestamp_column<> column;
+  for (const auto& value : values) {
+    column.push_back(value);
+  }
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(column.lower_bound(values[i]).index());
+    i = (i + 7919) % values.size();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_timestamp_column_lower_bound);
+
+static void std_vector_decode(benchmark::State& state)
+{
+  const auto values = column_series();
+  for (auto _ : state) {
+    std::int64_t sum = 0;
+    for (const auto tp : values) {
+      sum += tp.time_since_epoch().count();
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.counters["bits_per_value"] = 64;
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(values.size()));
+}
+BENCHMARK(std_vector_decode);
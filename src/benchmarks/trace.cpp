@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static void dtz_trace_scope_steady(benchmark::State& state)
+{
+  static dtz::trace_recorder recorder;
+  const auto id = recorder.name("scope");
+  recorder.reserve();
+  for (auto _ : state) {
+    const auto scope = recorder.trace(id);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_trace_scope_steady);
+
+static void dtz_trace_scope_tsc(benchmark::State& state)
+{
+  static dtz::trace_recorder<dtz::tsc_clock> recorder;
+  const auto id = recorder.name("scope");
+  recorder.reserve();
+  for (auto _ : state) {
+    const auto scope = recorder.trace(id);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_trace_scope_tsc);
+
+// Typical hand-rolled recorder: a mutex-protected vector of named events.
+static void std_mutex_vector_trace(benchmark::State& state)
+{
+  struct event
+  {
+    std::string name;
+    dtz::steady_clock::time_point start;
+    dtz::steady_clock::duration duration;
+  };
+  std::mutex mutex;
+  std::vector<event> events;
+  for (auto _ : state) {
+    const auto start = dtz::steady_clock::now();
+    const auto duration = dtz::steady_clock::now() - start;
+    std::lock_guard lock{ mutex };
+    events.push_back({ "scope", start, duration });
+    if (events.size() == 1 << 16) {
+      events.clear();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(std_mutex_vector_trace);
+
+static void dtz_trace_chrome_json(benchmark::State& state)
+{
+  dtz::trace_recorder recorder{ 1 << 12 };
+  const auto id = recorder.name("scope");
+  for (int i = 0; i < 1 << 12; i++) {
+    const auto scope = recorder.trace(id);
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(recorder.chrome_trace());
+  }
+  state.SetItemsProcessed(state.iterations() * (1 << 12));
+}
+BENCHMARK(dtz_trace_chrome_json);
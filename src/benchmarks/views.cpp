@@ -0,0 +1,32 @@
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+
+using namespace dtz::literals;
+
+static void dtz_views_days(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto begin = dtz::sys_days{ 2000_y / 1 / 1 };
+  const auto end = dtz::sys_days{ 2030_y / 1 / 1 };
+  for (auto _ : state) {
+    for (const auto tp : dtz::views::days(zone, begin, end)) {
+      benchmark::DoNotOptimize(tp);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (end - begin).count());
+}
+BENCHMARK(dtz_views_days);
+
+static void dtz_make_zoned_days(benchmark::State& state)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto begin = dtz::local_days{ 2000_y / 1 / 1 };
+  const auto end = dtz::local_days{ 2030_y / 1 / 1 };
+  for (auto _ : state) {
+    for (auto day = begin; day < end; day += dtz::days{ 1 }) {
+      benchmark::DoNotOptimize(dtz::make_zoned(zone, day + 0h).get_sys_time());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (end - begin).count());
+}
+BENCHMARK(dtz_make_zoned_days);
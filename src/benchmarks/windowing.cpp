@@ -0,0 +1,69 @@
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <random>
+#include <vector>
+
+using namespace dtz::literals;
+
+// One week of events 100 ms apart with up to 5 seconds of disorder.
+static std::vector<dtz::sys_time<dtz::milliseconds>> window_events()
+{
+  std::mt19937_64 random{ 42 };
+  std::vector<dtz::sys_time<dtz::milliseconds>> events;
+  const auto start = dtz::sys_time<dtz::milliseconds>{ dtz::sys_days{ 2021_y / 3 / 25 } };
+  for (std::int64_t i = 0; i < 7 * 864'000; i++) {
+    events.push_back(start + dtz::milliseconds{ i * 100 - static_cast<std::int64_t>(random() % 5000) });
+  }
+  return events;
+}
+
+static void dtz_windowing_local_days(benchmark::State& state)
+{
+  const auto events = window_events();
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  for (auto _ : counters::loop{ state }) {
+    auto windows = dtz::windowing<std::uint64_t, dtz::milliseconds>::tumbling(zone, dtz::bucket_unit::day, 10s);
+    std::uint64_t sum = 0;
+    for (const auto& tp : events) {
+      windows.add(tp, [](std::uint64_t& n) { n++; });
+      windows.poll([&](const auto&, std::uint64_t n) { sum += n; });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(dtz_windowing_local_days)->Unit(benchmark::kMillisecond);
+
+// Computes the window of every event with make_zoned and floor.
+static void dtz_make_zoned_floor_local_days(benchmark::State& state)
+{
+  const auto events = window_events();
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  for (auto _ : state) {
+    std::uint64_t sum = 0;
+    for (const auto& tp : events) {
+      const auto day = dtz::floor<dtz::days>(dtz::make_zoned(zone, tp).get_local_time());
+      sum += static_cast<std::uint64_t>(zone->to_sys(day, dtz::choose::earliest).time_since_epoch().count());
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(dtz_make_zoned_floor_local_days)->Unit(benchmark::kMillisecond);
+
+static void dtz_windowing_sliding(benchmark::State& state)
+{
+  const auto events = window_events();
+  for (auto _ : counters::loop{ state }) {
+    auto windows = dtz::windowing<std::uint64_t, dtz::milliseconds>::sliding(1min, 10s, 10s);
+    std::uint64_t sum = 0;
+    for (const auto& tp : events) {
+      windows.add(tp, [](std::uint64_t& n) { n++; });
+      windows.poll([&](const auto&, std::uint64_t n) { sum += n; });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(events.size()));
+}
+BENCHMARK(dtz_windowing_sliding)->Unit(benchmark::kMillisecond);
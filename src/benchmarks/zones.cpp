@@ -0,0 +1,188 @@
+#include "corpus.hpp"
+#include "counters.hpp"
+#include <benchmark/benchmark.h>
+#include <dtz.hpp>
+#include <string>
+
+// Every benchmark runs once per corpus zone, selected by the benchmark argument.
+static const dtz::time_zone* zone(benchmark::State& state)
+{
+  const auto name = corpus::zones[static_cast<std::size_t>(state.range(0))];
+  state.SetLabel(std::string{ name });
+  return dtz::locate_zone(name);
+}
+
+static void zones(benchmark::internal::Benchmark* benchmark)
+{
+  for (std::size_t i = 0; i < std::size(corpus::zones); i++) {
+    benchmark->Arg(static_cast<std::int64_t>(i));
+  }
+}
+
+static void dtz_locate_zone(benchmark::State& state)
+{
+  const auto name = corpus::zones[static_cast<std::size_t>(state.range(0))];
+  state.SetLabel(std::string{ name });
+  for (auto _ : counters::loop{ state }) {
+    benchmark::DoNotOptimize(dtz::locate_zone(name));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_locate_zone)->Apply(zones);
+
+static void dtz_make_zoned_sys_time(benchmark::State& state)
+{
+  const auto tz = zone(state);
+  const auto& values = corpus::values<dtz::sys_time<dtz::nanoseconds>>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto zt = dtz::make_zoned(tz, corpus::at(values, i));
+    benchmark::DoNotOptimize(zt);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_make_zoned_sys_time)->Apply(zones);
+
+static void dtz_make_zoned_local_time_choose(benchmark::State& state)
+{
+  const auto tz = zone(state);
+  const auto& values = corpus::values<dtz::local_time<dtz::nanoseconds>>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto zt = dtz::make_zoned(tz, corpus::at(values, i), dtz::choose::earliest);
+    benchmark::DoNotOptimize(zt);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_make_zoned_local_time_choose)->Apply(zones);
+
+static void dtz_make_zoned_local_time_error_code(benchmark::State& state)
+{
+  const auto tz = zone(state);
+  const auto& values = corpus::values<dtz::local_time<dtz::nanoseconds>>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    std::error_code ec;
+    const auto zt = dtz::make_zoned(tz, corpus::at(values, i), ec);
+    benchmark::DoNotOptimize(zt);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_make_zoned_local_time_error_code)->Apply(zones);
+
+static void dtz_cast_zoned_to_local(benchmark::State& state)
+{
+  const auto tz = zone(state);
+  std::vector<dtz::zoned_time<dtz::nanoseconds>> values;
+  for (const auto& tp : corpus::values<dtz::sys_time<dtz::nanoseconds>>()) {
+    values.push_back(dtz::make_zoned(tz, tp));
+  }
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto lt = dtz::cast<dtz::local_t>(corpus::at(values, i));
+    benchmark::DoNotOptimize(lt);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_cast_zoned_to_local)->Apply(zones);
+
+static void dtz_cast_zoned_to_utc_clock(benchmark::State& state)
+{
+  const auto tz = zone(state);
+  std::vector<dtz::zoned_time<dtz::nanoseconds>> values;
+  for (const auto& tp : corpus::values<dtz::sys_time<dtz::nanoseconds>>()) {
+    values.push_back(dtz::make_zoned(tz, tp));
+  }
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto tp = dtz::cast<dtz::utc_clock>(corpus::at(values, i));
+    benchmark::DoNotOptimize(tp);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_cast_zoned_to_utc_clock)->Apply(zones);
+
+static void dtz_time_zone_get_info(benchmark::State& state)
+{
+  const auto tz = zone(state);
+  const auto& values = corpus::values<dtz::sys_time<dtz::seconds>>();
+  std::size_t i = 0;
+  for (auto _ : counters::loop{ state }) {
+    const auto info = tz->get_info(corpus::at(values, i));
+    benchmark::DoNotOptimize(info.offset);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_time_zone_get_info)->Apply(zones);
+
+// Zones computed from rules, compared with the tz database zones above.
+static void rule_zones(benchmark::internal::Benchmark* benchmark)
+{
+  benchmark->Arg(0)->Arg(1)->Arg(2);
+}
+
+static void dtz_cast_rule_zoned_to_local(benchmark::State& state)
+{
+  const auto& values = corpus::values<dtz::sys_time<dtz::nanoseconds>>();
+  const auto run = [&](const auto& zone) {
+    std::size_t i = 0;
+    for (auto _ : counters::loop{ state }) {
+      const auto lt = dtz::cast<dtz::local_t>(dtz::make_zoned(zone, corpus::at(values, i)));
+      benchmark::DoNotOptimize(lt);
+    }
+  };
+  switch (state.range(0)) {
+  case 0:
+    state.SetLabel("+05:30");
+    run(dtz::make_fixed_zone("+05:30"));
+    break;
+  case 1:
+    state.SetLabel("EST5EDT,M3.2.0,M11.1.0");
+    run(dtz::make_posix_zone("EST5EDT,M3.2.0,M11.1.0"));
+    break;
+  default:
+    state.SetLabel("America/New_York");
+    run(dtz::locate_zone("America/New_York"));
+    break;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_cast_rule_zoned_to_local)->Apply(rule_zones);
+
+static void dtz_make_rule_zoned_local_time_choose(benchmark::State& state)
+{
+  const auto& values = corpus::values<dtz::local_time<dtz::nanoseconds>>();
+  const auto run = [&](const auto& zone) {
+    std::size_t i = 0;
+    for (auto _ : counters::loop{ state }) {
+      const auto zt = dtz::make_zoned(zone, corpus::at(values, i), dtz::choose::earliest);
+      benchmark::DoNotOptimize(zt);
+    }
+  };
+  switch (state.range(0)) {
+  case 0:
+    state.SetLabel("+05:30");
+    run(dtz::make_fixed_zone("+05:30"));
+    break;
+  case 1:
+    state.SetLabel("EST5EDT,M3.2.0,M11.1.0");
+    run(dtz::make_posix_zone("EST5EDT,M3.2.0,M11.1.0"));
+    break;
+  default:
+    state.SetLabel("America/New_York");
+    run(dtz::locate_zone("America/New_York"));
+    break;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(dtz_make_rule_zoned_local_time_choose)->Apply(rule_zones);
+
+// The first conversion in a zone loads its transitions, which warm_up does ahead of time.
+static void dtz_warm_up(benchmark::State& state)
+{
+  for (auto _ : counters::loop{ state }) {
+    const auto timings = dtz::warm_up(corpus::zones, static_cast<unsigned>(state.range(0)));
+    benchmark::DoNotOptimize(timings);
+  }
+}
+BENCHMARK(dtz_warm_up)->Arg(1)->Arg(0);
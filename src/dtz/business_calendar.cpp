@@ -0,0 +1,177 @@
+#include <dtz/business_calendar.hpp>
+#include <dtz/parse.hpp>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace dtz {
+namespace {
+
+bool parse_weekday(std::string_view str, weekday& wd) noexcept
+{
+  constexpr std::string_view names[] = { "sun", "mon", "tue", "wed", "thu", "fri", "sat" };
+  for (unsigned i = 0; i < 7; i++) {
+    const auto match = str.size() == 3 && std::equal(str.begin(), str.end(), names[i].begin(), [](char a, char b) {
+      return std::tolower(static_cast<unsigned char>(a)) == b;
+    });
+    if (match) {
+      wd = weekday{ i };
+      return true;
+    }
+  }
+  return false;
+}
+
+bool parse_year(std::string_view str, year& y) noexcept
+{
+  int value = 0;
+  const auto end = str.data() + str.size();
+  const auto [cur, err] = internal::from_chars(str.data(), end, value);
+  y = year{ value };
+  return err == std::errc{} && cur == end && y.ok();
+}
+
+// Splits str at whitespace and removes the first word from str.
+std::string_view next_word(std::string_view& str) noexcept
+{
+  const auto space = [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; };
+  const auto beg = std::find_if_not(str.begin(), str.end(), space);
+  const auto end = std::find_if(beg, str.end(), space);
+  const auto word = str.substr(static_cast<std::size_t>(beg - str.begin()), static_cast<std::size_t>(end - beg));
+  str.remove_prefix(static_cast<std::size_t>(end - str.begin()));
+  return word;
+}
+
+}  // namespace
+
+business_calendar::business_calendar(year first, year last, std::span<const weekday> weekend,
+  std::span<const year_month_day> holidays, std::span<const year_month_day> business_days) :
+  begin_(first / 1 / 1)
+{
+  const auto end = sys_days{ (last + years{ 1 }) / 1 / 1 };
+  if (end <= begin_) {
+    throw std::invalid_argument("invalid business calendar range");
+  }
+  size_ = static_cast<std::size_t>((end - begin_).count());
+  bits_.resize((size_ + 63) / 64);
+
+  std::uint64_t week = 0;
+  for (unsigned i = 0; i < 7; i++) {
+    if (std::find(weekend.begin(), weekend.end(), weekday{ i }) == weekend.end()) {
+      week |= std::uint64_t{ 1 } << i;
+    }
+  }
+  const auto first_weekday = weekday{ begin_ }.c_encoding();
+  for (std::size_t i = 0; i < size_; i++) {
+    bits_[i >> 6] |= (week >> ((first_weekday + i) % 7) & 1) << (i & 63);
+  }
+
+  const auto set = [&](const year_month_day& ymd, bool value) {
+    const auto i = (sys_days{ ymd } - begin_).count();
+    if (i >= 0 && static_cast<std::size_t>(i) < size_) {
+      const auto bit = std::uint64_t{ 1 } << (i & 63);
+      bits_[static_cast<std::size_t>(i) >> 6] = value ? bits_[static_cast<std::size_t>(i) >> 6] | bit : bits_[static_cast<std::size_t>(i) >> 6] & ~bit;
+    }
+  };
+  for (const auto& ymd : holidays) {
+    set(ymd, false);
+  }
+  for (const auto& ymd : business_days) {
+    set(ymd, true);
+  }
+
+  ranks_.resize(bits_.size());
+  for (std::size_t w = 0; w < bits_.size(); w++) {
+    ranks_[w] = count_;
+    count_ += static_cast<std::size_t>(std::popcount(bits_[w]));
+  }
+}
+
+business_calendar business_calendar::parse(std::string_view text, std::error_code& ec)
+{
+  ec.clear();
+  auto range = false;
+  year first;
+  year last;
+  std::vector<weekday> weekend{ sat, sun };
+  std::vector<year_month_day> holidays;
+  std::vector<year_month_day> business_days;
+  while (!text.empty()) {
+    const auto pos = text.find('\n');
+    auto line = text.substr(0, pos);
+    text.remove_prefix(pos == std::string_view::npos ? text.size() : pos + 1);
+    line = line.substr(0, line.find('#'));
+    const auto word = next_word(line);
+    if (word.empty()) {
+      continue;
+    }
+    if (word == "years") {
+      range = parse_year(next_word(line), first) && parse_year(next_word(line), last) && first <= last;
+      if (!range) {
+        ec = std::make_error_code(errc::invalid_year_format);
+        return {};
+      }
+    } else if (word == "weekend") {
+      weekend.clear();
+      for (auto name = next_word(line); !name.empty(); name = next_word(line)) {
+        weekday wd;
+        if (!parse_weekday(name, wd)) {
+          ec = std::make_error_code(errc::invalid_format);
+          return {};
+        }
+        weekend.push_back(wd);
+      }
+    } else {
+      const auto business_day = word.front() == '+';
+      const auto date = business_day ? word.substr(1) : word;
+      std::error_code date_ec;
+      const auto ymd = year_month_day{ dtz::parse<local_days>(date, date_ec) };
+      if (date_ec || date.size() != 10) {
+        ec = date_ec ? date_ec : std::make_error_code(errc::invalid_format);
+        return {};
+      }
+      (business_day ? business_days : holidays).push_back(ymd);
+    }
+  }
+  if (!range) {
+    ec = std::make_error_code(errc::invalid_year_format);
+    return {};
+  }
+  return { first, last, weekend, holidays, business_days };
+}
+
+business_calendar business_calendar::parse(std::string_view text)
+{
+  std::error_code ec;
+  auto calendar = parse(text, ec);
+  if (ec) {
+    throw std::system_error(ec, "Could not parse business calendar.");
+  }
+  return calendar;
+}
+
+business_calendar business_calendar::load(const std::filesystem::path& path, std::error_code& ec)
+{
+  ec.clear();
+  std::ifstream file{ path, std::ios::binary };
+  if (!file) {
+    ec = std::make_error_code(std::errc::no_such_file_or_directory);
+    return {};
+  }
+  const std::string text{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+  return parse(text, ec);
+}
+
+business_calendar business_calendar::load(const std::filesystem::path& path)
+{
+  std::error_code ec;
+  auto calendar = load(path, ec);
+  if (ec) {
+    throw std::system_error(ec, "Could not load business calendar.");
+  }
+  return calendar;
+}
+
+}  // namespace dtz
@@ -0,0 +1,101 @@
+#include <dtz/compact_zoned.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace dtz::internal {
+namespace {
+
+constexpr std::size_t zone_cache_size = 64;
+
+class zone_registry
+{
+public:
+  zone_registry()
+  {
+    add(date::locate_zone("UTC"));
+  }
+
+  std::uint16_t add(const time_zone* zone)
+  {
+    if (!zone) {
+      throw std::invalid_argument("zone_id requires a time zone");
+    }
+    {
+      std::shared_lock lock{ mutex_ };
+      if (const auto it = ids_.find(zone); it != ids_.end()) {
+        return it->second;
+      }
+    }
+    std::unique_lock lock{ mutex_ };
+    if (const auto it = ids_.find(zone); it != ids_.end()) {
+      return it->second;
+    }
+    const auto size = size_.load(std::memory_order_relaxed);
+    if (size == zones_.size()) {
+      throw std::length_error("too many zones in zone_id registry");
+    }
+    const auto id = static_cast<std::uint16_t>(size);
+    zones_[id].store(zone, std::memory_order_release);
+    size_.store(size + 1, std::memory_order_release);
+    ids_.emplace(zone, id);
+    return id;
+  }
+
+  const time_zone* get(std::uint16_t id) const noexcept
+  {
+    return zones_[id].load(std::memory_order_acquire);
+  }
+
+  std::size_t size() const noexcept
+  {
+    return size_.load(std::memory_order_acquire);
+  }
+
+private:
+  // Ids are never reused, so lookups by id need no lock.
+  std::array<std::atomic<const time_zone*>, std::numeric_limits<std::uint16_t>::max() + 1> zones_{};
+  std::atomic<std::size_t> size_ = 0;
+  std::shared_mutex mutex_;
+  std::unordered_map<const time_zone*, std::uint16_t> ids_;
+};
+
+zone_registry& registry()
+{
+  static zone_registry instance;
+  return instance;
+}
+
+}  // namespace
+
+std::uint16_t register_zone(const time_zone* zone)
+{
+  // Direct-mapped per-thread cache of recently used zones, which avoids the lock for repeated zones.
+  struct entry
+  {
+    const time_zone* zone = nullptr;
+    std::uint16_t id = 0;
+  };
+  thread_local std::array<entry, zone_cache_size> cache;
+  auto& e = cache[(reinterpret_cast<std::uintptr_t>(zone) / alignof(time_zone)) % zone_cache_size];
+  if (e.zone != zone || !zone) {
+    e = { zone, registry().add(zone) };
+  }
+  return e.id;
+}
+
+const time_zone* registered_zone(std::uint16_t id) noexcept
+{
+  return registry().get(id);
+}
+
+std::size_t registered_zones() noexcept
+{
+  return registry().size();
+}
+
+}  // namespace dtz::internal
@@ -1,13 +1,23 @@
 #include <dtz.hpp>
+#include <algorithm>
 #include <atomic>
 #include <filesystem>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #  include <windows.h>
 #endif
 
+#ifdef __linux__
+#  include <sys/inotify.h>
+#  include <unistd.h>
+#  include <cerrno>
+#endif
+
 namespace dtz {
 
 const char* error::name() const noexcept
@@ -36,6 +46,16 @@ std::string error::message(int ev) const
     return "invalid subseconds format";
   case errc::tzdata_load_error:
     return "tzdata load error";
+  case errc::zone_not_found:
+    return "zone not found";
+  case errc::ambiguous_local_time:
+    return "ambiguous local time";
+  case errc::nonexistent_local_time:
+    return "nonexistent local time";
+  case errc::invalid_binary_format:
+    return "invalid binary format";
+  case errc::invalid_time_zone_format:
+    return "invalid time zone format";
   }
   return "unknown error value: " + std::to_string(ev);
 }
@@ -47,6 +67,141 @@ const error& error_category() noexcept
   return error_instance;
 }
 
+const time_zone* locate_zone(std::string_view name, std::error_code& ec) noexcept
+{
+  ec.clear();
+  try {
+    const auto& db = get_tzdb();
+    const auto less = [](const auto& lhs, std::string_view rhs) { return lhs.name() < rhs; };
+    const auto zone = std::lower_bound(db.zones.begin(), db.zones.end(), name, less);
+    if (zone != db.zones.end() && zone->name() == name) {
+      return &*zone;
+    }
+#if !USE_OS_TZDB
+    const auto link = std::lower_bound(db.links.begin(), db.links.end(), name, less);
+    if (link != db.links.end() && link->name() == name) {
+      return locate_zone(link->target(), ec);
+    }
+#endif
+    ec = std::make_error_code(errc::zone_not_found);
+  }
+  catch (...) {
+    ec = std::make_error_code(errc::tzdata_load_error);
+  }
+  return nullptr;
+}
+
+namespace {
+
+std::atomic<const time_zone*> current_zone_cache = nullptr;
+std::atomic<std::uint64_t> current_zone_generation = 0;
+
+// Uses TZ in the forms "Europe/Berlin", ":Europe/Berlin" and ":/usr/share/zoneinfo/Europe/Berlin" and falls back to
+// the system zone for anything else.
+const time_zone* resolve_current_zone()
+{
+  if (const auto tz = std::getenv("TZ"); tz && *tz) {
+    std::string_view name{ tz };
+    if (name.front() == ':') {
+      name.remove_prefix(1);
+    }
+    if (const auto pos = name.find("zoneinfo/"); pos != std::string_view::npos) {
+      name.remove_prefix(pos + 9);
+    }
+    std::error_code ec;
+    if (const auto zone = locate_zone(name, ec)) {
+      return zone;
+    }
+  }
+  return date::current_zone();
+}
+
+// Starts a thread that drops the cached zone when the system zone changes. Returns false if the changes cannot be
+// watched, in which case only reset_current_zone drops the cache.
+bool watch_current_zone() noexcept
+{
+#ifdef __linux__
+  // Watch the directory because /etc/localtime is usually replaced rather than written.
+  const auto fd = inotify_init1(IN_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  const auto mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB;
+  if (inotify_add_watch(fd, "/etc", mask) < 0) {
+    close(fd);
+    return false;
+  }
+  try {
+    std::thread([fd]() noexcept {
+      alignas(inotify_event) char buffer[4096];
+      while (true) {
+        const auto size = read(fd, buffer, sizeof(buffer));
+        if (size < 0 && errno == EINTR) {
+          continue;
+        }
+        if (size <= 0) {
+          break;
+        }
+        for (auto it = buffer; it < buffer + size;) {
+          const auto event = reinterpret_cast<const inotify_event*>(it);
+          const auto name = event->len ? std::string_view{ event->name } : std::string_view{};
+          if (name == "localtime" || name == "timezone" || event->mask & IN_Q_OVERFLOW) {
+            reset_current_zone();
+          }
+          it += sizeof(inotify_event) + event->len;
+        }
+      }
+      close(fd);
+    }).detach();
+  }
+  catch (...) {
+    close(fd);
+    return false;
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace
+
+const time_zone* current_zone()
+{
+  if (const auto zone = current_zone_cache.load(std::memory_order_acquire)) {
+    return zone;
+  }
+  [[maybe_unused]] static const auto watching = watch_current_zone();
+  const auto generation = current_zone_generation.load();
+  const auto zone = resolve_current_zone();
+  auto expected = static_cast<const time_zone*>(nullptr);
+  current_zone_cache.compare_exchange_strong(expected, zone);
+  if (current_zone_generation.load() != generation) {
+    // The zone changed while it was resolved and the result may be stale.
+    expected = zone;
+    current_zone_cache.compare_exchange_strong(expected, nullptr);
+  }
+  return zone;
+}
+
+void reset_current_zone() noexcept
+{
+  current_zone_generation++;
+  current_zone_cache.store(nullptr);
+}
+
+const time_zone* current_zone(std::error_code& ec) noexcept
+{
+  ec.clear();
+  try {
+    return current_zone();
+  }
+  catch (...) {
+    ec = std::make_error_code(errc::zone_not_found);
+  }
+  return nullptr;
+}
+
 #ifdef _WIN32
 
 void initialize(const std::filesystem::path& tzdata, std::error_code& ec) noexcept
@@ -114,20 +269,155 @@ void initialize()
 
 #else
 
+// The database is at a fixed location, so the path is ignored. Loading it here moves the parse off the first
+// lookup.
 void initialize(const std::filesystem::path& tzdata, std::error_code& ec) noexcept
 {
-  ec.clear();
+  initialize(ec);
 }
 
-void initialize(const std::filesystem::path& tzdata) {}
+void initialize(const std::filesystem::path& tzdata)
+{
+  initialize();
+}
 
 void initialize(std::error_code& ec) noexcept
 {
   ec.clear();
+  try {
+    (void)get_tzdb();
+  }
+  catch (...) {
+    ec = std::make_error_code(errc::tzdata_load_error);
+  }
 }
 
-void initialize() {}
+void initialize()
+{
+  std::error_code ec;
+  initialize(ec);
+  if (ec) {
+    throw std::system_error(ec, "Could not load time zone database.");
+  }
+}
 
 #endif
 
+namespace {
+
+// Loads the transitions of the zones, which every zone does once on its first conversion. Zones are
+// independent, so the work is split across threads that take zones from a shared index.
+std::error_code load_zones(const std::vector<const time_zone*>& zones, unsigned threads) noexcept
+{
+  std::atomic<std::size_t> next = 0;
+  std::atomic<bool> failed = false;
+  const auto work = [&]() noexcept {
+    for (auto i = next++; i < zones.size(); i = next++) {
+      try {
+        (void)zones[i]->get_info(sys_time<seconds>{});
+      }
+      catch (...) {
+        failed = true;
+      }
+    }
+  };
+  if (threads == 0) {
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  }
+  threads = static_cast<unsigned>(std::min<std::size_t>(threads, zones.size()));
+  std::vector<std::thread> pool;
+  try {
+    for (unsigned i = 1; i < threads; i++) {
+      pool.emplace_back(work);
+    }
+  }
+  catch (...) {
+    // Continue with the threads that could be started.
+  }
+  work();
+  for (auto& thread : pool) {
+    thread.join();
+  }
+  return failed ? std::make_error_code(errc::tzdata_load_error) : std::error_code{};
+}
+
+// Warms the named zones or every zone if names is null.
+warm_up_timings warm_up_zones(const std::vector<std::string_view>* names, std::error_code& ec, unsigned threads) noexcept
+{
+  ec.clear();
+  warm_up_timings timings;
+  const auto start = steady_clock::now();
+  std::vector<const time_zone*> zones;
+  try {
+    const auto& db = get_tzdb();
+    if (names) {
+      zones.reserve(names->size());
+      for (const auto name : *names) {
+        std::error_code e;
+        if (const auto zone = locate_zone(name, e)) {
+          zones.push_back(zone);
+        } else if (!ec) {
+          ec = e;
+        }
+      }
+    } else {
+      zones.reserve(db.zones.size());
+      for (const auto& zone : db.zones) {
+        zones.push_back(&zone);
+      }
+    }
+  }
+  catch (...) {
+    ec = std::make_error_code(errc::tzdata_load_error);
+    return timings;
+  }
+  const auto loaded = steady_clock::now();
+  timings.database = loaded - start;
+  if (const auto e = load_zones(zones, threads); e && !ec) {
+    ec = e;
+  }
+  timings.zones = steady_clock::now() - loaded;
+  timings.zone_count = zones.size();
+  return timings;
+}
+
+}  // namespace
+
+warm_up_timings warm_up(std::span<const std::string_view> zones, std::error_code& ec, unsigned threads) noexcept
+{
+  try {
+    const std::vector<std::string_view> names{ zones.begin(), zones.end() };
+    return warm_up_zones(&names, ec, threads);
+  }
+  catch (...) {
+    ec = std::make_error_code(std::errc::not_enough_memory);
+  }
+  return {};
+}
+
+warm_up_timings warm_up(std::span<const std::string_view> zones, unsigned threads)
+{
+  std::error_code ec;
+  const auto timings = warm_up(zones, ec, threads);
+  if (ec) {
+    throw std::system_error(ec, "Could not load time zones.");
+  }
+  return timings;
+}
+
+warm_up_timings warm_up(std::error_code& ec, unsigned threads) noexcept
+{
+  return warm_up_zones(nullptr, ec, threads);
+}
+
+warm_up_timings warm_up(unsigned threads)
+{
+  std::error_code ec;
+  const auto timings = warm_up(ec, threads);
+  if (ec) {
+    throw std::system_error(ec, "Could not load time zones.");
+  }
+  return timings;
+}
+
 }  // namespace dtz
@@ -0,0 +1,558 @@
+#include <dtz/recurrence.hpp>
+#include <dtz/parse.hpp>
+#include <algorithm>
+#include <system_error>
+
+namespace dtz {
+namespace {
+
+constexpr std::int64_t floor_div(std::int64_t a, std::int64_t b) noexcept
+{
+  return a / b - (a % b < 0 ? 1 : 0);
+}
+
+// The Gregorian calendar repeats every 400 years, so a rule without occurrences in 401 years has none.
+constexpr std::int64_t max_years = 401;
+
+// The epoch 1970-01-01 is a Thursday.
+constexpr unsigned epoch_weekday = 4;
+
+template <std::integral Integral>
+bool parse_integer(std::string_view str, Integral& value) noexcept
+{
+  if (!str.empty() && str.front() == '+') {
+    str.remove_prefix(1);
+  }
+  const auto end = str.data() + str.size();
+  const auto [cur, err] = internal::from_chars(str.data(), end, value);
+  return err == std::errc{} && cur == end;
+}
+
+template <std::integral Integral>
+bool parse_integer(std::string_view str, Integral& value, Integral min, Integral max) noexcept
+{
+  return parse_integer(str, value) && value >= min && value <= max;
+}
+
+bool parse_weekday(std::string_view str, weekday& wd) noexcept
+{
+  constexpr std::string_view names[] = { "SU", "MO", "TU", "WE", "TH", "FR", "SA" };
+  for (unsigned i = 0; i < 7; i++) {
+    if (str == names[i]) {
+      wd = weekday{ i };
+      return true;
+    }
+  }
+  return false;
+}
+
+// Calls f for every comma separated value and stops at the first value that f rejects.
+template <typename F>
+bool parse_list(std::string_view list, F&& f)
+{
+  if (list.empty()) {
+    return false;
+  }
+  while (true) {
+    const auto pos = list.find(',');
+    if (!f(list.substr(0, pos))) {
+      return false;
+    }
+    if (pos == std::string_view::npos) {
+      return true;
+    }
+    list.remove_prefix(pos + 1);
+  }
+}
+
+// Parses "YYYYMMDD", "YYYYMMDDTHHMMSS" and "YYYYMMDDTHHMMSSZ" into a local time or a sys time (utc = true).
+bool parse_until(std::string_view str, local_time<seconds>& lt, bool& utc, bool& date) noexcept
+{
+  int y = 0;
+  unsigned m = 0;
+  unsigned d = 0;
+  if (str.size() < 8 || !parse_integer(str.substr(0, 4), y) || !parse_integer(str.substr(4, 2), m) ||
+      !parse_integer(str.substr(6, 2), d))
+  {
+    return false;
+  }
+  const auto ymd = year{ y } / month{ m } / day{ d };
+  if (!ymd.ok()) {
+    return false;
+  }
+  lt = local_days{ ymd };
+  utc = false;
+  date = str.size() == 8;
+  if (date) {
+    return true;
+  }
+  int h = 0;
+  int mi = 0;
+  int s = 0;
+  if (str.size() < 15 || str[8] != 'T' || !parse_integer(str.substr(9, 2), h, 0, 23) ||
+      !parse_integer(str.substr(11, 2), mi, 0, 59) || !parse_integer(str.substr(13, 2), s, 0, 60))
+  {
+    return false;
+  }
+  lt += hours{ h } + minutes{ mi } + seconds{ s };
+  if (str.size() == 16 && str[15] == 'Z') {
+    utc = true;
+    return true;
+  }
+  return str.size() == 15;
+}
+
+}  // namespace
+
+recurrence::recurrence(const time_zone* zone, local_time<seconds> dtstart, std::string_view rule, std::error_code& ec) :
+  zone_(zone), dtstart_(dtstart)
+{
+  initialize(rule, ec);
+}
+
+recurrence::recurrence(const time_zone* zone, local_time<seconds> dtstart, std::string_view rule) :
+  zone_(zone), dtstart_(dtstart)
+{
+  std::error_code ec;
+  initialize(rule, ec);
+  if (ec) {
+    throw std::system_error(ec, "Could not parse recurrence rule.");
+  }
+}
+
+void recurrence::initialize(std::string_view rule, std::error_code& ec)
+{
+  ec.clear();
+  if (const auto e = parse(rule); e != errc{}) {
+    ec = std::make_error_code(e);
+    return;
+  }
+  first_ = to_sys(dtstart_);
+  if (count_) {
+    const auto first = first_;
+    occurrences_.push_back(first);
+    std::vector<sys_time<seconds>> buffer;
+    const auto start = period(floor<days>(dtstart_));
+    const auto limit = max_years * (freq_ == frequency::daily ? 366 : freq_ == frequency::weekly ? 53 : freq_ == frequency::monthly ? 12 : 1);
+    for (auto p = start; p - start <= limit && occurrences_.size() < count_; p += interval_) {
+      buffer.clear();
+      if (!expand(p, buffer)) {
+        break;
+      }
+      for (const auto tp : buffer) {
+        if (tp != first && occurrences_.size() < count_) {
+          occurrences_.push_back(tp);
+        }
+      }
+    }
+    std::sort(occurrences_.begin(), occurrences_.end());
+  }
+}
+
+errc recurrence::parse(std::string_view rule)
+{
+  if (rule.starts_with("RRULE:")) {
+    rule.remove_prefix(6);
+  }
+
+  auto freq = false;
+  auto byday = false;
+  std::uint32_t byhour = 0;
+  std::uint64_t byminute = 0;
+  std::uint64_t bysecond = 0;
+
+  while (!rule.empty()) {
+    const auto pos = rule.find(';');
+    const auto part = rule.substr(0, pos);
+    rule.remove_prefix(pos == std::string_view::npos ? rule.size() : pos + 1);
+    const auto eq = part.find('=');
+    if (eq == std::string_view::npos) {
+      return errc::invalid_format;
+    }
+    const auto name = part.substr(0, eq);
+    const auto value = part.substr(eq + 1);
+    auto ok = true;
+    if (name == "FREQ") {
+      freq = true;
+      if (value == "DAILY") {
+        freq_ = frequency::daily;
+      } else if (value == "WEEKLY") {
+        freq_ = frequency::weekly;
+      } else if (value == "MONTHLY") {
+        freq_ = frequency::monthly;
+      } else if (value == "YEARLY") {
+        freq_ = frequency::yearly;
+      } else {
+        ok = false;
+      }
+    } else if (name == "INTERVAL") {
+      ok = parse_integer(value, interval_, 1, 1'000'000);
+    } else if (name == "COUNT") {
+      ok = parse_integer(value, count_, std::size_t{ 1 }, std::size_t{ 10'000'000 });
+    } else if (name == "UNTIL") {
+      local_time<seconds> lt;
+      auto utc = false;
+      auto date = false;
+      ok = parse_until(value, lt, utc, date);
+      if (ok) {
+        if (utc) {
+          until_ = sys_time<seconds>{ lt.time_since_epoch() };
+        } else if (date) {
+          until_ = to_sys(lt + days{ 1 }) - seconds{ 1 };
+        } else {
+          until_ = to_sys(lt);
+        }
+      }
+    } else if (name == "WKST") {
+      ok = parse_weekday(value, wkst_);
+    } else if (name == "BYMONTH") {
+      ok = parse_list(value, [&](std::string_view v) {
+        unsigned m = 0;
+        if (!parse_integer(v, m, 1u, 12u)) {
+          return false;
+        }
+        bymonth_ |= static_cast<std::uint16_t>(1u << m);
+        return true;
+      });
+    } else if (name == "BYMONTHDAY") {
+      ok = parse_list(value, [&](std::string_view v) {
+        int d = 0;
+        if (!parse_integer(v, d, -31, 31) || d == 0) {
+          return false;
+        }
+        if (d > 0) {
+          bymonthday_ |= 1u << d;
+        } else {
+          bymonthday_last_ |= 1u << -d;
+        }
+        return true;
+      });
+    } else if (name == "BYDAY") {
+      byday = true;
+      ok = parse_list(value, [&](std::string_view v) {
+        if (v.size() < 2) {
+          return false;
+        }
+        weekday wd;
+        if (!parse_weekday(v.substr(v.size() - 2), wd)) {
+          return false;
+        }
+        const auto w = wd.c_encoding();
+        if (v.size() == 2) {
+          byday_[w] |= 1;
+          return true;
+        }
+        int n = 0;
+        if (!parse_integer(v.substr(0, v.size() - 2), n, -53, 53) || n == 0) {
+          return false;
+        }
+        byday_ordinals_ = true;
+        if (n > 0) {
+          byday_[w] |= std::uint64_t{ 1 } << n;
+        } else {
+          byday_last_[w] |= std::uint64_t{ 1 } << -n;
+        }
+        return true;
+      });
+    } else if (name == "BYHOUR") {
+      ok = parse_list(value, [&](std::string_view v) {
+        int h = 0;
+        if (!parse_integer(v, h, 0, 23)) {
+          return false;
+        }
+        byhour |= 1u << h;
+        return true;
+      });
+    } else if (name == "BYMINUTE") {
+      ok = parse_list(value, [&](std::string_view v) {
+        int m = 0;
+        if (!parse_integer(v, m, 0, 59)) {
+          return false;
+        }
+        byminute |= std::uint64_t{ 1 } << m;
+        return true;
+      });
+    } else if (name == "BYSECOND") {
+      ok = parse_list(value, [&](std::string_view v) {
+        int s = 0;
+        if (!parse_integer(v, s, 0, 59)) {
+          return false;
+        }
+        bysecond |= std::uint64_t{ 1 } << s;
+        return true;
+      });
+    } else if (name == "BYSETPOS") {
+      ok = parse_list(value, [&](std::string_view v) {
+        int n = 0;
+        if (!parse_integer(v, n, -366, 366) || n == 0) {
+          return false;
+        }
+        bysetpos_.push_back(n);
+        return true;
+      });
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      return errc::invalid_format;
+    }
+  }
+
+  if (!freq) {
+    return errc::invalid_format;
+  }
+  if (byday_ordinals_ && (freq_ == frequency::daily || freq_ == frequency::weekly)) {
+    return errc::invalid_format;
+  }
+  if ((bymonthday_ || bymonthday_last_) && freq_ == frequency::weekly) {
+    return errc::invalid_format;
+  }
+
+  // Rule parts that are not given are taken from DTSTART.
+  const auto start = floor<days>(dtstart_);
+  const auto ymd = year_month_day{ start };
+  const auto monthday = bymonthday_ || bymonthday_last_;
+  switch (freq_) {
+  case frequency::daily:
+    break;
+  case frequency::weekly:
+    if (!byday) {
+      byday_[weekday{ start }.c_encoding()] |= 1;
+    }
+    break;
+  case frequency::monthly:
+    if (!byday && !monthday) {
+      bymonthday_ |= 1u << static_cast<unsigned>(ymd.day());
+    }
+    break;
+  case frequency::yearly:
+    if (!byday && !monthday) {
+      if (!bymonth_) {
+        bymonth_ |= static_cast<std::uint16_t>(1u << static_cast<unsigned>(ymd.month()));
+      }
+      bymonthday_ |= 1u << static_cast<unsigned>(ymd.day());
+    }
+    break;
+  }
+
+  byday_any_ = std::any_of(byday_.begin(), byday_.end(), [](auto v) { return v != 0; }) ||
+    std::any_of(byday_last_.begin(), byday_last_.end(), [](auto v) { return v != 0; });
+
+  const auto hms = hh_mm_ss<seconds>{ dtstart_ - start };
+  if (!byhour) {
+    byhour = 1u << hms.hours().count();
+  }
+  if (!byminute) {
+    byminute = std::uint64_t{ 1 } << hms.minutes().count();
+  }
+  if (!bysecond) {
+    bysecond = std::uint64_t{ 1 } << hms.seconds().count();
+  }
+  for (int h = 0; h < 24; h++) {
+    for (int m = 0; m < 60 && (byhour >> h & 1); m++) {
+      for (int s = 0; s < 60 && (byminute >> m & 1); s++) {
+        if (bysecond >> s & 1) {
+          times_.push_back(hours{ h } + minutes{ m } + seconds{ s });
+        }
+      }
+    }
+  }
+  return errc{};
+}
+
+sys_time<seconds> recurrence::next(sys_time<seconds> tp) const
+{
+  if (count_) {
+    const auto it = std::upper_bound(occurrences_.begin(), occurrences_.end(), tp);
+    return it != occurrences_.end() ? *it : sys_time<seconds>::max();
+  }
+  if (times_.empty()) {
+    return sys_time<seconds>::max();
+  }
+  if (tp < first_) {
+    return first_;
+  }
+  const auto start = period(floor<days>(dtstart_));
+  auto p = period(floor<days>(zone_->to_local(tp)));
+  p = std::max(start, start + floor_div(p - start, interval_) * interval_);
+  const auto limit = p + max_years * (freq_ == frequency::daily ? 366 : freq_ == frequency::weekly ? 53 : freq_ == frequency::monthly ? 12 : 1);
+  thread_local std::vector<sys_time<seconds>> buffer;
+  for (; p <= limit; p += interval_) {
+    buffer.clear();
+    if (!expand(p, buffer)) {
+      break;
+    }
+    if (const auto it = std::upper_bound(buffer.begin(), buffer.end(), tp); it != buffer.end()) {
+      return *it;
+    }
+  }
+  return sys_time<seconds>::max();
+}
+
+std::int64_t recurrence::period(local_days d) const noexcept
+{
+  switch (freq_) {
+  case frequency::daily:
+    return d.time_since_epoch().count();
+  case frequency::weekly:
+    return floor_div(d.time_since_epoch().count() - (wkst_.c_encoding() + 7 - epoch_weekday) % 7, 7);
+  case frequency::monthly: {
+    const auto ymd = year_month_day{ d };
+    return std::int64_t{ static_cast<int>(ymd.year()) } * 12 + static_cast<unsigned>(ymd.month()) - 1;
+  }
+  case frequency::yearly:
+    return static_cast<int>(year_month_day{ d }.year());
+  }
+  return 0;
+}
+
+local_days recurrence::first_day(std::int64_t period) const noexcept
+{
+  switch (freq_) {
+  case frequency::daily:
+    break;
+  case frequency::weekly:
+    return local_days{ days{ (wkst_.c_encoding() + 7 - epoch_weekday) % 7 + period * 7 } };
+  case frequency::monthly: {
+    const auto y = floor_div(period, 12);
+    return local_days{ year{ static_cast<int>(y) } / month{ static_cast<unsigned>(period - y * 12 + 1) } / 1 };
+  }
+  case frequency::yearly:
+    return local_days{ year{ static_cast<int>(period) } / 1 / 1 };
+  }
+  return local_days{ days{ period } };
+}
+
+// Writes the sorted occurrences in the period that are not before DTSTART and not after UNTIL.
+// Returns false when the period starts after UNTIL.
+bool recurrence::expand(std::int64_t period, std::vector<sys_time<seconds>>& out) const
+{
+  thread_local std::vector<local_days> dates;
+  thread_local std::vector<local_time<seconds>> times;
+  if (until_ != sys_time<seconds>::max() && to_sys(first_day(period) + seconds{ 0 }) > until_) {
+    return false;
+  }
+  dates.clear();
+  times.clear();
+  expand_days(period, dates);
+  for (const auto d : dates) {
+    for (const auto t : times_) {
+      times.push_back(d + t);
+    }
+  }
+  if (!bysetpos_.empty()) {
+    const auto size = static_cast<int>(times.size());
+    auto end = times.begin();
+    for (auto i = 0; i < size; i++) {
+      const auto match = std::any_of(bysetpos_.begin(), bysetpos_.end(), [&](int n) {
+        return n > 0 ? n - 1 == i : size + n == i;
+      });
+      if (match) {
+        *end++ = times[static_cast<std::size_t>(i)];
+      }
+    }
+    times.erase(end, times.end());
+  }
+  for (const auto lt : times) {
+    if (lt < dtstart_) {
+      continue;
+    }
+    if (const auto st = to_sys(lt); st <= until_) {
+      out.push_back(st);
+    }
+  }
+  // Local times in a gap use the offset before the gap and can be later than the following local times.
+  std::sort(out.begin(), out.end());
+  return true;
+}
+
+void recurrence::expand_days(std::int64_t period, std::vector<local_days>& out) const
+{
+  const auto month_days = [&](year_month ym) {
+    const auto last = static_cast<int>(static_cast<unsigned>((ym / dtz::last).day()));
+    const auto first = local_days{ ym / 1 };
+    for (auto d = 1; d <= last; d++) {
+      const auto date = first + days{ d - 1 };
+      if (match_monthday(d, last) && match_weekday(date, (d - 1) / 7 + 1, (last - d) / 7 + 1)) {
+        out.push_back(date);
+      }
+    }
+  };
+  switch (freq_) {
+  case frequency::daily: {
+    const auto date = first_day(period);
+    const auto ymd = year_month_day{ date };
+    const auto last = static_cast<int>(static_cast<unsigned>((ymd.year() / ymd.month() / dtz::last).day()));
+    if (match_month(ymd) && match_monthday(static_cast<int>(static_cast<unsigned>(ymd.day())), last) && match_weekday(date, 0, 0)) {
+      out.push_back(date);
+    }
+    break;
+  }
+  case frequency::weekly: {
+    const auto first = first_day(period);
+    for (auto i = 0; i < 7; i++) {
+      const auto date = first + days{ i };
+      if (match_month(year_month_day{ date }) && match_weekday(date, 0, 0)) {
+        out.push_back(date);
+      }
+    }
+    break;
+  }
+  case frequency::monthly: {
+    const auto ymd = year_month_day{ first_day(period) };
+    if (match_month(ymd)) {
+      month_days(ymd.year() / ymd.month());
+    }
+    break;
+  }
+  case frequency::yearly: {
+    const auto y = year{ static_cast<int>(period) };
+    if (byday_ordinals_ && !bymonth_ && !bymonthday_ && !bymonthday_last_) {
+      // Weekday ordinals count within the year when neither months nor month days are given.
+      const auto first = local_days{ y / 1 / 1 };
+      const auto size = static_cast<int>((local_days{ (y + years{ 1 }) / 1 / 1 } - first).count());
+      for (auto d = 0; d < size; d++) {
+        if (match_weekday(first + days{ d }, d / 7 + 1, (size - 1 - d) / 7 + 1)) {
+          out.push_back(first + days{ d });
+        }
+      }
+    } else {
+      for (unsigned m = 1; m <= 12; m++) {
+        if (!bymonth_ || (bymonth_ >> m & 1)) {
+          month_days(y / month{ m });
+        }
+      }
+    }
+    break;
+  }
+  }
+}
+
+bool recurrence::match_month(year_month_day ymd) const noexcept
+{
+  return !bymonth_ || (bymonth_ >> static_cast<unsigned>(ymd.month()) & 1);
+}
+
+bool recurrence::match_monthday(int d, int last) const noexcept
+{
+  if (!bymonthday_ && !bymonthday_last_) {
+    return true;
+  }
+  return (bymonthday_ >> d & 1) || (bymonthday_last_ >> (last - d + 1) & 1);
+}
+
+bool recurrence::match_weekday(local_days d, int index, int last_index) const noexcept
+{
+  if (!byday_any_) {
+    return true;
+  }
+  const auto w = weekday{ d }.c_encoding();
+  return (byday_[w] & 1) || (index && (byday_[w] >> index & 1)) || (last_index && (byday_last_[w] >> last_index & 1));
+}
+
+sys_time<seconds> recurrence::to_sys(local_time<seconds> lt) const noexcept
+{
+  return sys_time<seconds>{ lt.time_since_epoch() - zone_->get_info(lt).first.offset };
+}
+
+}  // namespace dtz
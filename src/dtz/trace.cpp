@@ -0,0 +1,28 @@
+#include <dtz/trace.hpp>
+
+namespace dtz {
+namespace internal {
+
+const tsc_calibration& calibrate_tsc()
+{
+  static const auto calibration = [] {
+    tsc_calibration result;
+#if DTZ_TSC
+    const auto begin = steady_clock::now();
+    const auto tsc = __rdtsc();
+    auto end = begin;
+    while (end - begin < milliseconds{ 10 }) {
+      end = steady_clock::now();
+    }
+    const auto ticks = __rdtsc() - tsc;
+    result.tsc = tsc;
+    result.ns = duration_cast<nanoseconds>(begin.time_since_epoch()).count();
+    result.ns_per_tick = ticks ? static_cast<double>(duration_cast<nanoseconds>(end - begin).count()) / static_cast<double>(ticks) : 1.0;
+#endif
+    return result;
+  }();
+  return calibration;
+}
+
+}  // namespace internal
+}  // namespace dtz
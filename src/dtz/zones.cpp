@@ -0,0 +1,82 @@
+#include <dtz/zones.hpp>
+#include <fmt/format.h>
+
+namespace dtz {
+namespace {
+
+// Appends a time as "h[:mm[:ss]]" with a sign for negative times.
+void append_time(std::string& str, seconds time, bool pad)
+{
+  if (time < seconds{ 0 }) {
+    str += '-';
+    time = -time;
+  }
+  const auto h = duration_cast<hours>(time);
+  const auto m = duration_cast<minutes>(time - h);
+  const auto s = time - h - m;
+  str += pad ? fmt::format("{:02}", h.count()) : fmt::format("{}", h.count());
+  if (pad || m != minutes{ 0 } || s != seconds{ 0 }) {
+    str += fmt::format(":{:02}", m.count());
+  }
+  if (s != seconds{ 0 }) {
+    str += fmt::format(":{:02}", s.count());
+  }
+}
+
+void append_abbrev(std::string& str, std::string_view abbrev)
+{
+  const auto alpha = std::all_of(abbrev.begin(), abbrev.end(), [](char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+  });
+  if (alpha) {
+    str += abbrev;
+  } else {
+    str += '<';
+    str += abbrev;
+    str += '>';
+  }
+}
+
+void append_rule(std::string& str, const posix_zone::rule& rule)
+{
+  if (rule.type == 'M') {
+    str += fmt::format("M{}.{}.{}", rule.month, rule.week, rule.day);
+  } else if (rule.type == 'J') {
+    str += fmt::format("J{}", rule.day);
+  } else {
+    str += fmt::format("{}", rule.day);
+  }
+  if (rule.time != hours{ 2 }) {
+    str += '/';
+    append_time(str, rule.time, false);
+  }
+}
+
+}  // namespace
+
+std::string fixed_zone::name() const
+{
+  std::string str = offset_ < seconds{ 0 } ? "" : "+";
+  append_time(str, offset_, true);
+  return str;
+}
+
+std::string posix_zone::name() const
+{
+  std::string str;
+  append_abbrev(str, std_abbrev());
+  append_time(str, -std_offset_, false);
+  if (dst_) {
+    append_abbrev(str, dst_abbrev());
+    if (dst_offset_ != std_offset_ + hours{ 1 }) {
+      append_time(str, -dst_offset_, false);
+    }
+    str += ',';
+    append_rule(str, start_);
+    str += ',';
+    append_rule(str, end_);
+  }
+  return str;
+}
+
+}  // namespace dtz
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <dtz/adaptive_parser.hpp>
+#include <string_view>
+#include <system_error>
+
+using namespace dtz::literals;
+
+TEST(dtz, adaptive_parser)
+{
+  const auto tp = "2021-06-01 12:30:05.123456789"_st;
+  const auto check = [&](std::string_view str, dtz::timestamp_layout layout, auto expected) {
+    dtz::adaptive_parser<> parser;
+    EXPECT_EQ(parser.parse(str), expected) << str;
+    EXPECT_EQ(parser.layout(), layout) << str;
+    EXPECT_EQ(parser.parse(str), expected) << str;
+    EXPECT_EQ(parser.hits(), 1) << str;
+    EXPECT_EQ(parser.misses(), 1) << str;
+  };
+  check("2021-06-01", dtz::timestamp_layout::date_time, dtz::floor<dtz::days>(tp));
+  check("2021-06-01 12:30", dtz::timestamp_layout::date_time, dtz::floor<dtz::minutes>(tp));
+  check("2021-06-01 12:30:05", dtz::timestamp_layout::date_time, dtz::floor<dtz::seconds>(tp));
+  check("2021-06-01 12:30:05.123", dtz::timestamp_layout::date_time, dtz::floor<dtz::milliseconds>(tp));
+  check("2021-06-01 12:30:05.123456", dtz::timestamp_layout::date_time, dtz::floor<dtz::microseconds>(tp));
+  check("2021-06-01 12:30:05.123456789", dtz::timestamp_layout::date_time, tp);
+  check("2021-06-01T12:30:05", dtz::timestamp_layout::iso_8601, dtz::floor<dtz::seconds>(tp));
+  check("2021-06-01T12:30:05Z", dtz::timestamp_layout::iso_8601, dtz::floor<dtz::seconds>(tp));
+  check("2021-06-01T12:30:05.123Z", dtz::timestamp_layout::iso_8601, dtz::floor<dtz::milliseconds>(tp));
+  check("2021-06-01T12:30:05.123456", dtz::timestamp_layout::iso_8601, dtz::floor<dtz::microseconds>(tp));
+  check("2021-06-01T12:30:05.123456789Z", dtz::timestamp_layout::iso_8601, tp);
+  check("1622550605", dtz::timestamp_layout::epoch_seconds, dtz::floor<dtz::seconds>(tp));
+  check("1622550605123", dtz::timestamp_layout::epoch_milliseconds, dtz::floor<dtz::milliseconds>(tp));
+  check("1622550605123456", dtz::timestamp_layout::epoch_microseconds, dtz::floor<dtz::microseconds>(tp));
+  check("1622550605123456789", dtz::timestamp_layout::epoch_nanoseconds, tp);
+  check("-86400", dtz::timestamp_layout::epoch_seconds, dtz::sys_time<dtz::nanoseconds>{ -dtz::days{ 1 } });
+  check("1622550605.123456789", dtz::timestamp_layout::epoch_seconds, tp);
+
+  // Values that the learned layout rejects switch the stream to their layout.
+  dtz::adaptive_parser<dtz::milliseconds> parser;
+  EXPECT_EQ(parser.layout(), dtz::timestamp_layout::unknown);
+  EXPECT_EQ(parser.hit_rate(), 0.0);
+  for (int i = 0; i < 8; i++) {
+    EXPECT_EQ(parser.parse("2021-06-01T12:30:05.123Z"), dtz::floor<dtz::milliseconds>(tp));
+  }
+  EXPECT_EQ(parser.parse("2021-06-01T12:30:05Z"), dtz::floor<dtz::seconds>(tp));
+  EXPECT_EQ(parser.parse("1622550605123"), dtz::floor<dtz::milliseconds>(tp));
+  EXPECT_EQ(parser.layout(), dtz::timestamp_layout::epoch_milliseconds);
+  EXPECT_EQ(parser.hits(), 7);
+  EXPECT_EQ(parser.misses(), 3);
+  EXPECT_DOUBLE_EQ(parser.hit_rate(), 0.7);
+
+  // Invalid values keep the learned layout.
+  std::error_code ec;
+  EXPECT_EQ(parser.parse("2021-06-01T12:3x:05Z", ec), dtz::sys_time<dtz::milliseconds>{});
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_minutes_format));
+  EXPECT_EQ(parser.parse("2021-02-30 12:30:05", ec), dtz::sys_time<dtz::milliseconds>{});
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_day_format));
+  EXPECT_EQ(parser.parse("", ec), dtz::sys_time<dtz::milliseconds>{});
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  EXPECT_THROW((void)parser.parse("16225506x5123"), std::system_error);
+  EXPECT_EQ(parser.layout(), dtz::timestamp_layout::epoch_milliseconds);
+  EXPECT_EQ(parser.misses(), 7);
+
+  parser.reset();
+  EXPECT_EQ(parser.layout(), dtz::timestamp_layout::unknown);
+  EXPECT_EQ(parser.hits() + parser.misses(), 0);
+}
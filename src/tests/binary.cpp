@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <dtz/binary.hpp>
+#include <dtz/zones.hpp>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, binary_varint)
+{
+  for (const auto value : { std::uint64_t{ 0 }, std::uint64_t{ 127 }, std::uint64_t{ 128 }, std::numeric_limits<std::uint64_t>::max() }) {
+    std::byte buffer[10];
+    const auto end = dtz::internal::write_varint(buffer, value);
+    std::uint64_t result = 1;
+    EXPECT_EQ(dtz::internal::read_varint(buffer, end, result), end);
+    EXPECT_EQ(result, value);
+    EXPECT_EQ(dtz::internal::read_varint(buffer, end - 1, result), nullptr);
+  }
+  for (const auto value : { std::int64_t{ 0 }, std::int64_t{ -1 }, std::int64_t{ 1 }, std::numeric_limits<std::int64_t>::min() }) {
+    const auto zigzag = dtz::internal::zigzag(static_cast<std::uint64_t>(value));
+    EXPECT_LE(zigzag, static_cast<std::uint64_t>(value < 0 ? -(value + 1) : value) * 2 + 1);
+    EXPECT_EQ(static_cast<std::int64_t>(dtz::internal::unzigzag(zigzag)), value);
+  }
+
+  // Varints with more than 64 bits are rejected.
+  std::vector<std::byte> overflow(9, std::byte{ 0xFF });
+  overflow.push_back(std::byte{ 0x02 });
+  std::uint64_t result = 0;
+  EXPECT_EQ(dtz::internal::read_varint(overflow.data(), overflow.data() + overflow.size(), result), nullptr);
+}
+
+TEST(dtz, binary_fixed)
+{
+  const std::vector<dtz::sys_time<dtz::nanoseconds>> values{ dtz::sys_days{ 2021_y / 3 / 28 } + 1h + 5ns,
+    dtz::sys_time<dtz::nanoseconds>{ -1ns }, dtz::sys_time<dtz::nanoseconds>::max() };
+  std::vector<std::byte> buffer(values.size() * dtz::binary_size<dtz::sys_time<dtz::nanoseconds>>);
+  EXPECT_EQ(dtz::encode_fixed(values, buffer.data()), buffer.data() + buffer.size());
+  EXPECT_EQ(buffer[0], std::byte{ 0x05 });
+  EXPECT_EQ(buffer[8], std::byte{ 0xFF });
+  for (std::size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(dtz::decode_fixed<dtz::sys_time<dtz::nanoseconds>>(buffer.data(), i), values[i]);
+  }
+  std::vector<dtz::sys_time<dtz::nanoseconds>> decoded(values.size());
+  dtz::decode_fixed(buffer.data(), std::span{ decoded });
+  EXPECT_EQ(decoded, values);
+
+  // Types with a narrower representation use the same layout.
+  const std::vector<dtz::local_days> days{ dtz::local_days{ 2021_y / 1 / 1 }, dtz::local_days{ 1900_y / 1 / 1 } };
+  dtz::encode_fixed(days, buffer.data());
+  EXPECT_EQ(dtz::decode_fixed<dtz::local_days>(buffer.data(), 1), days[1]);
+  EXPECT_EQ(dtz::decode_fixed<dtz::days>(buffer.data(), 1), days[1].time_since_epoch());
+
+  dtz::zone_table zones;
+  const auto berlin = dtz::locate_zone("Europe/Berlin");
+  const auto tokyo = dtz::locate_zone("Asia/Tokyo");
+  std::byte zoned[20];
+  auto end = dtz::encode_fixed(dtz::make_zoned(berlin, values[0]), zones, zoned);
+  end = dtz::encode_fixed(dtz::make_zoned(tokyo, values[1]), zones, end);
+  EXPECT_EQ(end, zoned + 20);
+  EXPECT_EQ(zones.size(), 2u);
+  const auto zt = dtz::decode_fixed<dtz::zoned_time<dtz::nanoseconds>>(zoned, zones, 1);
+  EXPECT_EQ(zt.get_time_zone(), tokyo);
+  EXPECT_EQ(zt.get_sys_time(), values[1]);
+}
+
+TEST(dtz, binary_column)
+{
+  // A regular series needs about one byte per value.
+  std::vector<dtz::sys_time<dtz::nanoseconds>> values;
+  for (int i = 0; i < 1000; i++) {
+    values.push_back(dtz::sys_days{ 2021_y / 1 / 1 } + dtz::seconds{ i * 10 });
+  }
+  values[500] += 3ms;
+  std::vector<std::byte> buffer;
+  dtz::encode_column(values, buffer);
+  EXPECT_LT(buffer.size(), 1100u);
+
+  std::vector<dtz::sys_time<dtz::nanoseconds>> decoded;
+  EXPECT_EQ(dtz::decode_column(buffer, decoded), buffer.size());
+  EXPECT_EQ(decoded, values);
+
+  // Random values round-trip exactly, including the extremes.
+  std::mt19937_64 random{ 42 };
+  std::vector<dtz::local_time<dtz::microseconds>> unsorted{ dtz::local_time<dtz::microseconds>::min(), dtz::local_time<dtz::microseconds>::max() };
+  for (int i = 0; i < 1000; i++) {
+    unsorted.emplace_back(dtz::microseconds{ static_cast<std::int64_t>(random()) });
+  }
+  buffer.clear();
+  dtz::encode_column(std::vector<dtz::local_time<dtz::microseconds>>{}, buffer);
+  dtz::encode_column(unsorted, buffer);
+  std::vector<dtz::local_time<dtz::microseconds>> result;
+  const auto empty = dtz::decode_column(buffer, result);
+  EXPECT_TRUE(result.empty());
+  EXPECT_EQ(dtz::decode_column(std::span{ buffer }.subspan(empty), result), buffer.size() - empty);
+  EXPECT_EQ(result, unsorted);
+
+  // Truncated columns are rejected and leave the output unchanged.
+  std::error_code ec;
+  EXPECT_EQ(dtz::decode_column(std::span{ buffer }.subspan(empty, buffer.size() - empty - 1), result, ec), 0u);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_binary_format));
+  EXPECT_EQ(result, unsorted);
+  EXPECT_THROW((void)dtz::decode_column(std::span{ buffer }.subspan(empty, 3), result), std::system_error);
+}
+
+// Zoned times with custom zones have no zone name in the tzdb and are rejected by overload resolution.
+template <typename T>
+concept binary_encodable = requires(const T& value, std::vector<T>& values, std::vector<std::byte>& out, std::byte* p, dtz::zone_table& zones) {
+  dtz::binary_size<T>;
+  dtz::encode_fixed(value, zones, p);
+  dtz::encode_column(values, out);
+};
+
+TEST(dtz, binary_zoned_column)
+{
+  static_assert(binary_encodable<dtz::zoned_time<dtz::milliseconds>>);
+  static_assert(!binary_encodable<dtz::zoned_time<dtz::milliseconds, dtz::fixed_zone>>);
+  static_assert(!binary_encodable<dtz::zoned_time<dtz::milliseconds, dtz::posix_zone>>);
+
+  const auto berlin = dtz::locate_zone("Europe/Berlin");
+  const auto tokyo = dtz::locate_zone("Asia/Tokyo");
+  std::vector<dtz::zoned_time<dtz::milliseconds>> values;
+  for (int i = 0; i < 100; i++) {
+    values.emplace_back(i < 60 || i % 7 == 0 ? berlin : tokyo, dtz::sys_days{ 2021_y / 3 / 28 } + dtz::minutes{ i });
+  }
+  std::vector<std::byte> buffer;
+  dtz::encode_column(values, buffer);
+  std::vector<dtz::zoned_time<dtz::milliseconds>> decoded;
+  EXPECT_EQ(dtz::decode_column(buffer, decoded), buffer.size());
+  ASSERT_EQ(decoded.size(), values.size());
+  for (std::size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(decoded[i].get_time_zone(), values[i].get_time_zone());
+    EXPECT_EQ(decoded[i].get_sys_time(), values[i].get_sys_time());
+  }
+
+  // Zones are stored by name.
+  dtz::zone_table zones;
+  std::error_code ec;
+  EXPECT_EQ(zones.decode(buffer, ec), 1u + 1u + 13u + 1u + 10u);
+  EXPECT_FALSE(ec);
+  EXPECT_EQ(zones[0], berlin);
+  EXPECT_EQ(zones[1], tokyo);
+  EXPECT_EQ(zones[2], nullptr);
+
+  auto unknown = buffer;
+  unknown[3] = std::byte{ 'X' };
+  EXPECT_EQ(dtz::decode_column(unknown, decoded, ec), 0u);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::zone_not_found));
+
+  // Runs that are empty, too long or whose lengths wrap around are rejected and leave the output unchanged.
+  using runs = std::vector<std::uint64_t>;
+  for (const auto& lengths : { runs{ std::numeric_limits<std::uint64_t>::max(), 2 }, runs{ 0, 1 }, runs{ 2 }, runs{} }) {
+    std::vector<std::byte> malformed;
+    dtz::zone_table table;
+    table.add(berlin);
+    table.encode(malformed);
+    dtz::internal::write_varint(malformed, lengths.size());
+    for (const auto n : lengths) {
+      dtz::internal::write_varint(malformed, 0);
+      dtz::internal::write_varint(malformed, n);
+    }
+    dtz::encode_column(std::vector{ values[0].get_sys_time() }, malformed);
+    EXPECT_EQ(dtz::decode_column(malformed, decoded, ec), 0u);
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_binary_format));
+    EXPECT_EQ(decoded.size(), values.size());
+  }
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <dtz/bucketer.hpp>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, bucketer_day)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto begin = dtz::sys_days{ 2018_y / 1 / 1 };
+  const auto end = dtz::sys_days{ 2019_y / 1 / 1 };
+  const dtz::bucketer bucketer{ zone, dtz::bucket_unit::day, begin, end };
+
+  const auto spring = dtz::local_days{ 2018_y / 3 / 25 }.time_since_epoch().count();
+  EXPECT_EQ(bucketer.start(spring), dtz::sys_days{ 2018_y / 3 / 24 } + 23h);
+  EXPECT_EQ(bucketer.end(spring) - bucketer.start(spring), 23h);
+
+  const auto autumn = dtz::local_days{ 2018_y / 10 / 28 }.time_since_epoch().count();
+  EXPECT_EQ(bucketer.end(autumn) - bucketer.start(autumn), 25h);
+
+  EXPECT_EQ(bucketer.id(dtz::sys_days{ 2018_y / 3 / 24 } + 22h + 59min), spring - 1);
+  EXPECT_EQ(bucketer.id(dtz::sys_days{ 2018_y / 3 / 24 } + 23h), spring);
+  EXPECT_EQ(bucketer.id(dtz::sys_days{ 2018_y / 10 / 28 } + 22h + 59min + 59s + 999ms), autumn);
+  EXPECT_EQ(bucketer.id(dtz::sys_days{ 2018_y / 10 / 28 } + 23h), autumn + 1);
+
+  EXPECT_EQ(bucketer.floor(dtz::sys_days{ 2018_y / 6 / 1 } + 12h), dtz::sys_days{ 2018_y / 5 / 31 } + 22h);
+  EXPECT_EQ(bucketer.ceil(dtz::sys_days{ 2018_y / 6 / 1 } + 12h), dtz::sys_days{ 2018_y / 6 / 1 } + 22h);
+  EXPECT_EQ(bucketer.ceil(dtz::sys_days{ 2018_y / 5 / 31 } + 22h), dtz::sys_days{ 2018_y / 5 / 31 } + 22h);
+}
+
+TEST(dtz, bucketer_hour)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const dtz::bucketer bucketer{ zone, dtz::bucket_unit::hour, dtz::sys_days{ 2018_y / 1 / 1 },
+    dtz::sys_days{ 2019_y / 1 / 1 } };
+
+  // Local 02:00 does not exist on 2018-03-25 and occurs twice on 2018-10-28.
+  const auto skipped = (dtz::local_days{ 2018_y / 3 / 25 } + 2h).time_since_epoch().count();
+  EXPECT_EQ(bucketer.start(skipped), bucketer.end(skipped));
+  EXPECT_EQ(bucketer.id(dtz::sys_days{ 2018_y / 3 / 25 } + 1h), skipped + 1);
+
+  const auto repeated = (dtz::local_days{ 2018_y / 10 / 28 } + 2h).time_since_epoch().count();
+  EXPECT_EQ(bucketer.end(repeated) - bucketer.start(repeated), 2h);
+  EXPECT_EQ(bucketer.id(dtz::sys_days{ 2018_y / 10 / 28 } + 0h), repeated);
+  EXPECT_EQ(bucketer.id(dtz::sys_days{ 2018_y / 10 / 28 } + 1h + 30min), repeated);
+}
+
+TEST(dtz, bucketer_calendar)
+{
+  const auto zone = dtz::locate_zone("America/New_York");
+  const auto begin = dtz::sys_days{ 2020_y / 1 / 1 };
+  const auto end = dtz::sys_days{ 2021_y / 1 / 1 };
+  const auto tp = dtz::sys_days{ 2020_y / 5 / 14 } + 12h;
+
+  const dtz::bucketer week{ zone, dtz::bucket_unit::week, begin, end };
+  EXPECT_EQ(week.floor(tp), dtz::sys_days{ 2020_y / 5 / 11 } + 4h);
+  EXPECT_EQ(week.end(week.id(tp)) - week.start(week.id(tp)), dtz::weeks{ 1 });
+
+  const dtz::bucketer month{ zone, dtz::bucket_unit::month, begin, end };
+  EXPECT_EQ(month.id(tp), 2020 * 12 + 4);
+  EXPECT_EQ(month.floor(tp), dtz::sys_days{ 2020_y / 5 / 1 } + 4h);
+  EXPECT_EQ(month.id(dtz::sys_days{ 2020_y / 1 / 1 } + 4h), 2019 * 12 + 11);
+
+  const dtz::bucketer quarter{ zone, dtz::bucket_unit::quarter, begin, end };
+  EXPECT_EQ(quarter.id(tp), 2020 * 4 + 1);
+  EXPECT_EQ(quarter.floor(tp), dtz::sys_days{ 2020_y / 4 / 1 } + 4h);
+  EXPECT_EQ(quarter.end(quarter.id(tp)), dtz::sys_days{ 2020_y / 7 / 1 } + 4h);
+
+  const dtz::bucketer year{ zone, dtz::bucket_unit::year, begin, end };
+  EXPECT_EQ(year.id(tp), 2020);
+  EXPECT_EQ(year.floor(tp), dtz::sys_days{ 2020_y / 1 / 1 } + 5h);
+  EXPECT_EQ(year.start(-1), dtz::sys_days{ -1_y / 1 / 1 } + 5h);
+}
+
+TEST(dtz, bucketer_bulk)
+{
+  const auto zone = dtz::locate_zone("Europe/London");
+  const auto begin = dtz::sys_days{ 2015_y / 1 / 1 };
+  const auto end = dtz::sys_days{ 2025_y / 1 / 1 };
+
+  std::mt19937_64 random{ 42 };
+  std::uniform_int_distribution<std::int64_t> distribution{ -86400 * 365, (end - begin).count() * 86400 + 86400 * 365 };
+  std::vector<dtz::sys_time<dtz::milliseconds>> tps;
+  for (auto i = 0; i < 10000; i++) {
+    tps.push_back(begin + dtz::milliseconds{ distribution(random) * 1000 + i % 1000 });
+  }
+
+  for (const auto unit : { dtz::bucket_unit::hour, dtz::bucket_unit::day, dtz::bucket_unit::week,
+         dtz::bucket_unit::month, dtz::bucket_unit::quarter, dtz::bucket_unit::year }) {
+    const dtz::bucketer table{ zone, unit, begin, end };
+    const dtz::bucketer empty{ zone, unit, begin, begin };
+    std::vector<std::int64_t> ids(tps.size());
+    std::vector<dtz::sys_time<dtz::seconds>> starts(tps.size());
+    table.ids(std::span{ std::as_const(tps) }, std::span{ ids });
+    table.starts(std::span{ std::as_const(tps) }, std::span{ starts });
+    for (std::size_t i = 0; i < tps.size(); i++) {
+      ASSERT_EQ(ids[i], empty.id(tps[i]));
+      ASSERT_EQ(starts[i], empty.start(ids[i]));
+      ASSERT_LE(starts[i], tps[i]);
+      ASSERT_GT(table.end(ids[i]), tps[i]);
+    }
+  }
+}
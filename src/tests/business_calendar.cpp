@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <dtz/business_calendar.hpp>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, business_calendar)
+{
+  const std::vector<dtz::year_month_day> holidays{ 2020_y / 1 / 1, 2020_y / 12 / 24, 2020_y / 12 / 25, 2020_y / 12 / 31 };
+  const std::vector<dtz::weekday> weekend{ dtz::sat, dtz::sun };
+  const dtz::business_calendar calendar{ 2020_y, 2021_y, weekend, holidays };
+  EXPECT_EQ(calendar.first(), 2020_y);
+  EXPECT_EQ(calendar.last(), 2021_y);
+
+  EXPECT_FALSE(calendar.is_business_day(2020_y / 1 / 1));
+  EXPECT_TRUE(calendar.is_business_day(2020_y / 1 / 2));
+  EXPECT_FALSE(calendar.is_business_day(2020_y / 1 / 4));
+
+  EXPECT_EQ(calendar.next(2020_y / 12 / 23), 2020_y / 12 / 28);
+  EXPECT_EQ(calendar.next(2020_y / 12 / 26), 2020_y / 12 / 28);
+  EXPECT_EQ(calendar.prev(2020_y / 12 / 28), 2020_y / 12 / 23);
+  EXPECT_EQ(calendar.prev(2021_y / 1 / 4), 2021_y / 1 / 1);
+
+  EXPECT_EQ(calendar.add_business_days(2020_y / 12 / 23, 0), 2020_y / 12 / 23);
+  EXPECT_EQ(calendar.add_business_days(2020_y / 12 / 23, 1), 2020_y / 12 / 28);
+  EXPECT_EQ(calendar.add_business_days(2020_y / 12 / 26, 1), 2020_y / 12 / 28);
+  EXPECT_EQ(calendar.add_business_days(2020_y / 12 / 23, 4), 2021_y / 1 / 1);
+  EXPECT_EQ(calendar.add_business_days(2020_y / 12 / 28, -1), 2020_y / 12 / 23);
+  EXPECT_EQ(calendar.add_business_days(2020_y / 12 / 27, -2), 2020_y / 12 / 22);
+
+  EXPECT_EQ(calendar.business_days_between(2020_y / 12 / 21, 2020_y / 12 / 28), 3);
+  EXPECT_EQ(calendar.business_days_between(2020_y / 12 / 28, 2020_y / 12 / 21), -3);
+  EXPECT_EQ(calendar.business_days_between(2020_y / 1 / 1, 2021_y / 1 / 1), 262 - 4);
+
+  EXPECT_THROW((void)calendar.is_business_day(2019_y / 12 / 31), std::out_of_range);
+  EXPECT_THROW((void)calendar.next(2021_y / 12 / 31), std::out_of_range);
+  EXPECT_THROW((void)calendar.prev(2020_y / 1 / 2), std::out_of_range);
+}
+
+TEST(dtz, business_calendar_random)
+{
+  std::mt19937 random{ 42 };
+  const auto begin = dtz::sys_days{ 1990_y / 1 / 1 };
+  const auto end = dtz::sys_days{ 2050_y / 1 / 1 };
+  std::uniform_int_distribution<int> day{ 0, static_cast<int>((end - begin).count()) - 1 };
+  std::set<dtz::sys_days> holidays;
+  for (auto i = 0; i < 1000; i++) {
+    holidays.insert(begin + dtz::days{ day(random) });
+  }
+  const std::vector<dtz::year_month_day> holiday_list{ holidays.begin(), holidays.end() };
+  const std::vector<dtz::weekday> weekend{ dtz::fri, dtz::sat };
+  const dtz::business_calendar calendar{ 1990_y, 2049_y, weekend, holiday_list };
+
+  const auto naive = [&](dtz::sys_days d) {
+    const auto wd = dtz::weekday{ d };
+    return wd != dtz::fri && wd != dtz::sat && !holidays.contains(d);
+  };
+  for (auto i = 0; i < 1000; i++) {
+    const auto d = dtz::sys_days{ 2000_y / 1 / 1 } + dtz::days{ day(random) % 10000 };
+    const auto n = static_cast<std::int64_t>(i % 100) - 50;
+    ASSERT_EQ(calendar.is_business_day(d), naive(d));
+    auto expected = d;
+    for (auto k = n; k > 0;) {
+      expected += dtz::days{ 1 };
+      k -= naive(expected) ? 1 : 0;
+    }
+    for (auto k = n; k < 0;) {
+      expected -= dtz::days{ 1 };
+      k += naive(expected) ? 1 : 0;
+    }
+    ASSERT_EQ(dtz::sys_days{ calendar.add_business_days(d, n) }, expected);
+    std::int64_t between = 0;
+    for (auto c = d; c < expected; c += dtz::days{ 1 }) {
+      between += naive(c) ? 1 : 0;
+    }
+    if (n > 0) {
+      ASSERT_EQ(calendar.business_days_between(d, expected), between);
+    }
+  }
+}
+
+TEST(dtz, business_calendar_parse)
+{
+  const auto text =
+    "# Example\n"
+    "years 2020 2021\n"
+    "weekend Sat SUN\n"
+    "2020-12-24 Christmas Eve\n"
+    "2020-12-25 # Christmas\n"
+    "+2020-12-27\n";
+  const auto calendar = dtz::business_calendar::parse(text);
+  EXPECT_FALSE(calendar.is_business_day(2020_y / 12 / 24));
+  EXPECT_FALSE(calendar.is_business_day(2020_y / 12 / 26));
+  EXPECT_TRUE(calendar.is_business_day(2020_y / 12 / 27));
+  EXPECT_EQ(calendar.next(2020_y / 12 / 23), 2020_y / 12 / 27);
+
+  std::error_code ec;
+  (void)dtz::business_calendar::parse("2020-12-24\n", ec);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_year_format));
+  (void)dtz::business_calendar::parse("years 2020 2021\nweekend xyz\n", ec);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  (void)dtz::business_calendar::parse("years 2020 2021\n2020-13-01\n", ec);
+  EXPECT_TRUE(ec);
+  EXPECT_THROW((void)dtz::business_calendar::parse("years 2020\n"), std::system_error);
+
+  const auto path = std::filesystem::temp_directory_path() / "dtz_business_calendar.txt";
+  std::ofstream{ path } << text;
+  EXPECT_TRUE(dtz::business_calendar::load(path).is_business_day(2020_y / 12 / 27));
+  std::filesystem::remove(path);
+  (void)dtz::business_calendar::load(path, ec);
+  EXPECT_EQ(ec, std::make_error_code(std::errc::no_such_file_or_directory));
+}
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 #include <dtz/chrono.hpp>
+#include <cstdlib>
+#include <optional>
+#include <string>
 
 using namespace dtz::literals;
 
@@ -318,6 +321,93 @@ TEST(dtz, make_zoned)
   }
 }
 
+TEST(dtz, make_zoned_error_code)
+{
+  std::error_code ec;
+
+  const auto loc_zone = dtz::locate_zone("Europe/Berlin", ec);
+  ASSERT_FALSE(ec);
+  ASSERT_EQ(loc_zone, dtz::locate_zone("Europe/Berlin"));
+
+  EXPECT_FALSE(dtz::locate_zone("Europe/Atlantis", ec));
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::zone_not_found));
+
+  EXPECT_TRUE(dtz::current_zone(ec));
+  EXPECT_FALSE(ec);
+
+  const auto ymd = dtz::year{ 2018 } / dtz::month{ 3 } / dtz::day{ 25 };
+  const auto hms = 2h + 30min + 1s + 2ms;
+
+  const auto loc_days = dtz::local_days{ ymd };
+  const auto sys_days = dtz::sys_days{ ymd };
+
+  const auto loc_time_point = loc_days + hms;
+  const auto sys_time_point = sys_days + hms;
+
+  // template <SafeZonedLocalTime FromSafeZonedLocalTime>
+  // auto make_zoned(std::string_view zone, const FromSafeZonedLocalTime& tp, std::error_code& ec)
+  {
+    const auto zon = dtz::make_zoned("Europe/Berlin", loc_days + 0h, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(zon.get_local_time(), loc_days);
+
+    EXPECT_FALSE(dtz::make_zoned("Europe/Atlantis", loc_days + 0h, ec).get_time_zone());
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::zone_not_found));
+  }
+
+  // template <UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+  // auto make_zoned(std::string_view zone, const FromUnsafeZonedLocalTime& tp, choose choose, std::error_code& ec)
+  {
+    const auto zon = dtz::make_zoned("Europe/Berlin", loc_time_point, dtz::choose::earliest, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(zon.get_local_time(), loc_days + 3h + 0ms);
+
+    (void)dtz::make_zoned("Europe/Atlantis", loc_time_point, dtz::choose::earliest, ec);
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::zone_not_found));
+  }
+
+  // template <UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+  // auto make_zoned(const time_zone* zone, const FromUnsafeZonedLocalTime& tp, std::error_code& ec)
+  {
+    (void)dtz::make_zoned(loc_zone, loc_time_point, ec);
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::nonexistent_local_time));
+
+    const auto ambiguous = dtz::local_days{ dtz::year{ 2018 } / dtz::month{ 10 } / dtz::day{ 28 } } + hms;
+    (void)dtz::make_zoned(loc_zone, ambiguous, ec);
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::ambiguous_local_time));
+
+    const auto zon = dtz::make_zoned(loc_zone, loc_time_point + 1h, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(zon.get_local_time(), loc_time_point + 1h);
+    EXPECT_EQ(zon.get_sys_time(), sys_time_point - 1h);
+
+    const auto zon_minutes = dtz::make_zoned(loc_zone, dtz::floor<dtz::minutes>(loc_time_point + 1h), ec);
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(zon_minutes.get_local_time(), dtz::floor<dtz::minutes>(loc_time_point + 1h));
+  }
+
+  // template <UnsafeZonedLocalTime FromUnsafeZonedLocalTime>
+  // auto make_zoned(std::string_view zone, const FromUnsafeZonedLocalTime& tp, std::error_code& ec)
+  {
+    (void)dtz::make_zoned("Europe/Berlin", loc_time_point, ec);
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::nonexistent_local_time));
+
+    (void)dtz::make_zoned("Europe/Atlantis", loc_time_point + 1h, ec);
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::zone_not_found));
+  }
+
+  // template <Clock FromClock, ValidZonedTimeDuration FromValidZonedTimeDuration>
+  // auto make_zoned(std::string_view zone, const time_point<FromClock, FromValidZonedTimeDuration>& tp, std::error_code& ec)
+  {
+    const auto zon = dtz::make_zoned("Europe/Berlin", sys_time_point, ec);
+    EXPECT_FALSE(ec);
+    EXPECT_EQ(zon.get_local_time(), loc_time_point + 2h);
+
+    EXPECT_FALSE(dtz::make_zoned("Europe/Atlantis", sys_time_point, ec).get_time_zone());
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::zone_not_found));
+  }
+}
+
 TEST(dtz, cast)
 {
   const auto ymd = dtz::year{ 1971 } / dtz::month{ 1 } / dtz::day{ 1 };
@@ -658,6 +748,13 @@ TEST(dtz, now)
   // auto now(std::string_view zone)
   static_assert(
     std::is_same_v<decltype(dtz::now("Europe/Berlin")), dtz::zoned_time<dtz::system_clock::duration>>);
+
+  // auto now(std::string_view zone, std::error_code& ec)
+  std::error_code ec;
+  EXPECT_TRUE(dtz::now("Europe/Berlin", ec).get_time_zone());
+  EXPECT_FALSE(ec);
+  EXPECT_FALSE(dtz::now("Europe/Atlantis", ec).get_time_zone());
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::zone_not_found));
 }
 
 TEST(dtz, weekday_operators)
@@ -728,3 +825,56 @@ TEST(dtz, zoned_time_operators)
     EXPECT_EQ(dtz::tod(dtz::cast<dtz::local_t>((zon + 2h) - 2h)), 1h + 30min);
   }
 }
+
+// ====================================================================================================================
+// Initialize
+// ====================================================================================================================
+
+TEST(dtz, warm_up)
+{
+  const std::string_view zones[] = { "Europe/Berlin", "Asia/Tokyo", "America/New_York" };
+  std::error_code ec;
+  const auto timings = dtz::warm_up(zones, ec, 2);
+  EXPECT_FALSE(ec);
+  EXPECT_EQ(timings.zone_count, 3u);
+  EXPECT_GE(timings.zones, dtz::nanoseconds{ 0 });
+
+  // Zones that are not found are reported after the others are loaded.
+  const std::string_view unknown[] = { "Europe/Berlin", "Nowhere/Unknown", "UTC" };
+  EXPECT_EQ(dtz::warm_up(unknown, ec).zone_count, 2u);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::zone_not_found));
+  EXPECT_THROW((void)dtz::warm_up(unknown), std::system_error);
+
+  const auto all = dtz::warm_up(ec);
+  EXPECT_FALSE(ec);
+  EXPECT_EQ(all.zone_count, dtz::get_tzdb().zones.size());
+}
+
+#ifndef _WIN32
+TEST(dtz, current_zone)
+{
+  const auto tz = std::getenv("TZ");
+  const auto saved = tz ? std::optional<std::string>{ tz } : std::nullopt;
+
+  const auto zone = dtz::current_zone();
+  ASSERT_TRUE(zone);
+  EXPECT_EQ(dtz::current_zone(), zone);
+
+  setenv("TZ", "Asia/Tokyo", 1);
+  EXPECT_EQ(dtz::current_zone(), zone);
+  dtz::reset_current_zone();
+  EXPECT_EQ(dtz::current_zone()->name(), "Asia/Tokyo");
+
+  setenv("TZ", ":/usr/share/zoneinfo/America/New_York", 1);
+  dtz::reset_current_zone();
+  EXPECT_EQ(dtz::current_zone()->name(), "America/New_York");
+
+  if (saved) {
+    setenv("TZ", saved->data(), 1);
+  } else {
+    unsetenv("TZ");
+  }
+  dtz::reset_current_zone();
+  EXPECT_EQ(dtz::current_zone(), zone);
+}
+#endif
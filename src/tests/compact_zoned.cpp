@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include <dtz.hpp>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, zone_id)
+{
+  const auto berlin = dtz::locate_zone("Europe/Berlin");
+  const auto tokyo = dtz::locate_zone("Asia/Tokyo");
+  EXPECT_EQ(dtz::zone_id{}.zone(), dtz::locate_zone("UTC"));
+  EXPECT_EQ(dtz::zone_id{ dtz::locate_zone("UTC") }, dtz::zone_id{});
+  const auto id = dtz::zone_id{ berlin };
+  EXPECT_EQ(dtz::zone_id{ berlin }, id);
+  EXPECT_NE(dtz::zone_id{ tokyo }, id);
+  EXPECT_EQ(id.zone(), berlin);
+  EXPECT_LT(id.value(), dtz::zone_id::size());
+  EXPECT_EQ(dtz::zone_id::from_value(0xFFFF).zone(), nullptr);
+  EXPECT_THROW(dtz::zone_id{ nullptr }, std::invalid_argument);
+
+  // Threads registering the same zones get the same ids.
+  const auto zones = { "America/New_York", "America/Chicago", "Asia/Kolkata", "Europe/London" };
+  std::vector<std::vector<std::uint16_t>> ids(4);
+  std::vector<std::thread> threads;
+  for (auto& v : ids) {
+    threads.emplace_back([&] {
+      for (const auto name : zones) {
+        v.push_back(dtz::zone_id{ dtz::locate_zone(name) }.value());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (const auto& v : ids) {
+    EXPECT_EQ(v, ids[0]);
+  }
+}
+
+TEST(dtz, compact_zoned)
+{
+  static_assert(sizeof(dtz::compact_zoned<>) == 8);
+  static_assert(dtz::ZonedTime<dtz::compact_zoned<dtz::seconds>>);
+
+  const auto berlin = dtz::locate_zone("Europe/Berlin");
+  const auto tp = dtz::sys_days{ 2021_y / 3 / 28 } + 1h + 5ms;
+  const auto zt = dtz::make_zoned(berlin, tp);
+  const auto czt = dtz::compact_zoned<>{ zt };
+  EXPECT_EQ(czt.get_time_zone(), berlin);
+  EXPECT_EQ(czt.get_sys_time(), tp);
+  EXPECT_EQ(czt.get_local_time(), zt.get_local_time());
+  EXPECT_EQ(czt.get_info().abbrev, "CEST");
+  EXPECT_EQ(czt.get_zoned_time(), zt);
+  EXPECT_EQ(static_cast<dtz::zoned_time<dtz::milliseconds>>(czt), zt);
+  EXPECT_EQ(dtz::format(czt), "2021-03-28 03:00:00.005");
+  EXPECT_EQ(dtz::cast<dtz::local_t>(czt), dtz::local_days{ 2021_y / 3 / 28 } + 3h + 5ms);
+  EXPECT_EQ(fmt::format("{}", czt), "2021-03-28 03:00:00.005");
+
+  // Negative counts and the limits of the range.
+  const auto before = dtz::compact_zoned<dtz::seconds>{ berlin, dtz::sys_days{ 1900_y / 1 / 1 } };
+  EXPECT_EQ(before.get_sys_time(), dtz::sys_days{ 1900_y / 1 / 1 });
+  EXPECT_EQ(before.get_time_zone(), berlin);
+  const auto max = dtz::sys_time<dtz::milliseconds>{ dtz::milliseconds{ dtz::compact_zoned<>::max_count } };
+  EXPECT_EQ(dtz::compact_zoned<>(berlin, max).get_sys_time(), max);
+  EXPECT_THROW(dtz::compact_zoned<>(berlin, max + 1ms), std::out_of_range);
+  EXPECT_EQ(dtz::compact_zoned<>{}.get_time_zone(), dtz::locate_zone("UTC"));
+
+  // Values order by sys_time and then by zone.
+  const auto tokyo = dtz::locate_zone("Asia/Tokyo");
+  std::vector<dtz::compact_zoned<>> values{ { tokyo, tp }, { berlin, tp + 1ms }, { berlin, tp }, { berlin, tp - 1h } };
+  std::sort(values.begin(), values.end());
+  EXPECT_EQ(values[0].get_sys_time(), tp - 1h);
+  EXPECT_EQ(values[3].get_sys_time(), tp + 1ms);
+  EXPECT_EQ(values[1].get_zone_id() < values[2].get_zone_id(), dtz::zone_id{ berlin } < dtz::zone_id{ tokyo });
+  EXPECT_NE(values[1], values[2]);
+}
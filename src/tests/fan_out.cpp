@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <dtz/fan_out.hpp>
+#include <string>
+#include <vector>
+
+using namespace dtz::literals;
+
+namespace {
+
+template <typename Duration>
+std::string expected(dtz::sys_time<Duration> tp, std::span<const dtz::time_zone* const> zones)
+{
+  std::string result;
+  for (const auto zone : zones) {
+    result += dtz::format(dtz::make_zoned(zone, tp));
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(dtz, fan_out)
+{
+  std::vector<const dtz::time_zone*> zones;
+  for (const auto name : { "UTC", "Europe/Berlin", "America/Los_Angeles", "Asia/Kathmandu", "Asia/Tokyo", "America/New_York" }) {
+    zones.push_back(dtz::locate_zone(name));
+  }
+  dtz::zone_offsets offsets{ zones };
+  EXPECT_EQ(offsets.size(), zones.size());
+
+  // Instants around midnight in UTC and the zones and around the DST transitions.
+  const auto base = dtz::sys_time<dtz::nanoseconds>{ dtz::sys_days{ 2021_y / 3 / 27 } };
+  for (auto tp = base - 2h + 1ns; tp < base + dtz::days{ 3 }; tp += 17min + 3s + 5ms) {
+    std::string buffer(zones.size() * dtz::traits<dtz::zoned_time<dtz::nanoseconds>>::buffer_size, '\0');
+    EXPECT_EQ(dtz::fan_out(tp, zones, buffer.data()), buffer.data() + buffer.size());
+    EXPECT_EQ(buffer, expected(tp, zones));
+    EXPECT_EQ(dtz::fan_out(tp, offsets, buffer.data()), buffer.data() + buffer.size());
+    EXPECT_EQ(buffer, expected(tp, zones));
+  }
+
+  // Times before the epoch and minutes, which use the zoned_time format with seconds.
+  std::string result;
+  const auto day = dtz::sys_time<dtz::seconds>{ dtz::sys_days{ 1969_y / 12 / 31 } };
+  dtz::fan_out(day, zones, std::back_inserter(result));
+  EXPECT_EQ(result, expected(day, zones));
+  EXPECT_EQ(result.substr(0, 38), "1969-12-31 00:00:001969-12-31 01:00:00");
+  result.clear();
+  const auto minute = dtz::floor<dtz::minutes>(base + 15h + 10min);
+  dtz::fan_out(minute, offsets, std::back_inserter(result));
+  EXPECT_EQ(result, expected(minute, zones));
+}
@@ -75,3 +75,45 @@ TEST(dtz, format_time_point)
   EXPECT_TRUE(format_time_point_test<dtz::fpmonths<float>>());
   EXPECT_TRUE(format_time_point_test<dtz::fpyears<float>>());
 }
+
+TEST(dtz, format_output_iterator)
+{
+  const auto tp = dtz::local_days{ 2020_y / 1 / 1 } + 1h + 1min + 2s + 3ms;
+  std::string str;
+  dtz::format_to(std::back_inserter(str), tp);
+  EXPECT_EQ(str, "2020-01-01 01:01:02.003");
+
+  char buffer[dtz::traits<dtz::year_month_day>::buffer_size];
+  const auto end = dtz::format_to(buffer, 2020_y / 1 / 1);
+  EXPECT_EQ(std::string(buffer, end), "2020-01-01");
+
+  EXPECT_EQ(dtz::format(dtz::year{ -1 } / 1), "-1-01");
+  EXPECT_EQ(dtz::format(dtz::jan / dtz::sun[dtz::last]), "Jan/Sun[last]");
+  EXPECT_EQ(dtz::format(2019_y / 2 / dtz::tue[1]), "2019-02/Tue[1]");
+}
+
+TEST(dtz, format_spec)
+{
+  EXPECT_EQ(fmt::format("{}", 2020_y / 1 / 1), "2020-01-01");
+  EXPECT_EQ(fmt::format("[{:>12}]", 2020_y / 1 / 1), "[  2020-01-01]");
+  EXPECT_EQ(fmt::format("[{:<8}]", 90s), "[00:01:30]");
+
+  // Formatters can be used as const like std::format does.
+  static_assert(requires(const fmt::formatter<dtz::local_days>& f, const dtz::local_days& value, fmt::format_context& context) {
+    f.format(value, context);
+  });
+}
+
+#ifdef __cpp_lib_format
+TEST(dtz, format_std)
+{
+  static_assert(requires(const std::formatter<dtz::local_days, char>& f, const dtz::local_days& value, std::format_context& context) {
+    f.format(value, context);
+  });
+  const auto tp = dtz::local_days{ 2020_y / 1 / 1 } + 1h + 1min + 2s + 3ms;
+  EXPECT_EQ(std::format("{}", tp), fmt::format("{}", tp));
+  EXPECT_EQ(std::format("{}", dtz::hms(1h + 1min)), "01:01");
+  EXPECT_EQ(std::format("[{:>12}]", 2020_y / 1 / 1), "[  2020-01-01]");
+  EXPECT_EQ(std::format("{}", dtz::jan / dtz::sun[1]), "Jan/Sun[1]");
+}
+#endif
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <dtz/histogram.hpp>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, histogram_buckets)
+{
+  // Every value maps to a bucket that contains it and buckets are contiguous.
+  for (const auto precision : { 2, 7, 12 }) {
+    for (std::size_t i = 1; i < dtz::internal::histogram_buckets(precision); i++) {
+      ASSERT_EQ(dtz::internal::histogram_lower(i, precision), dtz::internal::histogram_upper(i - 1, precision) + 1);
+    }
+    std::mt19937_64 random{ 42 };
+    for (int i = 0; i < 10000; i++) {
+      const auto value = random() >> (random() % 64);
+      const auto index = dtz::internal::histogram_index(value, precision);
+      ASSERT_LT(index, dtz::internal::histogram_buckets(precision));
+      ASSERT_LE(dtz::internal::histogram_lower(index, precision), value);
+      ASSERT_GE(dtz::internal::histogram_upper(index, precision), value);
+    }
+    EXPECT_EQ(dtz::internal::histogram_index(~std::uint64_t{ 0 }, precision), dtz::internal::histogram_buckets(precision) - 1);
+  }
+}
+
+TEST(dtz, histogram)
+{
+  dtz::histogram<dtz::nanoseconds> histogram{ 7, 4 };
+  EXPECT_EQ(histogram.read().count(), 0u);
+  EXPECT_EQ(histogram.read().percentile(50.0), 0ns);
+  EXPECT_EQ(histogram.read().min(), 0ns);
+
+  for (std::int64_t i = 1; i <= 1000; i++) {
+    histogram.record(dtz::microseconds{ i });
+  }
+  histogram.record(-5ns);
+  const auto snapshot = histogram.read();
+  EXPECT_EQ(snapshot.count(), 1001u);
+  EXPECT_EQ(snapshot.min(), 0ns);
+  EXPECT_EQ(snapshot.max(), 1ms);
+  EXPECT_EQ(snapshot.percentile(0.0), 0ns);
+  EXPECT_EQ(snapshot.percentile(100.0), 1ms);
+
+  // Percentiles are within 1/64 above the exact value.
+  for (const auto p : { 10.0, 50.0, 90.0, 99.0, 99.9 }) {
+    const auto exact = dtz::microseconds{ static_cast<std::int64_t>(std::ceil(p / 100.0 * 1001)) - 1 };
+    const auto value = snapshot.percentile(p);
+    EXPECT_GE(value, exact) << p;
+    EXPECT_LE(value, exact + exact / 64) << p;
+  }
+
+  auto merged = snapshot;
+  merged += snapshot;
+  EXPECT_EQ(merged.count(), 2002u);
+  EXPECT_EQ(merged.percentile(50.0), snapshot.percentile(50.0));
+  EXPECT_EQ(merged.mean(), snapshot.mean());
+
+  histogram.reset();
+  EXPECT_EQ(histogram.read().count(), 0u);
+  histogram.record(1250us);
+  EXPECT_EQ(dtz::format(histogram.read()),
+    "count=1 min=00:00:00.001250000 mean=00:00:00.001250000 p50=00:00:00.001250000 "
+    "p90=00:00:00.001250000 p99=00:00:00.001250000 p99.9=00:00:00.001250000 max=00:00:00.001250000");
+}
+
+TEST(dtz, histogram_threads)
+{
+  dtz::histogram<dtz::microseconds> histogram{ 5, 4 };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&histogram, t] {
+      for (int i = 0; i < 10000; i++) {
+        histogram.record(dtz::microseconds{ t * 10000 + i });
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto snapshot = histogram.read();
+  EXPECT_EQ(snapshot.count(), 80000u);
+  EXPECT_EQ(snapshot.min(), 0us);
+  EXPECT_EQ(snapshot.max(), 79999us);
+  EXPECT_EQ(snapshot.mean(), dtz::microseconds{ 39999 });
+}
+
+TEST(dtz, histogram_thread_churn)
+{
+  // Threads that exit give their shards to later threads instead of falling onto the shared shard.
+  dtz::histogram<dtz::microseconds> histogram{ 5, 4 };
+  for (int t = 0; t < 100; t++) {
+    std::thread{ [&histogram] {
+      histogram.record(1us);
+    } }.join();
+  }
+  EXPECT_EQ(histogram.read().count(), 100u);
+  EXPECT_EQ(histogram.shared_count(), 0u);
+
+  // Threads beyond the shards record on the shared shard.
+  std::vector<std::thread> threads;
+  std::atomic<int> waiting{ 6 };
+  for (int t = 0; t < 6; t++) {
+    threads.emplace_back([&] {
+      histogram.record(2us);
+      waiting.fetch_sub(1);
+      while (waiting.load() > 0) {
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(histogram.read().count(), 106u);
+  EXPECT_GE(histogram.shared_count(), 2u);
+}
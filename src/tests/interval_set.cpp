@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <dtz/interval_set.hpp>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace dtz::literals;
+
+namespace {
+
+using time_point = dtz::sys_time<dtz::minutes>;
+using interval = dtz::interval<time_point>;
+
+time_point at(int minutes)
+{
+  return time_point{ dtz::minutes{ minutes } };
+}
+
+interval range(int begin, int end)
+{
+  return { at(begin), at(end) };
+}
+
+// Minutes in [0, 200) covered by a set.
+std::set<int> points(const dtz::interval_set<time_point>& set)
+{
+  std::set<int> result;
+  for (int m = 0; m < 200; m++) {
+    if (set.contains(at(m))) {
+      result.insert(m);
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(dtz, interval_set)
+{
+  dtz::interval_set<time_point> set{ range(10, 20), range(30, 40) };
+  EXPECT_EQ(set.size(), 2u);
+  EXPECT_TRUE(set.contains(at(10)));
+  EXPECT_FALSE(set.contains(at(20)));
+  EXPECT_EQ(set.find(at(35)), set.begin() + 1);
+  EXPECT_EQ(set.find(at(25)), set.end());
+
+  // Touching and overlapping intervals are coalesced.
+  set.insert(range(20, 25));
+  set.insert(range(5, 10));
+  EXPECT_EQ(set.size(), 2u);
+  EXPECT_EQ(set[0], range(5, 25));
+  set.insert(range(22, 31));
+  EXPECT_EQ(set.size(), 1u);
+  EXPECT_EQ(set[0], range(5, 40));
+  set.insert(range(50, 50));
+  EXPECT_EQ(set.size(), 1u);
+  EXPECT_TRUE(set.contains(range(6, 39)));
+  EXPECT_FALSE(set.contains(range(6, 41)));
+  EXPECT_TRUE(set.overlaps(range(39, 50)));
+  EXPECT_FALSE(set.overlaps(range(40, 50)));
+
+  set.erase(range(10, 20));
+  set.erase(range(0, 6));
+  set.erase(range(35, 100));
+  EXPECT_EQ(set, (dtz::interval_set<time_point>{ range(6, 10), range(20, 35) }));
+  EXPECT_EQ(set.length(), 19min);
+
+  // Local times work the same way.
+  dtz::interval_set<dtz::local_days> days{ { dtz::local_days{ 2021_y / 1 / 1 }, dtz::local_days{ 2021_y / 1 / 8 } } };
+  EXPECT_TRUE(days.contains(dtz::local_days{ 2021_y / 1 / 7 }));
+  EXPECT_EQ(days.length(), dtz::days{ 7 });
+}
+
+TEST(dtz, interval_set_operations)
+{
+  // Compares the operations with sets of minutes.
+  std::mt19937_64 random{ 42 };
+  const auto make = [&] {
+    dtz::interval_set<time_point> set;
+    for (int i = 0; i < 10; i++) {
+      const auto begin = std::uniform_int_distribution<int>{ 0, 190 }(random);
+      const auto r = range(begin, begin + std::uniform_int_distribution<int>{ 0, 20 }(random));
+      if (random() % 4 == 0) {
+        set.erase(r);
+      } else {
+        set.insert(r);
+      }
+    }
+    return set;
+  };
+  for (int round = 0; round < 100; round++) {
+    const auto a = make();
+    const auto b = make();
+    const auto pa = points(a);
+    const auto pb = points(b);
+    std::set<int> expected;
+    std::set_union(pa.begin(), pa.end(), pb.begin(), pb.end(), std::inserter(expected, expected.end()));
+    EXPECT_EQ(points(a | b), expected);
+    expected.clear();
+    std::set_intersection(pa.begin(), pa.end(), pb.begin(), pb.end(), std::inserter(expected, expected.end()));
+    EXPECT_EQ(points(a & b), expected);
+    expected.clear();
+    std::set_difference(pa.begin(), pa.end(), pb.begin(), pb.end(), std::inserter(expected, expected.end()));
+    EXPECT_EQ(points(a - b), expected);
+
+    // Results are coalesced.
+    for (const auto& set : { a, b, a | b, a & b, a - b }) {
+      for (std::size_t i = 1; i < set.size(); i++) {
+        ASSERT_LT(set[i - 1].end, set[i].begin);
+      }
+    }
+  }
+}
+
+TEST(dtz, interval_index)
+{
+  using index = dtz::interval_index<time_point, int>;
+  EXPECT_TRUE(index{}.stab(at(0)).empty());
+
+  // Compares queries with a linear scan for every index size up to 100.
+  std::mt19937_64 random{ 42 };
+  for (int n = 0; n < 100; n++) {
+    std::vector<index::entry> entries;
+    for (int i = 0; i < n; i++) {
+      const auto begin = std::uniform_int_distribution<int>{ 0, 190 }(random);
+      entries.push_back({ range(begin, begin + std::uniform_int_distribution<int>{ 0, random() % 8 ? 10 : 100 }(random)), i });
+    }
+    const index idx{ entries };
+    for (int q = 0; q < 20; q++) {
+      const auto begin = std::uniform_int_distribution<int>{ 0, 200 }(random);
+      const auto query = range(begin, begin + std::uniform_int_distribution<int>{ 0, 20 }(random));
+      std::vector<int> expected;
+      std::vector<int> stabbed;
+      for (const auto& e : entries) {
+        if (e.range.overlaps(query)) {
+          expected.push_back(e.value);
+        }
+        if (e.range.contains(query.begin)) {
+          stabbed.push_back(e.value);
+        }
+      }
+      std::vector<int> result;
+      time_point last{ dtz::minutes{ -1 } };
+      idx.overlap(query, [&](const index::entry& e) {
+        EXPECT_LE(last, e.range.begin);
+        last = e.range.begin;
+        result.push_back(e.value);
+      });
+      std::sort(expected.begin(), expected.end());
+      std::sort(result.begin(), result.end());
+      ASSERT_EQ(result, expected);
+      result.clear();
+      for (const auto& e : idx.stab(query.begin)) {
+        result.push_back(e.value);
+      }
+      std::sort(stabbed.begin(), stabbed.end());
+      std::sort(result.begin(), result.end());
+      ASSERT_EQ(result, stabbed);
+    }
+  }
+}
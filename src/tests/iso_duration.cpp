@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <dtz/iso_duration.hpp>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+using namespace dtz::literals;
+
+namespace {
+
+// Durations with the int rep of date::years, months and days.
+template <typename Period>
+using int_duration = std::chrono::duration<int, Period>;
+
+template <typename Duration>
+std::string format_iso(const Duration& d)
+{
+  char buffer[dtz::iso_duration_buffer_size];
+  return { buffer, dtz::format_iso_duration_to(buffer, d) };
+}
+
+// Formats random values and parses them back.
+template <typename Duration>
+void round_trip()
+{
+  std::mt19937_64 engine{ 42 };
+  const auto limit = Duration::max().count() / 2;
+  std::uniform_int_distribution<std::int64_t> distribution{ -limit, limit };
+  for (int i = 0; i < 1000; i++) {
+    const auto d = Duration{ static_cast<typename Duration::rep>(i < 10 ? i * 7 - 35 : distribution(engine)) };
+    const auto str = format_iso(d);
+    ASSERT_LE(str.size(), dtz::iso_duration_buffer_size);
+    std::error_code ec;
+    EXPECT_EQ(dtz::parse_iso_duration<Duration>(str, ec), d) << str;
+    EXPECT_FALSE(ec) << str;
+  }
+  // The extremes round-trip too, including min() without a positive counterpart.
+  for (const auto d : { Duration::min(), Duration::min() + Duration{ 1 }, Duration::max() }) {
+    const auto str = format_iso(d);
+    std::error_code ec;
+    EXPECT_EQ(dtz::parse_iso_duration<Duration>(str, ec), d) << str;
+    EXPECT_FALSE(ec) << str;
+  }
+}
+
+}  // namespace
+
+TEST(dtz, format_iso_duration)
+{
+  EXPECT_EQ(format_iso(1h + 30min), "PT1H30M");
+  EXPECT_EQ(format_iso(dtz::days{ 3 } + 4h), "P3DT4H");
+  EXPECT_EQ(format_iso(dtz::seconds{ dtz::days{ 3 } }), "P3D");
+  EXPECT_EQ(format_iso(-(2min + 5s)), "-PT2M5S");
+  EXPECT_EQ(format_iso(250ms), "PT0.250S");
+  EXPECT_EQ(format_iso(1s + 5us), "PT1.000005S");
+  EXPECT_EQ(format_iso(1h + 1ns), "PT1H0.000000001S");
+  EXPECT_EQ(format_iso(0ns), "PT0S");
+  EXPECT_EQ(format_iso(0min), "PT0S");
+  EXPECT_EQ(format_iso(25h), "P1DT1H");
+  EXPECT_EQ(format_iso(dtz::days{ 0 }), "P0D");
+  EXPECT_EQ(format_iso(dtz::days{ -8 }), "-P8D");
+  EXPECT_EQ(format_iso(dtz::weeks{ 3 }), "P3W");
+  EXPECT_EQ(format_iso(dtz::months{ 14 }), "P1Y2M");
+  EXPECT_EQ(format_iso(dtz::months{ 0 }), "P0M");
+  EXPECT_EQ(format_iso(dtz::years{ 2 }), "P2Y");
+  EXPECT_EQ(format_iso(std::chrono::duration<std::int64_t, std::centi>{ 150 }), "PT1.500S");
+  EXPECT_EQ(format_iso(dtz::nanoseconds::min() + 1ns), "-P106751DT23H47M16.854775807S");
+  EXPECT_EQ(format_iso(dtz::nanoseconds::min()), "-P106751DT23H47M16.854775808S");
+  EXPECT_EQ(format_iso(dtz::seconds::min()), "-P106751991167300DT15H30M8S");
+  EXPECT_EQ(format_iso(int_duration<dtz::years::period>::max()), "P2147483647Y");
+  EXPECT_EQ(format_iso(int_duration<dtz::years::period>::min()), "-P2147483648Y");
+  EXPECT_EQ(format_iso(int_duration<dtz::months::period>::min()), "-P178956970Y8M");
+  EXPECT_EQ(format_iso(dtz::months::max()), "P" + std::to_string(dtz::months::max().count() / 12) + "Y" +
+                                               std::to_string(dtz::months::max().count() % 12) + "M");
+}
+
+TEST(dtz, parse_iso_duration)
+{
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("PT1H30M"), 1h + 30min);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("P3DT4H"), dtz::days{ 3 } + 4h);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("P1W2D"), dtz::days{ 9 });
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("+PT90S"), 90s);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("-PT0S"), 0s);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("P1Y"), dtz::years{ 1 });
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("P1M"), dtz::months{ 1 });
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("PT1M"), 1min);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::months>("P1Y6M"), dtz::months{ 18 });
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::days>("P12M"), dtz::days{ 365 });
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::nanoseconds>("PT0.5S"), 500ms);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::nanoseconds>("PT1,25S"), 1250ms);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::nanoseconds>("PT0.1234567891S"), 123456789ns);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::milliseconds>("-PT1.2349S"), -1234ms);
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("PT36H"), dtz::days{ 1 } + 12h);
+
+  std::error_code ec;
+  for (const auto str : { "", "P", "PT", "P1DT", "1D", "PD", "P1", "P1X", "PT1D", "P1H", "P1D1Y", "P1M1M", "PTT1H", "P1DT1H1D",
+         "PT1.5M", "PT1.S", "P-1D", "PT1H ", " PT1H", "P99999999999999999999D" }) {
+    EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>(str, ec), 0s) << str;
+    EXPECT_TRUE(ec) << str;
+    ec.clear();
+  }
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::nanoseconds>("P1000Y", ec), 0ns);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  ec.clear();
+  EXPECT_EQ(dtz::parse_iso_duration<int_duration<dtz::days::period>>("P2147483648D", ec).count(), 0);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  ec.clear();
+  EXPECT_EQ(dtz::parse_iso_duration<int_duration<dtz::months::period>>("P178956971Y", ec).count(), 0);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  ec.clear();
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::nanoseconds>("-P106751DT23H47M16.854775808S"), dtz::nanoseconds::min());
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::nanoseconds>("P106751DT23H47M16.854775808S", ec), 0ns);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  ec.clear();
+  EXPECT_EQ(dtz::parse_iso_duration<int_duration<dtz::years::period>>("-P2147483648Y").count(), std::numeric_limits<int>::min());
+  EXPECT_EQ(dtz::parse_iso_duration<int_duration<dtz::years::period>>("-P2147483649Y", ec).count(), 0);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  ec.clear();
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::seconds>("P4294967296D"), dtz::seconds{ 4294967296 * 86400 });
+  EXPECT_EQ(dtz::parse_iso_duration<dtz::months>("P4294967296Y"), dtz::months{ 4294967296 * 12 });
+  EXPECT_THROW((void)dtz::parse_iso_duration<dtz::seconds>("P1X"), std::system_error);
+
+  round_trip<dtz::nanoseconds>();
+  round_trip<dtz::microseconds>();
+  round_trip<dtz::milliseconds>();
+  round_trip<dtz::seconds>();
+  round_trip<dtz::minutes>();
+  round_trip<dtz::hours>();
+  round_trip<dtz::days>();
+  round_trip<dtz::weeks>();
+  round_trip<dtz::months>();
+  round_trip<dtz::years>();
+  round_trip<int_duration<dtz::days::period>>();
+  round_trip<int_duration<dtz::weeks::period>>();
+  round_trip<int_duration<dtz::months::period>>();
+  round_trip<int_duration<dtz::years::period>>();
+
+  static_assert([] {
+    dtz::seconds result{};
+    return dtz::internal::parse_iso_duration("P1DT2H3M4S", result) == dtz::errc{} && result == 93784s;
+  }());
+}
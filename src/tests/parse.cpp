@@ -46,3 +46,85 @@ TEST(dtz, parse_duration)
   //EXPECT_TRUE(parse_duration_test("36:00", dtz::fpdays<float>{ 1.5f }));
   //EXPECT_TRUE(parse_duration_test("24:00", dtz::fpweeks<float>{ 1.0f / 7 }));
 }
+
+template <dtz::Duration Duration>
+bool parse_time_point_test()
+{
+  bool success = true;
+  for (const auto& e : format_time_point_data<Duration>::value) {
+    const auto v = dtz::parse<dtz::local_time<Duration>>(e.first);
+    success &= v == e.second;
+    EXPECT_EQ(e.second, v);
+    EXPECT_EQ(e.first, dtz::format(v));
+  }
+  return success;
+}
+
+TEST(dtz, parse_time_point)
+{
+  EXPECT_TRUE(parse_time_point_test<dtz::nanoseconds>());
+  EXPECT_TRUE(parse_time_point_test<dtz::microseconds>());
+  EXPECT_TRUE(parse_time_point_test<dtz::milliseconds>());
+  EXPECT_TRUE(parse_time_point_test<dtz::seconds>());
+  EXPECT_TRUE(parse_time_point_test<dtz::minutes>());
+  EXPECT_TRUE(parse_time_point_test<dtz::hours>());
+  EXPECT_TRUE(parse_time_point_test<dtz::days>());
+
+  EXPECT_EQ(
+    dtz::parse<dtz::sys_time<dtz::seconds>>("2020-01-01 01:01:02"),
+    dtz::sys_days{ 2020_y / 1 / 1 } + 1h + 1min + 2s);
+
+  std::error_code ec;
+  EXPECT_EQ(dtz::parse<dtz::local_time<dtz::seconds>>("2020-02-30 00:00:00", ec).time_since_epoch(), 0s);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_day_format));
+  EXPECT_THROW((void)dtz::parse<dtz::local_time<dtz::seconds>>("2020-01-01 24:00:00"), std::system_error);
+  EXPECT_THROW((void)dtz::parse<dtz::seconds>(""), std::system_error);
+}
+
+TEST(dtz, parse_literals)
+{
+  using dtz::literals::operator""_dur;
+  using dtz::literals::operator""_lt;
+  using dtz::literals::operator""_st;
+  using dtz::literals::operator""_h;
+  using dtz::literals::operator""_min;
+  using dtz::literals::operator""_s;
+  using dtz::literals::operator""_ms;
+  using dtz::literals::operator""_us;
+  using dtz::literals::operator""_ns;
+
+  static_assert("01:30:00"_dur == 1h + 30min);
+  static_assert(std::is_same_v<decltype("01:30"_dur), dtz::minutes>);
+  static_assert(std::is_same_v<decltype("01:30:00"_dur), dtz::seconds>);
+  static_assert(std::is_same_v<decltype("-168:00:00.001"_dur), dtz::milliseconds>);
+  static_assert("-168:00:00.001"_dur == -(dtz::weeks{ 1 } + 1ms));
+  static_assert(std::is_same_v<decltype("00:00:00.000001"_dur), dtz::microseconds>);
+  static_assert(std::is_same_v<decltype("00:00:00.000000001"_dur), dtz::nanoseconds>);
+
+  static_assert("02:00"_h == 2h);
+  static_assert("01:30"_min == 90min);
+  static_assert("00:01:30"_s == 90s);
+  static_assert("00:00:01.500"_ms == 1500ms);
+  static_assert("00:00:00.000500"_us == 500us);
+  static_assert("00:00:00.000000500"_ns == 500ns);
+
+  static_assert("2020-01-01"_lt == dtz::local_days{ 2020_y / 1 / 1 });
+  static_assert(std::is_same_v<decltype("2020-01-01"_lt), dtz::local_days>);
+  static_assert(std::is_same_v<decltype("2020-01-01 01:01"_lt), dtz::local_time<dtz::minutes>>);
+  static_assert(std::is_same_v<decltype("2020-01-01 01:01:02"_lt), dtz::local_time<dtz::seconds>>);
+  static_assert(
+    "2020-01-01 01:01:02.003"_lt == dtz::local_days{ 2020_y / 1 / 1 } + 1h + 1min + 2s + 3ms);
+  static_assert(
+    std::is_same_v<decltype("2020-01-01 01:01:02.003004"_lt), dtz::local_time<dtz::microseconds>>);
+  static_assert(
+    std::is_same_v<decltype("2020-01-01 01:01:02.003004005"_lt), dtz::local_time<dtz::nanoseconds>>);
+  static_assert("-0001-01-01"_lt == dtz::local_days{ dtz::year{ -1 } / 1 / 1 });
+  static_assert("2020-01-01 01:01:02"_st == dtz::sys_days{ 2020_y / 1 / 1 } + 1h + 1min + 2s);
+
+  static_assert(dtz::lt("2020-01-01 00:00:00.000") == dtz::local_days{ 2020_y / 1 / 1 } + 0ms);
+  static_assert(dtz::st("2020-01-01 00:00") == dtz::sys_days{ 2020_y / 1 / 1 } + 0min);
+  static_assert(dtz::lt("-0001-01-01 00:00:00") == dtz::local_days{ dtz::year{ -1 } / 1 / 1 } + 0s);
+  static_assert(std::is_same_v<decltype(dtz::lt("-0001-01-01 00:00:00")), dtz::local_time<dtz::seconds>>);
+  static_assert(dtz::st("-0001-12-31") == dtz::sys_days{ dtz::year{ -1 } / 12 / 31 });
+  static_assert(dtz::st("-0001-12-31 23:59:59.999") == dtz::sys_days{ 0_y / 1 / 1 } - 1ms);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <dtz/parse_epoch.hpp>
+#include <dtz/parse.hpp>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, parse_epoch)
+{
+  using ns = dtz::sys_time<dtz::nanoseconds>;
+  using ms = dtz::sys_time<dtz::milliseconds>;
+  using s = dtz::sys_time<dtz::seconds>;
+  const auto tp = "2021-06-01 12:30:05.123456789"_st;
+
+  // Units detected from the number of digits.
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605"), dtz::floor<dtz::seconds>(tp));
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605123"), dtz::floor<dtz::milliseconds>(tp));
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605123456"), dtz::floor<dtz::microseconds>(tp));
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605123456789"), tp);
+  EXPECT_EQ(dtz::parse_epoch<ns>("100000000"), "1973-03-03 09:46:40"_st);
+  EXPECT_EQ(dtz::parse_epoch<s>("9999999999"), "2286-11-20 17:46:39"_st);
+  EXPECT_EQ(dtz::parse_epoch<s>("-1000000000"), "1938-04-24 22:13:20"_st);
+
+  // Fractions in the detected unit, truncated to the result duration.
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605.123456789"), tp);
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605.1234567891234"), tp);
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605.1"), "2021-06-01 12:30:05.100"_st);
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605123.456789"), tp);
+  EXPECT_EQ(dtz::parse_epoch<ms>("1622550605123456.789"), dtz::floor<dtz::milliseconds>(tp));
+  EXPECT_EQ(dtz::parse_epoch<s>("1622550605123"), dtz::floor<dtz::seconds>(tp));
+  EXPECT_EQ((dtz::parse_epoch<ms, dtz::seconds>("-1.5")), dtz::sys_time<dtz::milliseconds>{ -1500ms });
+
+  // Explicit units accept every number of digits.
+  EXPECT_EQ((dtz::parse_epoch<ms, dtz::seconds>("0")), ms{});
+  EXPECT_EQ((dtz::parse_epoch<ms, dtz::milliseconds>("1622550605123")), dtz::floor<dtz::milliseconds>(tp));
+  EXPECT_EQ((dtz::parse_epoch<ns, dtz::microseconds>("12.5")), ns{ 12500ns });
+
+  // Digits are converted 8 at a time.
+  for (std::uint64_t value = 1; value < 1'000'000'000'000'000'000; value = value * 7 + 3) {
+    EXPECT_EQ((dtz::parse_epoch<ns, dtz::nanoseconds>(std::to_string(value))), ns{ dtz::nanoseconds{ value } });
+  }
+
+  std::error_code ec;
+  for (const auto str : { "", "-", "12345", "12345678901", "1622550605x", "162255060x5123", "1622550605.", "1622550605.12x",
+         "1622550605 ", "99999999999999999999" }) {
+    EXPECT_EQ(dtz::parse_epoch<ns>(str, ec), ns{}) << str;
+    EXPECT_TRUE(ec) << str;
+    ec.clear();
+  }
+  EXPECT_EQ(dtz::parse_epoch<ns>("1622550605.12x", ec), ns{});
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_subseconds_format));
+
+  // Values out of the range of the result duration.
+  EXPECT_EQ((dtz::parse_epoch<ns, dtz::seconds>("9300000000", ec)), ns{});
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  ec.clear();
+  EXPECT_EQ(dtz::parse_epoch<ns>("9223372036.999999999", ec), ns{});
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  ec.clear();
+  EXPECT_EQ(dtz::parse_epoch<ns>("9223372036.854775808", ec), ns{});
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  EXPECT_EQ(dtz::parse_epoch<ns>("9223372036.854775807"), ns::max());
+  EXPECT_EQ(dtz::parse_epoch<ns>("-9223372036.854775807"), ns{ -dtz::nanoseconds::max() });
+  EXPECT_THROW((void)dtz::parse_epoch<ns>("12345"), std::system_error);
+
+  static_assert([] {
+    s result{};
+    return dtz::internal::parse_epoch<void>("1622550605", result) == dtz::errc{} && result == s{ 1622550605s };
+  }());
+}
+
+TEST(dtz, parse_epoch_batch)
+{
+  const std::vector<std::string_view> strs{ "1622550605", "1622550605123", "1622550605.5", "1622550605123456789" };
+  std::vector<dtz::sys_time<dtz::milliseconds>> out(strs.size());
+  dtz::parse_epoch(std::span{ strs }, std::span{ out });
+  EXPECT_EQ(out[0], "2021-06-01 12:30:05.000"_st);
+  EXPECT_EQ(out[1], "2021-06-01 12:30:05.123"_st);
+  EXPECT_EQ(out[2], "2021-06-01 12:30:05.500"_st);
+  EXPECT_EQ(out[3], "2021-06-01 12:30:05.123"_st);
+
+  const std::vector<std::string_view> invalid{ "1622550605", "x" };
+  std::error_code ec;
+  EXPECT_EQ(dtz::parse_epoch(std::span{ invalid }, std::span{ out }, ec), 1);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  EXPECT_THROW(dtz::parse_epoch(std::span{ invalid }, std::span{ out }), std::system_error);
+}
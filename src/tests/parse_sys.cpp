@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <dtz/format.hpp>
+#include <dtz/parse_sys.hpp>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, parse_sys)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  dtz::sys_converter converter{ zone };
+  dtz::sys_converter latest{ zone, dtz::choose::latest };
+
+  // Local times every 7 minutes around the DST transitions of 2021, which includes skipped and
+  // repeated local times.
+  for (const auto base : { dtz::local_days{ 2021_y / 3 / 26 }, dtz::local_days{ 2021_y / 10 / 29 } }) {
+    for (auto lt = dtz::local_time<dtz::milliseconds>{ base }; lt < base + dtz::days{ 4 }; lt += 7min + 1ms) {
+      const auto str = dtz::format(lt);
+      for (const auto choose : { dtz::choose::earliest, dtz::choose::latest }) {
+        const auto expected = dtz::make_zoned(zone, lt, choose).get_sys_time();
+        std::error_code ec;
+        EXPECT_EQ(dtz::parse_sys<dtz::milliseconds>(str, zone, choose, ec), expected) << str;
+        EXPECT_FALSE(ec);
+        auto& cached = choose == dtz::choose::earliest ? converter : latest;
+        EXPECT_EQ(dtz::parse_sys<dtz::milliseconds>(str, cached), expected) << str;
+      }
+    }
+  }
+
+  // Coarse local times have the duration of zoned_time.
+  const auto s = dtz::parse_sys<dtz::minutes>("2021-06-01 12:30", zone, dtz::choose::earliest);
+  static_assert(std::is_same_v<decltype(s), const dtz::sys_time<dtz::seconds>>);
+  EXPECT_EQ(s, "2021-06-01 10:30:00"_st);
+
+  // Local mean time offsets are not whole minutes.
+  const auto kathmandu = dtz::locate_zone("Asia/Kathmandu");
+  EXPECT_EQ(dtz::parse_sys<dtz::seconds>("1900-01-01 00:00:00", kathmandu, dtz::choose::earliest),
+    dtz::make_zoned(kathmandu, "1900-01-01 00:00:00"_lt, dtz::choose::earliest).get_sys_time());
+
+  std::error_code ec;
+  EXPECT_EQ(dtz::parse_sys<dtz::seconds>("2021-06-01 12:3x:00", converter, ec), dtz::sys_time<dtz::seconds>{});
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_minutes_format));
+  EXPECT_THROW((void)dtz::parse_sys<dtz::seconds>("2021-13-01 12:30:00", zone, dtz::choose::earliest), std::system_error);
+}
+
+TEST(dtz, parse_sys_batch)
+{
+  const auto zone = dtz::locate_zone("America/New_York");
+  std::vector<std::string> strings;
+  for (auto lt = "2021-03-13 00:00:00"_lt; lt < "2021-03-16 00:00:00"_lt; lt += 13min) {
+    strings.push_back(dtz::format(lt));
+  }
+  const std::vector<std::string_view> strs{ strings.begin(), strings.end() };
+  std::vector<dtz::sys_time<dtz::seconds>> out(strs.size());
+  dtz::parse_sys<dtz::seconds>(strs, zone, dtz::choose::earliest, out);
+  for (std::size_t i = 0; i < strs.size(); i++) {
+    EXPECT_EQ(out[i], dtz::make_zoned(zone, dtz::parse<dtz::local_time<dtz::seconds>>(strs[i]), dtz::choose::earliest).get_sys_time());
+  }
+
+  strings[5] = "2021-03-13 01:05x";
+  const std::vector<std::string_view> invalid{ strings.begin(), strings.end() };
+  std::error_code ec;
+  EXPECT_EQ(dtz::parse_sys<dtz::seconds>(invalid, zone, dtz::choose::earliest, out, ec), 5);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format));
+  EXPECT_THROW(dtz::parse_sys<dtz::seconds>(invalid, zone, dtz::choose::earliest, out), std::system_error);
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include <dtz/recurrence.hpp>
+#include <iterator>
+#include <vector>
+
+using namespace dtz::literals;
+
+namespace {
+
+using time_points = std::vector<dtz::sys_time<dtz::seconds>>;
+
+// Returns the first occurrences of the rule starting at 1997-09-02 09:00 (RFC 5545 examples).
+time_points expand(std::string_view rule, std::size_t size)
+{
+  const auto zone = dtz::locate_zone("UTC");
+  const dtz::recurrence recurrence{ zone, dtz::local_days{ 1997_y / 9 / 2 } + 9h, rule };
+  time_points result;
+  for (auto tp = recurrence.next(dtz::sys_time<dtz::seconds>::min()); result.size() < size; tp = recurrence.next(tp)) {
+    if (tp == dtz::sys_time<dtz::seconds>::max()) {
+      break;
+    }
+    result.push_back(tp);
+  }
+  return result;
+}
+
+dtz::sys_time<dtz::seconds> at(dtz::year_month_day ymd, dtz::hours h = 9h)
+{
+  return dtz::sys_days{ ymd } + h;
+}
+
+}  // namespace
+
+TEST(dtz, recurrence_rfc5545)
+{
+  EXPECT_EQ(expand("RRULE:FREQ=DAILY;COUNT=3", 10), (time_points{
+    at(1997_y / 9 / 2), at(1997_y / 9 / 3), at(1997_y / 9 / 4) }));
+
+  const auto until = expand("FREQ=DAILY;UNTIL=19971224T000000Z", 1000);
+  ASSERT_EQ(until.size(), 113u);
+  EXPECT_EQ(until.back(), at(1997_y / 12 / 23));
+
+  EXPECT_EQ(expand("FREQ=WEEKLY;INTERVAL=2;WKST=SU;BYDAY=TU,TH;COUNT=8", 10), (time_points{
+    at(1997_y / 9 / 2), at(1997_y / 9 / 4), at(1997_y / 9 / 16), at(1997_y / 9 / 18),
+    at(1997_y / 9 / 30), at(1997_y / 10 / 2), at(1997_y / 10 / 14), at(1997_y / 10 / 16) }));
+
+  EXPECT_EQ(expand("FREQ=MONTHLY;BYDAY=FR;BYMONTHDAY=13", 6), (time_points{
+    at(1997_y / 9 / 2), at(1998_y / 2 / 13), at(1998_y / 3 / 13), at(1998_y / 11 / 13),
+    at(1999_y / 8 / 13), at(2000_y / 10 / 13) }));
+
+  EXPECT_EQ(expand("FREQ=MONTHLY;BYDAY=MO,TU,WE,TH,FR;BYSETPOS=-1", 4), (time_points{
+    at(1997_y / 9 / 2), at(1997_y / 9 / 30), at(1997_y / 10 / 31), at(1997_y / 11 / 28) }));
+
+  EXPECT_EQ(expand("FREQ=MONTHLY;COUNT=4;BYDAY=-1FR;BYHOUR=17", 10), (time_points{
+    at(1997_y / 9 / 2), at(1997_y / 9 / 26, 17h), at(1997_y / 10 / 31, 17h), at(1997_y / 11 / 28, 17h) }));
+
+  EXPECT_EQ(expand("FREQ=MONTHLY;BYMONTHDAY=-3", 3), (time_points{
+    at(1997_y / 9 / 2), at(1997_y / 9 / 28), at(1997_y / 10 / 29) }));
+
+  EXPECT_EQ(expand("FREQ=YEARLY;BYDAY=20MO", 3), (time_points{
+    at(1997_y / 9 / 2), at(1998_y / 5 / 18), at(1999_y / 5 / 17) }));
+
+  EXPECT_EQ(expand("FREQ=YEARLY;BYMONTH=3;BYDAY=TH", 3), (time_points{
+    at(1997_y / 9 / 2), at(1998_y / 3 / 5), at(1998_y / 3 / 12) }));
+
+  EXPECT_EQ(expand("FREQ=YEARLY;INTERVAL=4;BYMONTH=11;BYDAY=TU;BYMONTHDAY=2,3,4,5,6,7,8", 3), (time_points{
+    at(1997_y / 9 / 2), at(1997_y / 11 / 4), at(2001_y / 11 / 6) }));
+
+  EXPECT_EQ(expand("FREQ=YEARLY;BYMONTH=2;BYMONTHDAY=30", 3), (time_points{ at(1997_y / 9 / 2) }));
+}
+
+TEST(dtz, recurrence_next)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const dtz::recurrence daily{ zone, dtz::local_days{ 2000_y / 1 / 1 } + 2h + 30min, "FREQ=DAILY" };
+
+  // Jumps to the requested period without iterating from DTSTART.
+  EXPECT_EQ(daily.next(dtz::sys_days{ 2200_y / 1 / 1 }), dtz::sys_days{ 2200_y / 1 / 1 } + 1h + 30min);
+
+  // Local 02:30 does not exist on 2018-03-25 and uses the offset before the gap.
+  EXPECT_EQ(daily.next(dtz::sys_days{ 2018_y / 3 / 25 }), dtz::sys_days{ 2018_y / 3 / 25 } + 1h + 30min);
+
+  // Local 02:30 occurs twice on 2018-10-28 and resolves to the first occurrence.
+  EXPECT_EQ(daily.next(dtz::sys_days{ 2018_y / 10 / 28 }), dtz::sys_days{ 2018_y / 10 / 28 } + 0h + 30min);
+  EXPECT_EQ(daily.next(dtz::sys_days{ 2018_y / 10 / 28 } + 0h + 30min), dtz::sys_days{ 2018_y / 10 / 29 } + 1h + 30min);
+
+  time_points between;
+  daily.between(dtz::sys_days{ 2020_y / 1 / 1 }, dtz::sys_days{ 2020_y / 1 / 4 }, std::back_inserter(between));
+  EXPECT_EQ(between, (time_points{ dtz::sys_days{ 2020_y / 1 / 1 } + 1h + 30min,
+    dtz::sys_days{ 2020_y / 1 / 2 } + 1h + 30min, dtz::sys_days{ 2020_y / 1 / 3 } + 1h + 30min }));
+}
+
+TEST(dtz, recurrence_error)
+{
+  const auto zone = dtz::locate_zone("UTC");
+  const auto dtstart = dtz::local_days{ 2020_y / 1 / 1 } + 0s;
+  for (const auto rule : { "", "FREQ=HOURLY", "FREQ=DAILY;INTERVAL=0", "FREQ=WEEKLY;BYDAY=1MO", "FREQ=DAILY;BYWEEKNO=1",
+         "FREQ=MONTHLY;BYMONTHDAY=32", "FREQ=DAILY;UNTIL=2020", "FREQ=DAILY;BYDAY=XX", "FREQ" }) {
+    std::error_code ec;
+    const dtz::recurrence recurrence{ zone, dtstart, rule, ec };
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_format)) << rule;
+    EXPECT_THROW((dtz::recurrence{ zone, dtstart, rule }), std::system_error) << rule;
+  }
+}
+
+TEST(dtz, recurrence_queue)
+{
+  const auto zone = dtz::locate_zone("UTC");
+  const auto begin = dtz::sys_days{ 2020_y / 1 / 1 };
+  dtz::recurrence_queue queue;
+  const auto hourly = queue.push({ zone, dtz::local_days{ 2019_y / 1 / 1 } + 6h, "FREQ=DAILY;BYHOUR=6,18" }, begin);
+  const auto monthly = queue.push({ zone, dtz::local_days{ 2019_y / 1 / 1 } + 12h, "FREQ=MONTHLY" }, begin);
+  EXPECT_EQ(queue.top(), begin + 6h);
+
+  std::vector<dtz::recurrence_queue::occurrence> due;
+  queue.pop(begin + dtz::days{ 1 } + 12h, std::back_inserter(due));
+  ASSERT_EQ(due.size(), 4u);
+  EXPECT_EQ(due[0].id, hourly);
+  EXPECT_EQ(due[0].time, begin + 6h);
+  EXPECT_EQ(due[1].id, monthly);
+  EXPECT_EQ(due[1].time, begin + 12h);
+  EXPECT_EQ(due[2].time, begin + 18h);
+  EXPECT_EQ(due[3].time, begin + dtz::days{ 1 } + 6h);
+  EXPECT_EQ(queue.top(), begin + dtz::days{ 1 } + 18h);
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+#include <dtz/timer_wheel.hpp>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, timer_wheel)
+{
+  using wheel = dtz::timer_wheel<dtz::steady_clock, int>;
+  const auto start = dtz::steady_clock::time_point{ 1h };
+  wheel timers{ start };
+  EXPECT_TRUE(timers.empty());
+  EXPECT_EQ(timers.now(), start);
+
+  const auto a = timers.insert(start + 5ms, 1);
+  const auto b = timers.insert(start + 70ms, 2);
+  const auto c = timers.insert(start + 5000ms, 3);
+  const auto d = timers.insert(start + 1500us, 4);
+  EXPECT_EQ(timers.size(), 4u);
+  EXPECT_TRUE(timers.contains(a));
+  EXPECT_EQ(timers[c], 3);
+
+  std::vector<int> fired;
+  const auto record = [&](wheel::timer_id, int& value) {
+    fired.push_back(value);
+  };
+
+  // Deadlines are rounded up to the resolution.
+  EXPECT_EQ(timers.advance(start + 1ms, record), 0u);
+  EXPECT_EQ(timers.advance(start + 2ms, record), 1u);
+  EXPECT_EQ(fired, (std::vector<int>{ 4 }));
+  EXPECT_FALSE(timers.contains(d));
+
+  EXPECT_TRUE(timers.cancel(b));
+  EXPECT_FALSE(timers.cancel(b));
+  EXPECT_EQ(timers.advance(start + 1s, record), 1u);
+  EXPECT_EQ(fired, (std::vector<int>{ 4, 1 }));
+  EXPECT_FALSE(timers.contains(a));
+  EXPECT_FALSE(timers.cancel(a));
+  EXPECT_EQ(timers.size(), 1u);
+
+  // Freed nodes are reused with a new generation.
+  const auto e = timers.insert(start, 5);
+  EXPECT_FALSE(timers.contains(a));
+  EXPECT_FALSE(timers.contains(b));
+  EXPECT_TRUE(timers.contains(e));
+  EXPECT_EQ(timers.advance(start + 1s, record), 1u);
+  EXPECT_EQ(fired, (std::vector<int>{ 4, 1, 5 }));
+
+  EXPECT_TRUE(timers.reschedule(c, start + 10s));
+  EXPECT_EQ(timers.advance(start + 9s, record), 0u);
+  EXPECT_EQ(timers.advance(start + 10s, record), 1u);
+  EXPECT_EQ(fired, (std::vector<int>{ 4, 1, 5, 3 }));
+  EXPECT_TRUE(timers.empty());
+  EXPECT_EQ(timers.now(), start + 10s);
+}
+
+TEST(dtz, timer_wheel_callbacks)
+{
+  using wheel = dtz::timer_wheel<dtz::steady_clock, int>;
+  const auto start = dtz::steady_clock::time_point{};
+  wheel timers{ start };
+  const auto a = timers.insert(start + 10ms, 1);
+  const auto b = timers.insert(start + 10ms, 2);
+  const auto p = timers.insert(start + 100ms, 3);
+
+  // A callback can cancel a timer of the same batch, insert timers and re-arm itself.
+  std::vector<int> fired;
+  int periods = 0;
+  const auto callback = [&](wheel::timer_id id, int& value) {
+    fired.push_back(value);
+    if (id == a) {
+      EXPECT_TRUE(timers.cancel(b));
+    } else if (id == b) {
+      EXPECT_TRUE(timers.cancel(a));
+    }
+    if (id == p && ++periods < 3) {
+      timers.insert(start, 0);
+      EXPECT_TRUE(timers.reschedule(id, timers.now() + 100ms));
+    }
+  };
+  EXPECT_EQ(timers.advance(start + 10ms, callback), 1u);
+  EXPECT_EQ(fired.size(), 1u);
+  EXPECT_FALSE(timers.contains(a));
+  EXPECT_FALSE(timers.contains(b));
+
+  EXPECT_EQ(timers.advance(start + 100ms, callback), 1u);
+  EXPECT_EQ(timers.size(), 2u);
+  EXPECT_EQ(timers.advance(start + 200ms, callback), 2u);
+  EXPECT_EQ(timers.advance(start + 300ms, callback), 2u);
+  EXPECT_EQ(timers.advance(start + 400ms, callback), 0u);
+  EXPECT_EQ(fired.size(), 6u);
+  EXPECT_TRUE(timers.empty());
+}
+
+TEST(dtz, timer_wheel_random)
+{
+  // Compares the wheel with a multimap for deadlines across all levels and random steps.
+  using wheel = dtz::timer_wheel<dtz::steady_clock, std::size_t, dtz::microseconds>;
+  const auto start = dtz::steady_clock::time_point{ 1000h };
+  std::mt19937_64 random{ 42 };
+  wheel timers{ start };
+  std::multimap<dtz::steady_clock::time_point, std::size_t> expected;
+  std::vector<wheel::timer_id> ids;
+  std::vector<bool> done;
+
+  auto now = start;
+  for (int round = 0; round < 200; round++) {
+    for (int i = 0; i < 50; i++) {
+      const auto range = std::int64_t{ 1 } << std::uniform_int_distribution<int>{ 0, 40 }(random);
+      const auto deadline = now + dtz::microseconds{ std::uniform_int_distribution<std::int64_t>{ 0, range }(random) };
+      ids.push_back(timers.insert(deadline, ids.size()));
+      expected.emplace(deadline, done.size());
+      done.push_back(false);
+    }
+    if (round % 3 == 0) {
+      const auto i = std::uniform_int_distribution<std::size_t>{ 0, ids.size() - 1 }(random);
+      EXPECT_EQ(timers.cancel(ids[i]), !done[i]);
+      if (!done[i]) {
+        std::erase_if(expected, [&](const auto& e) { return e.second == i; });
+        done[i] = true;
+      }
+    }
+    now += dtz::microseconds{ std::int64_t{ 1 } << std::uniform_int_distribution<int>{ 0, 38 }(random) };
+    std::vector<std::size_t> fired;
+    timers.advance(now, [&](wheel::timer_id id, std::size_t value) {
+      EXPECT_EQ(id, ids[value]);
+      fired.push_back(value);
+      done[value] = true;
+    });
+    std::vector<std::size_t> due;
+    for (auto it = expected.begin(); it != expected.end() && it->first <= now; it = expected.erase(it)) {
+      due.push_back(it->second);
+    }
+    std::sort(fired.begin(), fired.end());
+    std::sort(due.begin(), due.end());
+    ASSERT_EQ(fired, due);
+    ASSERT_EQ(timers.size(), expected.size());
+  }
+}
+
+TEST(dtz, zoned_timer_wheel)
+{
+  using wheel = dtz::zoned_timer_wheel<int>;
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  wheel timers{ dtz::sys_days{ 2021_y / 3 / 26 } };
+
+  // Every day at 09:00 and 02:30 local time across the spring transition on 2021-03-28.
+  const auto morning = timers.insert(zone, dtz::local_days{ 2021_y / 3 / 27 } + 9h, dtz::choose::earliest, 1, 24h);
+  const auto night = timers.insert(zone, dtz::local_days{ 2021_y / 3 / 27 } + 2h + 30min, dtz::choose::earliest, 2, 24h);
+  EXPECT_EQ(timers.deadline(morning), dtz::local_days{ 2021_y / 3 / 27 } + 9h);
+
+  std::vector<std::pair<int, dtz::sys_time<dtz::milliseconds>>> fired;
+  const auto record = [&](wheel::timer_id, int value) {
+    fired.emplace_back(value, timers.now());
+  };
+  for (dtz::sys_time<dtz::minutes> tp = dtz::sys_days{ 2021_y / 3 / 27 }; tp < dtz::sys_days{ 2021_y / 3 / 30 }; tp += 30min) {
+    timers.advance(tp, record);
+  }
+  const auto at = [](dtz::year_month_day ymd, dtz::minutes m) {
+    return dtz::sys_time<dtz::milliseconds>{ dtz::sys_days{ ymd } + m };
+  };
+  EXPECT_EQ(fired, (std::vector<std::pair<int, dtz::sys_time<dtz::milliseconds>>>{
+    { 2, at(2021_y / 3 / 27, 1h + 30min) },
+    { 1, at(2021_y / 3 / 27, 8h) },
+    { 2, at(2021_y / 3 / 28, 1h) },
+    { 1, at(2021_y / 3 / 28, 7h) },
+    { 2, at(2021_y / 3 / 29, 30min) },
+    { 1, at(2021_y / 3 / 29, 7h) },
+  }));
+  EXPECT_EQ(timers.deadline(night), dtz::local_days{ 2021_y / 3 / 30 } + 2h + 30min);
+  EXPECT_TRUE(timers.cancel(night));
+  EXPECT_EQ(timers.size(), 1u);
+
+  // A local time that occurs twice fires at the chosen instant.
+  wheel autumn{ dtz::sys_days{ 2021_y / 10 / 30 } };
+  autumn.insert(zone, dtz::local_days{ 2021_y / 10 / 31 } + 2h + 30min, dtz::choose::earliest, 1);
+  autumn.insert(zone, dtz::local_days{ 2021_y / 10 / 31 } + 2h + 30min, dtz::choose::latest, 2);
+  fired.clear();
+  for (dtz::sys_time<dtz::minutes> tp = dtz::sys_days{ 2021_y / 10 / 31 }; tp < dtz::sys_days{ 2021_y / 11 / 1 }; tp += 30min) {
+    autumn.advance(tp, [&](wheel::timer_id, int value) {
+      fired.emplace_back(value, autumn.now());
+    });
+  }
+  EXPECT_EQ(fired, (std::vector<std::pair<int, dtz::sys_time<dtz::milliseconds>>>{
+    { 1, at(2021_y / 10 / 31, 30min) },
+    { 2, at(2021_y / 10 / 31, 1h + 30min) },
+  }));
+  EXPECT_TRUE(autumn.empty());
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <dtz/timestamp_column.hpp>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace dtz::literals;
+
+TEST(dtz, timestamp_column)
+{
+  dtz::timestamp_column<dtz::nanoseconds> column;
+  EXPECT_TRUE(column.empty());
+  EXPECT_EQ(column.begin(), column.end());
+  EXPECT_EQ(column.lower_bound(dtz::sys_days{ 2021_y / 1 / 1 }), column.end());
+
+  // A regular series takes about one bit per value.
+  const auto start = dtz::sys_time<dtz::nanoseconds>{ dtz::sys_days{ 2021_y / 1 / 1 } };
+  std::vector<dtz::sys_time<dtz::nanoseconds>> values;
+  for (int i = 0; i < 100'000; i++) {
+    values.push_back(start + dtz::seconds{ i });
+    column.push_back(values.back());
+  }
+  EXPECT_EQ(column.size(), values.size());
+  EXPECT_EQ(column.blocks(), 98u);
+  EXPECT_LT(column.memory() * 8, values.size() * 2);
+  EXPECT_TRUE(std::equal(column.begin(), column.end(), values.begin(), values.end()));
+  EXPECT_EQ(column[0], values[0]);
+  EXPECT_EQ(column[1024], values[1024]);
+  EXPECT_EQ(column[99'999], values[99'999]);
+
+  const auto block = column.block(1);
+  EXPECT_EQ(block.first, 1024u);
+  EXPECT_EQ(block.size, 1024u);
+  EXPECT_EQ(block.min, values[1024]);
+  EXPECT_EQ(block.max, values[2047]);
+  EXPECT_EQ(column.block(97).size, 100'000u - 97 * 1024);
+
+  EXPECT_EQ(column.lower_bound(start).index(), 0u);
+  EXPECT_EQ(column.lower_bound(start + 2047s).index(), 2047u);
+  EXPECT_EQ(column.lower_bound(start + 2047s + 1ns).index(), 2048u);
+  EXPECT_EQ(column.upper_bound(start + 2047s).index(), 2048u);
+  EXPECT_EQ(column.lower_bound(start + 1h).index(), 3600u);
+  EXPECT_EQ(column.lower_bound(start - 1s), column.begin());
+  EXPECT_EQ(column.upper_bound(start + 99'999s), column.end());
+}
+
+TEST(dtz, timestamp_column_random)
+{
+  // Irregular values with every encoding round-trip exactly, including out of order values.
+  std::mt19937_64 random{ 42 };
+  dtz::timestamp_column<dtz::microseconds> column;
+  std::vector<dtz::sys_time<dtz::microseconds>> values;
+  auto tp = dtz::sys_time<dtz::microseconds>{ dtz::sys_days{ 2021_y / 1 / 1 } };
+  for (int i = 0; i < 10'000; i++) {
+    const auto jitter = std::int64_t{ 1 } << std::uniform_int_distribution<int>{ 0, 40 }(random);
+    tp += dtz::microseconds{ std::uniform_int_distribution<std::int64_t>{ -jitter / 4, jitter }(random) };
+    values.push_back(i == 5000 ? dtz::sys_time<dtz::microseconds>::min() : tp);
+    column.push_back(values.back());
+  }
+  EXPECT_TRUE(std::equal(column.begin(), column.end(), values.begin(), values.end()));
+  for (const auto i : { 0, 1, 1023, 1024, 5000, 9999 }) {
+    EXPECT_EQ(column[static_cast<std::size_t>(i)], values[static_cast<std::size_t>(i)]);
+  }
+
+  // Scans visit values in range with pruned blocks.
+  const auto begin = values[3000];
+  const auto end = values[3000] + 1h;
+  std::vector<std::size_t> expected;
+  for (std::size_t i = 0; i < values.size(); i++) {
+    if (values[i] >= begin && values[i] < end) {
+      expected.push_back(i);
+    }
+  }
+  std::vector<std::size_t> visited;
+  column.scan(begin, end, [&](std::size_t i, dtz::sys_time<dtz::microseconds> value) {
+    EXPECT_EQ(value, values[i]);
+    visited.push_back(i);
+  });
+  EXPECT_EQ(visited, expected);
+
+  column.clear();
+  EXPECT_TRUE(column.empty());
+  EXPECT_EQ(column.memory(), 0u);
+}
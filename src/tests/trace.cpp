@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <dtz/trace.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dtz::literals;
+
+static_assert(dtz::Clock<dtz::tsc_clock>);
+
+TEST(dtz, stopwatch)
+{
+  dtz::stopwatch stopwatch;
+  std::this_thread::sleep_for(2ms);
+  const auto elapsed = stopwatch.elapsed();
+  EXPECT_GE(elapsed, 2ms);
+  const auto lap = stopwatch.lap();
+  EXPECT_GE(lap, elapsed);
+  EXPECT_LT(stopwatch.elapsed(), lap + 1s);
+
+  dtz::stopwatch<dtz::tsc_clock> tsc;
+  std::this_thread::sleep_for(2ms);
+  EXPECT_GE(tsc.elapsed(), 1ms);
+  EXPECT_LT(tsc.elapsed(), 10s);
+}
+
+TEST(dtz, trace_recorder)
+{
+  dtz::trace_recorder recorder{ 4 };
+  const auto parse = recorder.name("parse");
+  const auto quoted = recorder.name("say \"hi\"");
+  EXPECT_EQ(recorder.name("parse"), parse);
+  EXPECT_TRUE(recorder.events().empty());
+
+  const auto origin = recorder.origin();
+  recorder.record(parse, origin + 1500ns, 1250us);
+  recorder.record(quoted, origin + 2ms, 10ns);
+  const auto events = recorder.events();
+  ASSERT_EQ(events.size(), 2u);
+  EXPECT_EQ(events[0].id, parse);
+  EXPECT_EQ(events[0].start, origin + 1500ns);
+  EXPECT_EQ(events[0].duration, 1250us);
+  EXPECT_EQ(events[1].thread, events[0].thread);
+
+  const auto trace = recorder.chrome_trace();
+  const auto thread = std::to_string(events[0].thread);
+  EXPECT_EQ(trace.substr(trace.find(R"("traceEvents")")),
+    R"("traceEvents":[)"
+    R"({"name":"parse","ph":"X","pid":1,"tid":)" + thread + R"(,"ts":1.500,"dur":1250.000,"args":{"duration":"00:00:00.001250000"}},)"
+    R"({"name":"say \"hi\"","ph":"X","pid":1,"tid":)" + thread + R"(,"ts":2000.000,"dur":0.010,"args":{"duration":"00:00:00.000000010"}}]})");
+  EXPECT_EQ(trace.find(R"({"displayTimeUnit":"ns","otherData":{"origin":")"), 0u);
+
+  // Full rings keep the latest events.
+  for (int i = 0; i < 10; i++) {
+    const auto scope = recorder.trace(static_cast<std::uint32_t>(i));
+  }
+  const auto latest = recorder.events();
+  ASSERT_EQ(latest.size(), 4u);
+  EXPECT_EQ(latest[0].id, 6u);
+  EXPECT_EQ(latest[3].id, 9u);
+  EXPECT_GE(latest[3].start, latest[0].start);
+}
+
+TEST(dtz, trace_recorder_threads)
+{
+  dtz::trace_recorder<dtz::tsc_clock> recorder{ 1024 };
+  const auto id = recorder.name("work");
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&] {
+      recorder.reserve();
+      for (int i = 0; i < 100; i++) {
+        const auto scope = recorder.trace(id);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto events = recorder.events();
+  EXPECT_EQ(events.size() + recorder.dropped(), 400u);
+  for (const auto& e : events) {
+    EXPECT_EQ(e.id, id);
+    EXPECT_GE(e.duration, 0ns);
+  }
+}
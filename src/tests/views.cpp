@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <dtz/views.hpp>
+#include <ranges>
+#include <vector>
+
+using namespace dtz::literals;
+
+namespace {
+
+template <typename View>
+std::vector<dtz::sys_time<dtz::seconds>> collect(View&& view)
+{
+  std::vector<dtz::sys_time<dtz::seconds>> result;
+  for (const auto tp : view) {
+    result.push_back(tp);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(dtz, views_days)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto begin = dtz::sys_days{ 2018_y / 3 / 23 } + 12h;
+  const auto end = dtz::sys_days{ 2018_y / 3 / 27 };
+
+  static_assert(std::ranges::forward_range<decltype(dtz::views::days(zone, begin, end))>);
+  static_assert(std::ranges::view<decltype(dtz::views::days(zone, begin, end))>);
+
+  EXPECT_EQ(collect(dtz::views::days(zone, begin, end)), (std::vector<dtz::sys_time<dtz::seconds>>{
+    dtz::sys_days{ 2018_y / 3 / 23 } + 23h,
+    dtz::sys_days{ 2018_y / 3 / 24 } + 23h,
+    dtz::sys_days{ 2018_y / 3 / 25 } + 22h,
+    dtz::sys_days{ 2018_y / 3 / 26 } + 22h,
+  }));
+
+  // Local 02:30 does not exist on 2018-03-25 and resolves to the transition.
+  EXPECT_EQ(collect(dtz::views::days(zone, begin, end, 2h + 30min)), (std::vector<dtz::sys_time<dtz::seconds>>{
+    dtz::sys_days{ 2018_y / 3 / 24 } + 1h + 30min,
+    dtz::sys_days{ 2018_y / 3 / 25 } + 1h,
+    dtz::sys_days{ 2018_y / 3 / 26 } + 0h + 30min,
+  }));
+
+  // Local 02:30 occurs twice on 2018-10-28 and resolves to the earliest.
+  EXPECT_EQ(collect(dtz::views::days(zone, dtz::sys_days{ 2018_y / 10 / 27 }, dtz::sys_days{ 2018_y / 10 / 30 }, 2h + 30min)),
+    (std::vector<dtz::sys_time<dtz::seconds>>{
+      dtz::sys_days{ 2018_y / 10 / 27 } + 0h + 30min,
+      dtz::sys_days{ 2018_y / 10 / 28 } + 0h + 30min,
+      dtz::sys_days{ 2018_y / 10 / 29 } + 1h + 30min,
+    }));
+
+  const auto big = collect(dtz::views::days(zone, dtz::sys_days{ 2000_y / 1 / 1 }, dtz::sys_days{ 2030_y / 1 / 1 }));
+  ASSERT_EQ(big.size(), static_cast<std::size_t>((dtz::sys_days{ 2030_y / 1 / 1 } - dtz::sys_days{ 2000_y / 1 / 1 }).count()));
+  for (const auto tp : big) {
+    const auto lt = zone->to_local(tp);
+    ASSERT_EQ(lt, dtz::floor<dtz::days>(lt));
+  }
+}
+
+TEST(dtz, views_calendar)
+{
+  const auto zone = dtz::locate_zone("America/New_York");
+  const auto begin = dtz::sys_days{ 2020_y / 1 / 1 };
+  const auto end = dtz::sys_days{ 2021_y / 1 / 1 };
+
+  const auto mondays = collect(dtz::views::weeks(zone, dtz::mon, begin, end));
+  ASSERT_EQ(mondays.size(), 52u);
+  EXPECT_EQ(mondays.front(), dtz::sys_days{ 2020_y / 1 / 6 } + 5h);
+
+  const auto months = collect(dtz::views::months(zone, begin, end));
+  ASSERT_EQ(months.size(), 12u);
+  EXPECT_EQ(months[0], dtz::sys_days{ 2020_y / 1 / 1 } + 5h);
+  EXPECT_EQ(months[6], dtz::sys_days{ 2020_y / 7 / 1 } + 4h);
+
+  const auto quarters = collect(dtz::views::quarters(zone, dtz::sys_days{ 2020_y / 2 / 1 }, end));
+  EXPECT_EQ(quarters, (std::vector<dtz::sys_time<dtz::seconds>>{
+    dtz::sys_days{ 2020_y / 4 / 1 } + 4h,
+    dtz::sys_days{ 2020_y / 7 / 1 } + 4h,
+    dtz::sys_days{ 2020_y / 10 / 1 } + 4h,
+  }));
+
+  const auto years = collect(dtz::views::years(zone, dtz::sys_days{ 2018_y / 6 / 1 }, end));
+  EXPECT_EQ(years, (std::vector<dtz::sys_time<dtz::seconds>>{
+    dtz::sys_days{ 2019_y / 1 / 1 } + 5h,
+    dtz::sys_days{ 2020_y / 1 / 1 } + 5h,
+  }));
+
+  const auto month_last = collect(dtz::views::month_last(zone, begin, end));
+  ASSERT_EQ(month_last.size(), 12u);
+  EXPECT_EQ(month_last[1], dtz::sys_days{ 2020_y / 2 / 29 } + 5h);
+
+  const auto fri_last = collect(dtz::views::weekday_last(zone, dtz::fri[dtz::last], begin, end, 17h));
+  ASSERT_EQ(fri_last.size(), 12u);
+  EXPECT_EQ(fri_last[0], dtz::sys_days{ 2020_y / 1 / 31 } + 22h);
+  EXPECT_EQ(fri_last[4], dtz::sys_days{ 2020_y / 5 / 29 } + 21h);
+
+  // Only January, May, July and October 2020 have a fifth Friday.
+  const auto fri_5 = collect(dtz::views::weekday_indexed(zone, dtz::fri[5], begin, end));
+  EXPECT_EQ(fri_5, (std::vector<dtz::sys_time<dtz::seconds>>{
+    dtz::sys_days{ 2020_y / 1 / 31 } + 5h,
+    dtz::sys_days{ 2020_y / 5 / 29 } + 4h,
+    dtz::sys_days{ 2020_y / 7 / 31 } + 4h,
+    dtz::sys_days{ 2020_y / 10 / 30 } + 4h,
+  }));
+
+  // Indices that no month has give empty views instead of searching forever.
+  EXPECT_TRUE(collect(dtz::views::weekday_indexed(zone, dtz::fri[0], begin, end)).empty());
+  EXPECT_TRUE(collect(dtz::views::weekday_indexed(zone, dtz::fri[6], begin, end)).empty());
+  EXPECT_TRUE(collect(dtz::views::weekday_indexed(zone, dtz::weekday{ 9 }[1], begin, end)).empty());
+  EXPECT_TRUE(collect(dtz::views::weekday_last(zone, dtz::weekday{ 9 }[dtz::last], begin, end)).empty());
+  EXPECT_TRUE(collect(dtz::views::weekday_indexed(zone, dtz::fri[5], end, begin)).empty());
+}
+
+TEST(dtz, views_compose)
+{
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  auto view = dtz::views::days(zone, dtz::sys_days{ 2020_y / 1 / 1 }, dtz::sys_days{ 2021_y / 1 / 1 }) |
+    std::views::filter([zone](auto tp) { return dtz::weekday{ dtz::floor<dtz::days>(zone->to_local(tp)) } == dtz::sat; }) |
+    std::views::take(3);
+  EXPECT_EQ(collect(view), (std::vector<dtz::sys_time<dtz::seconds>>{
+    dtz::sys_days{ 2020_y / 1 / 3 } + 23h,
+    dtz::sys_days{ 2020_y / 1 / 10 } + 23h,
+    dtz::sys_days{ 2020_y / 1 / 17 } + 23h,
+  }));
+}
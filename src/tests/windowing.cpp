@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <dtz/windowing.hpp>
+#include <utility>
+#include <vector>
+
+using namespace dtz::literals;
+
+namespace {
+
+using time_point = dtz::sys_time<dtz::seconds>;
+using window = dtz::interval<time_point>;
+
+struct count
+{
+  int value = 0;
+
+  count& operator+=(count&& other) noexcept
+  {
+    value += other.value;
+    return *this;
+  }
+};
+
+// Accumulators without operator+= cannot merge sessions.
+struct last_value
+{
+  int value = 0;
+};
+
+template <typename Accumulator>
+concept session_windowing = requires { dtz::windowing<Accumulator, dtz::seconds>::session(dtz::seconds{ 1 }); };
+
+template <typename Windowing>
+std::vector<std::pair<window, int>> poll(Windowing& windowing)
+{
+  std::vector<std::pair<window, int>> result;
+  windowing.poll([&](const window& w, count&& c) {
+    result.emplace_back(w, c.value);
+  });
+  return result;
+}
+
+const auto start = time_point{ dtz::sys_days{ 2021_y / 3 / 27 } };
+
+}  // namespace
+
+TEST(dtz, windowing_fixed)
+{
+  auto tumbling = dtz::windowing<count, dtz::seconds>::tumbling(1h, 15min);
+  const auto add = [](auto& w, time_point tp) {
+    return w.add(tp, [](count& c) { c.value++; });
+  };
+  EXPECT_TRUE(add(tumbling, start + 10min));
+  EXPECT_TRUE(add(tumbling, start + 70min));
+  EXPECT_TRUE(add(tumbling, start + 50min));
+  EXPECT_EQ(tumbling.size(), 2u);
+  EXPECT_EQ(tumbling.watermark(), start + 55min);
+  EXPECT_TRUE(poll(tumbling).empty());
+  tumbling.advance(start + 1h);
+  EXPECT_EQ(poll(tumbling), (std::vector<std::pair<window, int>>{ { { start, start + 1h }, 2 } }));
+
+  // Events for closed windows are late.
+  EXPECT_FALSE(add(tumbling, start + 59min));
+  EXPECT_EQ(tumbling.late(), 1u);
+  tumbling.advance(start + 3h);
+  EXPECT_EQ(poll(tumbling), (std::vector<std::pair<window, int>>{ { { start + 1h, start + 2h }, 1 } }));
+
+  // Every event belongs to size / slide windows.
+  auto sliding = dtz::windowing<count, dtz::seconds>::sliding(1h, 15min);
+  for (auto tp = start; tp < start + 2h; tp += 5min) {
+    add(sliding, tp);
+  }
+  sliding.advance(start + 2h);
+  const auto windows = poll(sliding);
+  ASSERT_EQ(windows.size(), 8u);
+  EXPECT_EQ(windows.front(), (std::pair<window, int>{ { start - 45min, start + 15min }, 3 }));
+  EXPECT_EQ(windows.back(), (std::pair<window, int>{ { start + 60min, start + 120min }, 12 }));
+  EXPECT_EQ(sliding.size(), 3u);
+
+  // Events between hopping windows are skipped, not late.
+  auto hopping = dtz::windowing<count, dtz::seconds>::sliding(10min, 1h);
+  EXPECT_TRUE(add(hopping, start + 5min));
+  EXPECT_FALSE(add(hopping, start + 30min));
+  EXPECT_TRUE(add(hopping, start + 1h));
+  EXPECT_EQ(hopping.skipped(), 1u);
+  EXPECT_EQ(hopping.late(), 0u);
+  hopping.advance(start + 2h);
+  EXPECT_EQ(poll(hopping), (std::vector<std::pair<window, int>>{
+    { { start, start + 10min }, 1 },
+    { { start + 1h, start + 70min }, 1 },
+  }));
+}
+
+TEST(dtz, windowing_calendar)
+{
+  // Local days in Berlin across the spring transition on 2021-03-28.
+  const auto zone = dtz::locate_zone("Europe/Berlin");
+  const auto midnight = [&](dtz::year_month_day ymd) {
+    return zone->to_sys(dtz::local_days{ ymd });
+  };
+  const auto base = midnight(2021_y / 3 / 27);
+  auto daily = dtz::windowing<count, dtz::seconds>::tumbling(zone, dtz::bucket_unit::day);
+  for (auto tp = base; tp < base + dtz::days{ 3 }; tp += 30min) {
+    daily.add(tp, [](count& c) { c.value++; });
+  }
+  std::vector<std::pair<window, int>> windows;
+  daily.flush([&](const window& w, count&& c) {
+    windows.emplace_back(w, c.value);
+  });
+  EXPECT_EQ(windows, (std::vector<std::pair<window, int>>{
+    { { midnight(2021_y / 3 / 27), midnight(2021_y / 3 / 28) }, 48 },
+    { { midnight(2021_y / 3 / 28), midnight(2021_y / 3 / 29) }, 46 },
+    { { midnight(2021_y / 3 / 29), midnight(2021_y / 3 / 30) }, 48 },
+    { { midnight(2021_y / 3 / 30), midnight(2021_y / 3 / 31) }, 2 },
+  }));
+
+  // Two-day windows starting every day.
+  auto sliding = dtz::windowing<count, dtz::seconds>::sliding(zone, dtz::bucket_unit::day, 2);
+  sliding.add(base + 12h, [](count& c) { c.value++; });
+  sliding.add(base + 36h, [](count& c) { c.value++; });
+  sliding.advance(midnight(2021_y / 3 / 29));
+  EXPECT_EQ(poll(sliding), (std::vector<std::pair<window, int>>{
+    { { midnight(2021_y / 3 / 26), midnight(2021_y / 3 / 28) }, 1 },
+    { { midnight(2021_y / 3 / 27), midnight(2021_y / 3 / 29) }, 2 },
+  }));
+  EXPECT_EQ(sliding.size(), 1u);
+}
+
+TEST(dtz, windowing_session)
+{
+  static_assert(session_windowing<count>);
+  static_assert(!session_windowing<last_value>);
+  auto last = dtz::windowing<last_value, dtz::seconds>::tumbling(10min);
+  last.add(start, [](last_value& v) { v.value = 1; });
+  EXPECT_EQ(last.size(), 1u);
+
+  auto sessions = dtz::windowing<count, dtz::seconds>::session(10min, 1h);
+  const auto add = [&](time_point tp) {
+    return sessions.add(tp, [](count& c) { c.value++; });
+  };
+  add(start);
+  add(start + 5min);
+  add(start + 30min);
+  add(start + 50min);
+  EXPECT_EQ(sessions.size(), 3u);
+
+  // An out of order event bridges two sessions.
+  add(start + 40min);
+  EXPECT_EQ(sessions.size(), 2u);
+  add(start + 3h);
+  EXPECT_EQ(poll(sessions), (std::vector<std::pair<window, int>>{
+    { { start, start + 15min }, 2 },
+    { { start + 30min, start + 60min }, 3 },
+  }));
+  EXPECT_FALSE(add(start + 1h));
+  EXPECT_TRUE(add(start + 2h + 1s));
+}
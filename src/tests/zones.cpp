@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <dtz.hpp>
+#include <string>
+
+using namespace dtz::literals;
+
+TEST(dtz, fixed_zone)
+{
+  constexpr auto ist = [] {
+    dtz::fixed_zone zone;
+    (void)dtz::parse_fixed_zone("+05:30", zone);
+    return zone;
+  }();
+  static_assert(ist.offset() == 5h + 30min);
+  static_assert(ist.to_local(dtz::sys_days{ 2021_y / 1 / 1 }) == dtz::local_days{ 2021_y / 1 / 1 } + 5h + 30min);
+
+  const std::pair<const char*, dtz::seconds> offsets[] = { { "Z", 0s }, { "UTC", 0s }, { "-08:00", -8h }, { "+0545", 5h + 45min }, { "+05", 5h },
+    { "UTC+01:00", 1h }, { "-00:44:30", -44min - 30s } };
+  for (const auto& [str, offset] : offsets) {
+    std::error_code ec;
+    EXPECT_EQ(dtz::make_fixed_zone(str, ec).offset(), offset) << str;
+    EXPECT_FALSE(ec) << str;
+  }
+  for (const auto str : { "", "+", "05:30", "+25:00", "+05:60", "+053", "+05:30:00:00", "UTC+" }) {
+    std::error_code ec;
+    (void)dtz::make_fixed_zone(str, ec);
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_time_zone_format)) << str;
+  }
+  EXPECT_THROW((void)dtz::make_fixed_zone("+5:3"), std::system_error);
+  EXPECT_EQ(dtz::fixed_zone{ -3h - 30min }.name(), "-03:30");
+  EXPECT_EQ(dtz::fixed_zone{}.name(), "+00:00");
+
+  // Zoned times convert, cast and format like tz database zones.
+  const auto tp = dtz::sys_days{ 2021_y / 3 / 28 } + 23h + 45min + 1s + 5ms;
+  const auto zt = dtz::make_zoned(ist, tp);
+  static_assert(dtz::ZonedTime<std::remove_const_t<decltype(zt)>>);
+  EXPECT_EQ(zt.get_local_time(), dtz::local_days{ 2021_y / 3 / 29 } + 5h + 15min + 1s + 5ms);
+  EXPECT_EQ(dtz::format(zt), "2021-03-29 05:15:01.005");
+  EXPECT_EQ(dtz::cast<dtz::seconds>(zt).get_time_zone(), ist);
+  EXPECT_EQ(dtz::cast<dtz::local_t>(dtz::cast<dtz::seconds>(zt)), dtz::local_days{ 2021_y / 3 / 29 } + 5h + 15min + 1s);
+  EXPECT_EQ(dtz::make_zoned(ist, zt.get_local_time()).get_sys_time(), tp);
+  EXPECT_EQ(zt.get_info().abbrev, "+05:30");
+  const auto named = dtz::zoned_time<dtz::seconds, dtz::fixed_zone>{ "-02:00", dtz::floor<dtz::seconds>(tp) };
+  EXPECT_EQ(dtz::format(named), "2021-03-28 21:45:01");
+}
+
+TEST(dtz, posix_zone)
+{
+  // The zones agree with the tz database for current years.
+  for (const auto& [name, tz] : { std::pair{ "America/New_York", "EST5EDT,M3.2.0,M11.1.0" }, std::pair{ "Europe/Berlin", "CET-1CEST,M3.5.0,M10.5.0/3" } }) {
+    const auto zone = dtz::locate_zone(name);
+    const auto posix = dtz::make_posix_zone(tz);
+    EXPECT_EQ(posix.name(), tz);
+    for (auto tp = dtz::sys_time<dtz::seconds>{ dtz::sys_days{ 2019_y / 1 / 1 } }; tp < dtz::sys_days{ 2023_y / 1 / 1 }; tp += 1h + 7min) {
+      const auto expected = zone->get_info(tp);
+      const auto info = posix.get_info(tp);
+      ASSERT_EQ(info.offset, expected.offset) << name << ' ' << dtz::format(tp);
+      EXPECT_EQ(info.save, expected.save);
+      EXPECT_EQ(dtz::format(dtz::make_zoned(posix, tp)), dtz::format(dtz::make_zoned(zone, tp)));
+      const auto lt = dtz::floor<dtz::minutes>(zone->to_local(tp));
+      EXPECT_EQ(posix.get_info(lt).result, zone->get_info(lt).result) << name << ' ' << dtz::format(lt);
+      EXPECT_EQ(posix.to_sys(lt, dtz::choose::earliest), zone->to_sys(lt, dtz::choose::earliest));
+      EXPECT_EQ(posix.to_sys(lt, dtz::choose::latest), zone->to_sys(lt, dtz::choose::latest));
+    }
+  }
+
+  // Southern hemisphere zones have DST across the new year.
+  constexpr auto sydney = [] {
+    dtz::posix_zone zone;
+    (void)dtz::parse_posix_zone("AEST-10AEDT,M10.1.0,M4.1.0/3", zone);
+    return zone;
+  }();
+  static_assert(sydney.has_dst() && sydney.std_offset() == 10h && sydney.dst_offset() == 11h);
+  static_assert(sydney.to_local(dtz::sys_days{ 2021_y / 1 / 1 }) == dtz::local_days{ 2021_y / 1 / 1 } + 11h);
+  static_assert(sydney.to_local(dtz::sys_days{ 2021_y / 7 / 1 }) == dtz::local_days{ 2021_y / 7 / 1 } + 10h);
+  const auto info = sydney.get_info(dtz::sys_days{ 2021_y / 1 / 1 });
+  EXPECT_EQ(info.begin, dtz::sys_days{ 2020_y / 10 / 3 } + 16h);
+  EXPECT_EQ(info.end, dtz::sys_days{ 2021_y / 4 / 3 } + 16h);
+  EXPECT_EQ(info.abbrev, "AEDT");
+  EXPECT_EQ(info.save, 60min);
+
+  // Nonexistent and ambiguous local times.
+  const auto gap = dtz::local_days{ 2021_y / 10 / 3 } + 2h + 30min;
+  EXPECT_EQ(sydney.get_info(gap).result, dtz::local_info::nonexistent);
+  EXPECT_EQ(sydney.to_sys(gap, dtz::choose::latest), dtz::sys_days{ 2021_y / 10 / 2 } + 16h);
+  EXPECT_THROW((void)dtz::make_zoned(sydney, gap), dtz::nonexistent_local_time);
+  std::error_code ec;
+  (void)dtz::make_zoned(sydney, gap, ec);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::nonexistent_local_time));
+  const auto fold = dtz::local_days{ 2021_y / 4 / 4 } + 2h + 30min;
+  EXPECT_EQ(sydney.get_info(fold).result, dtz::local_info::ambiguous);
+  EXPECT_EQ(sydney.to_sys(fold, dtz::choose::earliest), dtz::sys_days{ 2021_y / 4 / 3 } + 15h + 30min);
+  EXPECT_EQ(sydney.to_sys(fold, dtz::choose::latest), dtz::sys_days{ 2021_y / 4 / 3 } + 16h + 30min);
+  EXPECT_THROW((void)dtz::make_zoned(sydney, fold), dtz::ambiguous_local_time);
+  (void)dtz::make_zoned(sydney, fold, ec);
+  EXPECT_EQ(ec, std::make_error_code(dtz::errc::ambiguous_local_time));
+
+  // Julian days, quoted abbreviations, explicit DST offsets and times.
+  const auto zone = dtz::make_posix_zone("<+0330>-3:30<+0430>-4:30,J79/24,J263/24");
+  EXPECT_EQ(zone.std_abbrev(), "+0330");
+  EXPECT_EQ(zone.name(), "<+0330>-3:30<+0430>,J79/24,J263/24");
+  EXPECT_EQ(zone.get_info(dtz::sys_days{ 2021_y / 3 / 21 }).offset, 4h + 30min);
+  EXPECT_EQ(zone.get_info(dtz::sys_days{ 2021_y / 3 / 19 }).offset, 3h + 30min);
+  EXPECT_EQ(dtz::make_posix_zone("EST5EDT").dst_start(), (dtz::posix_zone::rule{ 'M', 3, 2, 0 }));
+  EXPECT_EQ(dtz::make_posix_zone("JST-9").get_info(dtz::sys_days{ 2021_y / 1 / 1 }).abbrev, "JST");
+  EXPECT_EQ(dtz::posix_zone{}.name(), "UTC0");
+  for (const auto str : { "", "E5", "EST", "EST5EDT,M3.2.0", "EST5EDT,M13.2.0,M11.1.0", "EST5EDT,M3.2.0,M11.1.0/", "<EST5", "EST5EDT,J0,J365" }) {
+    (void)dtz::make_posix_zone(str, ec);
+    EXPECT_EQ(ec, std::make_error_code(dtz::errc::invalid_time_zone_format)) << str;
+  }
+}